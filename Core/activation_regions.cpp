@@ -0,0 +1,16 @@
+#include "activation_regions.h"
+
+namespace Core
+{
+    ActivationRegions& ActivationRegions::instance()
+    {
+        static ActivationRegions regions;
+        return regions;
+    }
+
+    void ActivationRegions::add_around(float x, float y, float z, float extent)
+    {
+        regions_.push_back({ x - extent, y - extent, z - extent, x + extent, y + extent, z + extent });
+    }
+
+} // namespace Core
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "spatial_index.h" // For AabbQuery
+#include <span>
+#include <vector>
+
+namespace Core
+{
+    // Parts of the world where dormant entities wake up: around players, cameras, active
+    // encounters. Native code replaces them whenever those move. Once per frame the
+    // ScriptAPI queries the spatial index with the regions and wakes the dormant entities
+    // it finds, so the cost follows what the regions cover, not the number of sleepers.
+    // Main thread only.
+    class DLL_API ActivationRegions
+    {
+    public:
+        static ActivationRegions& instance();
+
+        void set(std::span<const AabbQuery> regions) { regions_.assign(regions.begin(), regions.end()); }
+        // Adds a cube of half-size 'extent' centered on the point.
+        void add_around(float x, float y, float z, float extent);
+        void clear() { regions_.clear(); }
+
+        std::span<const AabbQuery> regions() const { return regions_; }
+
+    private:
+        std::vector<AabbQuery> regions_;
+    };
+
+} // namespace Core
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Core
+{
+    // Packs values LSB-first into a caller-owned buffer. Writes past the end of the buffer
+    // are dropped and set overflowed(); callers that need to stay within the buffer take a
+    // position() before a group of writes and rewind() to it on overflow.
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::span<uint8_t> buffer) : buffer_(buffer) {}
+
+        void write(uint32_t value, int bits)
+        {
+            if (bitPos_ + static_cast<size_t>(bits) > buffer_.size() * 8)
+            {
+                overflowed_ = true;
+                bitPos_ = buffer_.size() * 8;
+                return;
+            }
+            for (int written = 0; written < bits;)
+            {
+                size_t byte = bitPos_ >> 3;
+                int offset = static_cast<int>(bitPos_ & 7);
+                int count = bits - written < 8 - offset ? bits - written : 8 - offset;
+                uint32_t mask = ((1u << count) - 1) << offset;
+                // Clears the bits too, since rewind() may leave stale ones behind
+                buffer_[byte] = static_cast<uint8_t>((buffer_[byte] & ~mask) | (((value >> written) << offset) & mask));
+                written += count;
+                bitPos_ += static_cast<size_t>(count);
+            }
+        }
+
+        void write_bool(bool value) { write(value ? 1u : 0u, 1); }
+
+        // 5-bit length prefix, then the significant bits. Small values cost a few bits;
+        // values of 31 or 32 significant bits use prefix 31 and a full word (37 bits).
+        void write_varbits(uint32_t value)
+        {
+            int length = 0;
+            while (length < 32 && (value >> length) != 0) ++length;
+            if (length >= 31)
+            {
+                write(31, 5);
+                write(value, 32);
+                return;
+            }
+            write(static_cast<uint32_t>(length), 5);
+            write(value, length);
+        }
+
+        // Zigzag keeps small negative values small.
+        void write_signed(int32_t value)
+        {
+            write_varbits((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+        }
+
+        size_t position() const { return bitPos_; }
+        void rewind(size_t bitPosition) { bitPos_ = bitPosition; overflowed_ = false; }
+        bool overflowed() const { return overflowed_; }
+        size_t bytes() const { return (bitPos_ + 7) >> 3; }
+
+    private:
+        std::span<uint8_t> buffer_;
+        size_t bitPos_ = 0;
+        bool overflowed_ = false;
+    };
+
+    // Reads what BitWriter wrote. Reading past the end returns zeros and sets failed().
+    class BitReader
+    {
+    public:
+        explicit BitReader(std::span<const uint8_t> buffer) : buffer_(buffer) {}
+
+        uint32_t read(int bits)
+        {
+            if (bitPos_ + static_cast<size_t>(bits) > buffer_.size() * 8)
+            {
+                failed_ = true;
+                bitPos_ = buffer_.size() * 8;
+                return 0;
+            }
+            uint32_t value = 0;
+            for (int read = 0; read < bits;)
+            {
+                size_t byte = bitPos_ >> 3;
+                int offset = static_cast<int>(bitPos_ & 7);
+                int count = bits - read < 8 - offset ? bits - read : 8 - offset;
+                uint32_t chunk = (static_cast<uint32_t>(buffer_[byte]) >> offset) & ((1u << count) - 1);
+                value |= chunk << read;
+                read += count;
+                bitPos_ += static_cast<size_t>(count);
+            }
+            return value;
+        }
+
+        bool read_bool() { return read(1) != 0; }
+
+        uint32_t read_varbits()
+        {
+            uint32_t length = read(5);
+            return length == 31 ? read(32) : read(static_cast<int>(length));
+        }
+
+        int32_t read_signed()
+        {
+            uint32_t zigzag = read_varbits();
+            return static_cast<int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+        }
+
+        bool failed() const { return failed_; }
+        size_t bits_remaining() const { return buffer_.size() * 8 - bitPos_; }
+
+    private:
+        std::span<const uint8_t> buffer_;
+        size_t bitPos_ = 0;
+        bool failed_ = false;
+    };
+
+} // namespace Core
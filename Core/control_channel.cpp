@@ -0,0 +1,97 @@
+#include "control_channel.h"
+
+#include <iostream> // For basic error output
+
+namespace Core
+{
+    namespace
+    {
+        // How often the service thread checks for stop()
+        constexpr std::chrono::milliseconds kPollInterval{ 200 };
+        constexpr size_t kMaxCommandLength = 1024;
+    }
+
+    ControlChannel::~ControlChannel()
+    {
+        stop();
+    }
+
+    bool ControlChannel::start(const std::string& path)
+    {
+        stop();
+        stopping_ = false;
+
+        if (!server_.listen(path))
+        {
+            std::cerr << "Error: Cannot open control channel at " << path << std::endl;
+            return false;
+        }
+        thread_ = std::thread(&ControlChannel::run, this);
+        return true;
+    }
+
+    void ControlChannel::stop()
+    {
+        if (!thread_.joinable()) return;
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        answered_.notify_all();
+        thread_.join();
+        server_.close();
+    }
+
+    int ControlChannel::poll(const Handler& handler)
+    {
+        int count = 0;
+        std::unique_lock lock(mutex_);
+        while (!pending_.empty())
+        {
+            Request* request = pending_.front();
+            pending_.pop_front();
+
+            lock.unlock();
+            std::string reply = handler(request->command);
+            lock.lock();
+
+            request->reply = std::move(reply);
+            request->answered = true;
+            ++count;
+        }
+        lock.unlock();
+        if (count > 0) answered_.notify_all();
+        return count;
+    }
+
+    void ControlChannel::run()
+    {
+        std::string line;
+        while (!stopping_)
+        {
+            LocalSocket client = server_.accept(kPollInterval);
+            while (client.is_open() && !stopping_)
+            {
+                if (!client.read_line(line, kPollInterval, kMaxCommandLength)) continue; // Timeout or disconnect
+                if (line.empty()) continue;
+
+                Request request;
+                request.command = line;
+                std::unique_lock lock(mutex_);
+                pending_.push_back(&request);
+                answered_.wait(lock, [&] { return request.answered || stopping_.load(); });
+                if (!request.answered)
+                {
+                    // Shutting down; 'request' lives on this stack frame
+                    std::erase(pending_, &request);
+                    break;
+                }
+                lock.unlock();
+
+                if (!request.reply.empty() && request.reply.back() != '\n') request.reply += '\n';
+                client.write_all(request.reply);
+            }
+        }
+    }
+
+} // namespace Core
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "local_socket.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Note: uses <thread>/<mutex>, so this header is for native translation units only.
+
+namespace Core
+{
+    // Line-based command channel on a local socket, for driving a headless engine
+    // (e.g. `echo stats | nc -U engine.sock`). A background thread accepts clients and
+    // reads their commands; the engine answers them from its own thread with poll()
+    // between frames, so handlers can touch engine state without locking. Each reply is
+    // written back on the connection the command arrived on. One client is served at a
+    // time.
+    class DLL_API ControlChannel
+    {
+    public:
+        using Handler = std::function<std::string(std::string_view command)>;
+
+        ControlChannel() = default;
+        ~ControlChannel();
+
+        ControlChannel(const ControlChannel&) = delete;
+        ControlChannel& operator=(const ControlChannel&) = delete;
+
+        bool start(const std::string& path);
+        void stop();
+        bool running() const { return thread_.joinable(); }
+
+        // Answers every queued command with 'handler'. Returns the number answered.
+        int poll(const Handler& handler);
+
+    private:
+        struct Request
+        {
+            std::string command;
+            std::string reply;
+            bool answered = false;
+        };
+
+        void run();
+
+        LocalSocketServer server_;
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable answered_;
+        std::deque<Request*> pending_;
+        std::atomic<bool> stopping_{ false };
+    };
+
+} // namespace Core
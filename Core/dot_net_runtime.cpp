@@ -126,6 +126,18 @@ namespace Core
         return true; // Initialization successful
     }
 
+    bool DotNetRuntime::set_config(const std::string& name, const std::string& value)
+    {
+        // CoreCLR reads its configuration from the process environment at startup
+        std::string variable = "DOTNET_" + name;
+        if (!SetEnvironmentVariableA(variable.c_str(), value.c_str()))
+        {
+            std::cerr << "Error: Failed to set " << variable << ". Error code: " << GetLastError() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     bool DotNetRuntime::shutdown()
     {
         if (!is_initialized() || !shutdownCoreClr_)
@@ -38,6 +38,10 @@ namespace Core
         // Shuts down the CoreCLR runtime.
         bool shutdown();
 
+        // Sets a runtime configuration knob (read by CoreCLR as DOTNET_<name>), e.g.
+        // set_config("TieredPGO", "1"). Only takes effect if called before initialize().
+        static bool set_config(const std::string& name, const std::string& value);
+
         // Creates a function pointer to a static managed method.
         // assemblyName: Name of the assembly (without .dll extension).
         // typeName: Fully qualified type name (Namespace.ClassName).
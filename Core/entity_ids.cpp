@@ -0,0 +1,19 @@
+#include "entity_ids.h"
+
+namespace Core
+{
+    EntityIds& EntityIds::instance()
+    {
+        static EntityIds ids;
+        return ids;
+    }
+
+    void EntityIds::reserve(int id)
+    {
+        int next = next_.load(std::memory_order_relaxed);
+        while (next <= id && !next_.compare_exchange_weak(next, id + 1, std::memory_order_relaxed))
+        {
+        }
+    }
+
+} // namespace Core
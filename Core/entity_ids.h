@@ -0,0 +1,27 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <atomic>
+
+namespace Core
+{
+    // Hands out entity ids for entities created at runtime. Ids that come from elsewhere
+    // (loaded worlds, hardcoded scenes) are passed to reserve() so allocate() never
+    // returns them. Both calls are lock-free and safe from any thread.
+    class DLL_API EntityIds
+    {
+    public:
+        // Process-wide allocator shared by the engine loop and the ScriptAPI.
+        static EntityIds& instance();
+
+        int allocate() { return next_.fetch_add(1, std::memory_order_relaxed); }
+        // Allocates 'count' consecutive ids and returns the first.
+        int allocate(int count) { return next_.fetch_add(count, std::memory_order_relaxed); }
+        // Makes sure later allocate() calls return ids greater than 'id'.
+        void reserve(int id);
+
+    private:
+        std::atomic<int> next_{ 0 };
+    };
+
+} // namespace Core
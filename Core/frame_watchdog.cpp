@@ -0,0 +1,442 @@
+#include "frame_watchdog.h"
+#include "metrics.h"
+#include "script_call.h" // to_string(ScriptPhase)
+
+#include <algorithm> // std::clamp, std::min
+#include <chrono>
+#include <condition_variable>
+#include <cstring>    // std::memcpy
+#include <ctime>      // std::localtime
+#include <filesystem> // std::filesystem::create_directories
+#include <fstream>
+#include <iomanip>    // std::put_time
+#include <iostream>   // For basic error output
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#include <DbgHelp.h> // StackWalk64, SymFromAddr
+#pragma comment(lib, "dbghelp.lib")
+#endif
+
+namespace Core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // The stall is measured by the watchdog's own clock, so reports are accurate to
+        // one poll interval.
+        constexpr int kMinPollMs = 10;
+        constexpr int kMaxPollMs = 250;
+        constexpr int kMaxStackFrames = 128;
+        constexpr size_t kStackSnapshotBytes = 512 * 1024;
+        constexpr unsigned kManagedStackTimeoutMs = 15000;
+
+        double to_ms(Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        std::string file_timestamp()
+        {
+            std::time_t now = std::time(nullptr);
+            std::ostringstream text;
+            text << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S");
+            return text.str();
+        }
+
+        const char* phase_name(int32_t phase)
+        {
+            if (phase == ScriptActivity::kNone) return "none";
+            if (phase == ScriptActivity::kStart) return "Start";
+            return to_string(static_cast<ScriptPhase>(phase));
+        }
+
+#if defined(_WIN32)
+        // Copy of the watched thread's stack taken while it was suspended. Only the
+        // watchdog thread walks stacks, so StackWalk64's callback can read it from here.
+        struct StackSnapshotView
+        {
+            DWORD64 base = 0;
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+        StackSnapshotView g_stackView;
+
+        BOOL CALLBACK read_snapshot_memory(HANDLE process, DWORD64 address, PVOID buffer, DWORD size, LPDWORD bytesRead)
+        {
+            if (address >= g_stackView.base && address + size <= g_stackView.base + g_stackView.size)
+            {
+                std::memcpy(buffer, g_stackView.data + (address - g_stackView.base), size);
+                *bytesRead = size;
+                return TRUE;
+            }
+            SIZE_T read = 0;
+            BOOL ok = ReadProcessMemory(process, reinterpret_cast<LPCVOID>(address), buffer, size, &read);
+            *bytesRead = static_cast<DWORD>(read);
+            return ok;
+        }
+
+        void write_frame(std::ostream& out, int index, DWORD64 address)
+        {
+            HANDLE process = GetCurrentProcess();
+            out << "  #" << index << " 0x" << std::hex << address << std::dec;
+
+            IMAGEHLP_MODULE64 module{};
+            module.SizeOfStruct = sizeof(module);
+            if (!SymGetModuleInfo64(process, address, &module))
+            {
+                out << "  [no module: JIT-compiled or stub code]\n";
+                return;
+            }
+            out << "  " << module.ModuleName;
+
+            alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+            SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+            symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+            symbol->MaxNameLen = MAX_SYM_NAME;
+            DWORD64 displacement = 0;
+            if (SymFromAddr(process, address, &displacement, symbol))
+            {
+                out << "!" << symbol->Name << "+0x" << std::hex << displacement << std::dec;
+            }
+            out << "\n";
+        }
+
+        // Runs the managed stack tool with its output appended to the report.
+        void append_managed_stacks(const std::string& command, const std::string& path)
+        {
+            std::string commandLine = command + " report --process-id " + std::to_string(GetCurrentProcessId());
+            std::ofstream(path, std::ios::app) << "\nManaged stacks (" << commandLine << "):\n";
+
+            SECURITY_ATTRIBUTES inherit{ sizeof(inherit), nullptr, TRUE };
+            HANDLE file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE, &inherit,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return;
+
+            STARTUPINFOA startup{};
+            startup.cb = sizeof(startup);
+            startup.dwFlags = STARTF_USESTDHANDLES;
+            startup.hStdOutput = file;
+            startup.hStdError = file;
+            PROCESS_INFORMATION child{};
+            BOOL started = CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                                          nullptr, nullptr, &startup, &child);
+            CloseHandle(file);
+            if (!started)
+            {
+                std::ofstream(path, std::ios::app) << "  unavailable: could not run '" << command
+                                                   << "' (install with 'dotnet tool install -g dotnet-stack')\n";
+                return;
+            }
+
+            if (WaitForSingleObject(child.hProcess, kManagedStackTimeoutMs) == WAIT_TIMEOUT)
+            {
+                TerminateProcess(child.hProcess, 1);
+                WaitForSingleObject(child.hProcess, INFINITE);
+                std::ofstream(path, std::ios::app) << "\n  timed out after " << kManagedStackTimeoutMs << " ms\n";
+            }
+            CloseHandle(child.hThread);
+            CloseHandle(child.hProcess);
+        }
+#endif
+    }
+
+    struct FrameWatchdog::Impl
+    {
+        WatchdogSettings settings;
+        std::thread thread;
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        std::vector<std::string> typeNames;
+        std::string lastReport;
+        std::atomic<uint64_t> hitches{ 0 };
+        Counter* hitchCounter = nullptr;
+
+#if defined(_WIN32)
+        HANDLE watchedThread = nullptr;
+        ULONG_PTR stackHigh = 0;
+        std::vector<uint8_t> stackSnapshot;
+        bool symbolsReady = false;
+
+        int capture_native_stack(DWORD64* frames, int capacity);
+#endif
+    };
+
+#if defined(_WIN32)
+    // The watched thread is only suspended while its registers and stack are copied. The
+    // walk runs after it resumes: unwinding JIT-compiled frames calls into the runtime,
+    // which may need a lock the suspended thread holds.
+    int FrameWatchdog::Impl::capture_native_stack(DWORD64* frames, int capacity)
+    {
+        if (SuspendThread(watchedThread) == static_cast<DWORD>(-1)) return 0;
+        CONTEXT context{};
+        context.ContextFlags = CONTEXT_FULL;
+        bool captured = GetThreadContext(watchedThread, &context) != 0;
+        size_t copied = 0;
+        DWORD64 stackLow = 0;
+        if (captured)
+        {
+#if defined(_M_X64)
+            stackLow = context.Rsp;
+#elif defined(_M_ARM64)
+            stackLow = context.Sp;
+#else
+            stackLow = context.Esp;
+#endif
+            if (stackLow < stackHigh)
+            {
+                copied = std::min<size_t>(static_cast<size_t>(stackHigh - stackLow), stackSnapshot.size());
+                std::memcpy(stackSnapshot.data(), reinterpret_cast<const void*>(stackLow), copied);
+            }
+        }
+        ResumeThread(watchedThread);
+        if (!captured) return 0;
+
+        HANDLE process = GetCurrentProcess();
+        if (!symbolsReady)
+        {
+            SymSetOptions(SymGetOptions() | SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+            symbolsReady = SymInitialize(process, nullptr, TRUE) != 0;
+        }
+        else
+        {
+            SymRefreshModuleList(process); // Script assemblies come and go with reloads
+        }
+
+        STACKFRAME64 frame{};
+#if defined(_M_X64)
+        DWORD machine = IMAGE_FILE_MACHINE_AMD64;
+        frame.AddrPC.Offset = context.Rip;
+        frame.AddrFrame.Offset = context.Rbp;
+        frame.AddrStack.Offset = context.Rsp;
+#elif defined(_M_ARM64)
+        DWORD machine = IMAGE_FILE_MACHINE_ARM64;
+        frame.AddrPC.Offset = context.Pc;
+        frame.AddrFrame.Offset = context.Fp;
+        frame.AddrStack.Offset = context.Sp;
+#else
+        DWORD machine = IMAGE_FILE_MACHINE_I386;
+        frame.AddrPC.Offset = context.Eip;
+        frame.AddrFrame.Offset = context.Ebp;
+        frame.AddrStack.Offset = context.Esp;
+#endif
+        frame.AddrPC.Mode = AddrModeFlat;
+        frame.AddrFrame.Mode = AddrModeFlat;
+        frame.AddrStack.Mode = AddrModeFlat;
+
+        g_stackView = { stackLow, stackSnapshot.data(), copied };
+        int count = 0;
+        while (count < capacity &&
+               StackWalk64(machine, process, watchedThread, &frame, &context, read_snapshot_memory,
+                           SymFunctionTableAccess64, SymGetModuleBase64, nullptr))
+        {
+            if (frame.AddrPC.Offset == 0) break;
+            frames[count++] = frame.AddrPC.Offset;
+        }
+        g_stackView = {};
+        return count;
+    }
+#endif
+
+    FrameWatchdog::FrameWatchdog()
+        : impl_(std::make_unique<Impl>())
+    {
+    }
+
+    FrameWatchdog::~FrameWatchdog()
+    {
+        stop();
+    }
+
+    FrameWatchdog& FrameWatchdog::instance()
+    {
+        static FrameWatchdog watchdog;
+        return watchdog;
+    }
+
+    bool FrameWatchdog::start(const WatchdogSettings& settings)
+    {
+        stop();
+        if (settings.thresholdMs <= 0)
+        {
+            std::cerr << "Error: Frame watchdog threshold must be positive." << std::endl;
+            return false;
+        }
+
+#if defined(_WIN32)
+        if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &impl_->watchedThread,
+                             THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, 0))
+        {
+            std::cerr << "Error: Frame watchdog could not open the watched thread (" << GetLastError() << ")." << std::endl;
+            return false;
+        }
+        ULONG_PTR stackLow = 0;
+        GetCurrentThreadStackLimits(&stackLow, &impl_->stackHigh);
+        impl_->stackSnapshot.resize(kStackSnapshotBytes);
+#endif
+
+        impl_->settings = settings;
+        impl_->stopping = false;
+        impl_->hitchCounter = &MetricsRegistry::instance().counter("engine_hitches_total", "Frames that overran the watchdog threshold");
+        impl_->thread = std::thread([this] { watch(); });
+        return true;
+    }
+
+    void FrameWatchdog::stop()
+    {
+        if (!impl_->thread.joinable()) return;
+        {
+            std::lock_guard lock(impl_->mutex);
+            impl_->stopping = true;
+        }
+        impl_->wake.notify_all();
+        impl_->thread.join();
+
+#if defined(_WIN32)
+        CloseHandle(impl_->watchedThread);
+        impl_->watchedThread = nullptr;
+#endif
+    }
+
+    bool FrameWatchdog::running() const
+    {
+        return impl_->thread.joinable();
+    }
+
+    void FrameWatchdog::set_script_type_names(std::vector<std::string> names)
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->typeNames = std::move(names);
+    }
+
+    uint64_t FrameWatchdog::hitch_count() const
+    {
+        return impl_->hitches.load(std::memory_order_relaxed);
+    }
+
+    std::string FrameWatchdog::last_report() const
+    {
+        std::lock_guard lock(impl_->mutex);
+        return impl_->lastReport;
+    }
+
+    void FrameWatchdog::watch()
+    {
+        const auto threshold = std::chrono::milliseconds(impl_->settings.thresholdMs);
+        const auto poll = std::chrono::milliseconds(std::clamp(impl_->settings.thresholdMs / 4, kMinPollMs, kMaxPollMs));
+
+        uint64_t lastBeat = beat_.load(std::memory_order_relaxed);
+        Clock::time_point lastChange = Clock::now();
+        bool reported = false;
+
+        std::unique_lock lock(impl_->mutex);
+        while (!impl_->wake.wait_for(lock, poll, [this] { return impl_->stopping; }))
+        {
+            uint64_t beat = beat_.load(std::memory_order_relaxed);
+            Clock::time_point now = Clock::now();
+            if (beat != lastBeat)
+            {
+                if (reported)
+                {
+                    std::cerr << "Warning: Stalled frame finished after " << to_ms(now - lastChange) << " ms." << std::endl;
+                }
+                lastBeat = beat;
+                lastChange = now;
+                reported = false;
+                continue;
+            }
+            if (reported || now - lastChange < threshold) continue;
+
+            reported = true;
+            lock.unlock();
+            write_report(beat, to_ms(now - lastChange));
+            lock.lock();
+        }
+    }
+
+    void FrameWatchdog::write_report(uint64_t beat, double stalledMs)
+    {
+        uint64_t hitch = impl_->hitches.fetch_add(1, std::memory_order_relaxed) + 1;
+        impl_->hitchCounter->add();
+
+        // Snapshot what the thread is doing before the report I/O delays it further.
+        const char* hostActivity = hostActivity_.load(std::memory_order_relaxed);
+        int32_t phase = scriptActivity_.phase;
+        int32_t typeId = scriptActivity_.typeId;
+        int32_t entityId = scriptActivity_.entityId;
+
+#if defined(_WIN32)
+        if (IsDebuggerPresent())
+        {
+            std::cerr << "Warning: Frame stalled for " << stalledMs << " ms (debugger attached, no hitch report)." << std::endl;
+            return;
+        }
+        DWORD64 frames[kMaxStackFrames];
+        int frameCount = impl_->capture_native_stack(frames, kMaxStackFrames);
+#endif
+
+        std::string typeName = "unknown";
+        {
+            std::lock_guard lock(impl_->mutex);
+            if (typeId >= 0 && static_cast<size_t>(typeId) < impl_->typeNames.size()) typeName = impl_->typeNames[typeId];
+        }
+
+        std::ostringstream summary;
+        if (hostActivity) summary << hostActivity;
+        if (phase != ScriptActivity::kNone)
+        {
+            summary << (hostActivity ? ", " : "") << phase_name(phase) << " of " << typeName;
+            if (entityId >= 0) summary << " on entity " << entityId;
+        }
+        if (summary.tellp() == 0) summary << "host code";
+
+        std::error_code ec;
+        std::filesystem::create_directories(impl_->settings.reportDirectory, ec);
+        std::string path = (std::filesystem::path(impl_->settings.reportDirectory) /
+                            ("hitch_" + file_timestamp() + "_" + std::to_string(hitch) + ".txt")).string();
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Error: Failed to open hitch report for writing: " << path << std::endl;
+            return;
+        }
+
+        out << "Hitch report\n"
+            << "stalled_ms: " << stalledMs << " (frame still running)\n"
+            << "threshold_ms: " << impl_->settings.thresholdMs << "\n"
+            << "heartbeat: " << beat << "\n"
+            << "host_activity: " << (hostActivity ? hostActivity : "none") << "\n"
+            << "script_phase: " << phase_name(phase) << "\n";
+        if (phase != ScriptActivity::kNone)
+        {
+            out << "script_type: " << typeName << " (id " << typeId << ")\n"
+                << "entity: " << entityId << "\n";
+        }
+
+        out << "\nNative stack (watched thread):\n";
+#if defined(_WIN32)
+        if (frameCount == 0) out << "  unavailable: could not suspend or walk the thread\n";
+        for (int i = 0; i < frameCount; ++i) write_frame(out, i, frames[i]);
+        out.close();
+        if (!impl_->settings.managedStackCommand.empty()) append_managed_stacks(impl_->settings.managedStackCommand, path);
+#else
+        out << "  unavailable on this platform\n";
+        out.close();
+#endif
+
+        {
+            std::lock_guard lock(impl_->mutex);
+            impl_->lastReport = path;
+        }
+        std::cerr << "Warning: Frame stalled for " << stalledMs << " ms in " << summary.str()
+                  << "; hitch report written to '" << path << "'." << std::endl;
+    }
+
+} // namespace Core
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    // What the ScriptAPI is running, for hitch reports. Written from managed code while the
+    // watchdog runs: the phase and type per script type batch, the entity before each script
+    // call. The fields are plain aligned 32-bit values (stores don't tear) rather than
+    // atomics, so the per-script cost is one ordinary store with no fence; the watchdog
+    // only reads them once a frame is already late.
+    struct ScriptActivity
+    {
+        static constexpr int32_t kNone = -1;
+        static constexpr int32_t kStart = -2; // Start()/StartAsync() of queued scripts
+
+        volatile int32_t phase = kNone; // Core::ScriptPhase, kStart or kNone
+        volatile int32_t typeId = -1;   // See FrameWatchdog::set_script_type_names()
+        volatile int32_t entityId = -1; // -1 outside script calls
+    };
+
+    struct WatchdogSettings
+    {
+        int thresholdMs = 2000;
+        std::string reportDirectory = "hitches";
+        // Run as '<command> report --process-id <pid>' to add managed stacks (dotnet-stack).
+        // Empty skips them, e.g. under NativeAOT where the native stack already has them.
+        std::string managedStackCommand = "dotnet-stack";
+    };
+
+    // Detects frames that overrun badly: an infinite loop or blocking call in a script, a
+    // hung reload... The watched thread calls heartbeat() once per loop iteration, a single
+    // relaxed atomic store. A background thread notices when the count stops changing for
+    // longer than the threshold and writes one report per stall with the script being run,
+    // the watched thread's native stack and, when the tool is available, managed stacks.
+    // A line is logged when the stalled frame finally finishes. The header stays free of
+    // <mutex>/<thread> so the ScriptAPI can include it.
+    class DLL_API FrameWatchdog
+    {
+    public:
+        FrameWatchdog();
+        ~FrameWatchdog();
+
+        FrameWatchdog(const FrameWatchdog&) = delete;
+        FrameWatchdog& operator=(const FrameWatchdog&) = delete;
+
+        // Process-wide watchdog for the engine's main loop.
+        static FrameWatchdog& instance();
+
+        // Watches the calling thread.
+        bool start(const WatchdogSettings& settings);
+        void stop();
+        bool running() const;
+
+        void heartbeat() { beat_.store(beat_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+        // Labels host work outside the script phases ("Reload"...). Must point to a string
+        // literal; nullptr clears it.
+        void set_host_activity(const char* activity) { hostActivity_.store(activity, std::memory_order_relaxed); }
+        ScriptActivity& script_activity() { return scriptActivity_; }
+        // Names for ScriptActivity::typeId; replaced on every script load.
+        void set_script_type_names(std::vector<std::string> names);
+
+        uint64_t hitch_count() const;
+        // Path of the most recent report, empty if none was written.
+        std::string last_report() const;
+
+    private:
+        struct Impl;
+
+        void watch();
+        void write_report(uint64_t beat, double stalledMs);
+
+        std::unique_ptr<Impl> impl_;
+        std::atomic<uint64_t> beat_{ 0 };
+        std::atomic<const char*> hostActivity_{ nullptr };
+        ScriptActivity scriptActivity_;
+    };
+
+} // namespace Core
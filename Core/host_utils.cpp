@@ -4,6 +4,7 @@
 #define NOMINMAX
 #include <Windows.h>
 #include <shlwapi.h>
+#include <psapi.h> // GetProcessMemoryInfo
 #include <filesystem>
 #include <sstream>
 #include <algorithm> // std::replace_if, std::min
@@ -15,6 +16,7 @@
 #include <cstring> // For std::strlen
 
 #pragma comment(lib, "shlwapi.lib") // Needed for PathRemoveFileSpecA
+#pragma comment(lib, "psapi.lib")   // Needed for GetProcessMemoryInfo
 
 namespace Core::HostUtils
 {
@@ -210,4 +212,16 @@ namespace Core::HostUtils
         }
     }
 
+    bool get_process_memory(size_t& residentBytes, size_t& peakResidentBytes)
+    {
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            std::cerr << "Error: GetProcessMemoryInfo failed. Error code: " << GetLastError() << std::endl;
+            return false;
+        }
+        residentBytes = counters.WorkingSetSize;
+        peakResidentBytes = counters.PeakWorkingSetSize;
+        return true;
+    }
+
 } // namespace Core::HostUtils
\ No newline at end of file
@@ -16,4 +16,7 @@ namespace Core::HostUtils
     // Gets the directory containing the current executable/module.
     DLL_API std::string get_current_executable_directory();
 
+    // Resident memory of this process (working set) and its peak so far, in bytes.
+    DLL_API bool get_process_memory(size_t& residentBytes, size_t& peakResidentBytes);
+
 } // namespace Core::HostUtils
\ No newline at end of file
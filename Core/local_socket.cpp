@@ -0,0 +1,199 @@
+#include "local_socket.h"
+
+#include <cstdio>   // std::remove
+#include <cstring>  // std::memcpy, std::memset
+#include <iostream> // For basic error output
+#include <utility>  // std::exchange
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <winsock2.h>
+    #include <afunix.h>
+    using NativeSocket = SOCKET;
+#else
+    #include <sys/select.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+    using NativeSocket = int;
+#endif
+
+namespace Core
+{
+    namespace
+    {
+        NativeSocket native(intptr_t handle) { return static_cast<NativeSocket>(handle); }
+
+        bool ensure_sockets_initialized()
+        {
+#if defined(_WIN32)
+            static const bool initialized = [] {
+                WSADATA data;
+                return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+            }();
+            return initialized;
+#else
+            return true;
+#endif
+        }
+
+        void close_native(intptr_t handle)
+        {
+#if defined(_WIN32)
+            closesocket(native(handle));
+#else
+            ::close(native(handle));
+#endif
+        }
+
+        // Returns >0 if readable, 0 on timeout, <0 on error.
+        int wait_readable(intptr_t handle, std::chrono::milliseconds timeout)
+        {
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(native(handle), &readable);
+            timeval tv{};
+            tv.tv_sec = static_cast<long>(timeout.count() / 1000);
+            tv.tv_usec = static_cast<long>((timeout.count() % 1000) * 1000);
+            return select(static_cast<int>(native(handle)) + 1, &readable, nullptr, nullptr, &tv);
+        }
+    }
+
+    // --- LocalSocket ---
+
+    LocalSocket::~LocalSocket()
+    {
+        close();
+    }
+
+    LocalSocket::LocalSocket(LocalSocket&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    LocalSocket& LocalSocket::operator=(LocalSocket&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            handle_ = std::exchange(other.handle_, kInvalidHandle);
+            pending_ = std::move(other.pending_);
+        }
+        return *this;
+    }
+
+    void LocalSocket::close()
+    {
+        if (handle_ != kInvalidHandle) close_native(handle_);
+        handle_ = kInvalidHandle;
+        pending_.clear();
+    }
+
+    bool LocalSocket::write_all(std::string_view data)
+    {
+        while (!data.empty() && is_open())
+        {
+#if defined(_WIN32)
+            int sent = send(native(handle_), data.data(), static_cast<int>(data.size()), 0);
+#else
+            ssize_t sent = send(native(handle_), data.data(), data.size(), MSG_NOSIGNAL);
+#endif
+            if (sent <= 0) return false;
+            data.remove_prefix(static_cast<size_t>(sent));
+        }
+        return data.empty();
+    }
+
+    bool LocalSocket::read_line(std::string& line, std::chrono::milliseconds timeout, size_t maxLength)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;)
+        {
+            size_t newline = pending_.find('\n');
+            if (newline != std::string::npos)
+            {
+                line.assign(pending_, 0, newline);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                pending_.erase(0, newline + 1);
+                return true;
+            }
+            if (!is_open()) return false;
+            if (pending_.size() > maxLength)
+            {
+                close();
+                return false;
+            }
+
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 || wait_readable(handle_, remaining) <= 0) return false;
+
+            char buffer[512];
+            auto received = recv(native(handle_), buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                close();
+                return false;
+            }
+            pending_.append(buffer, static_cast<size_t>(received));
+        }
+    }
+
+    // --- LocalSocketServer ---
+
+    LocalSocketServer::~LocalSocketServer()
+    {
+        close();
+    }
+
+    bool LocalSocketServer::listen(const std::string& path)
+    {
+        close();
+        if (!ensure_sockets_initialized()) return false;
+
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "Error: Socket path too long: " << path << std::endl;
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        NativeSocket s = socket(AF_UNIX, SOCK_STREAM, 0);
+        intptr_t handle = static_cast<intptr_t>(s);
+        if (handle == LocalSocket::kInvalidHandle)
+        {
+            std::cerr << "Error: Failed to create socket for " << path << std::endl;
+            return false;
+        }
+
+        std::remove(path.c_str()); // Left behind by a previous run
+        if (bind(s, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(s, 4) != 0)
+        {
+            std::cerr << "Error: Failed to listen on " << path << std::endl;
+            close_native(handle);
+            return false;
+        }
+
+        handle_ = handle;
+        path_ = path;
+        return true;
+    }
+
+    void LocalSocketServer::close()
+    {
+        if (handle_ == LocalSocket::kInvalidHandle) return;
+        close_native(handle_);
+        handle_ = LocalSocket::kInvalidHandle;
+        std::remove(path_.c_str());
+        path_.clear();
+    }
+
+    LocalSocket LocalSocketServer::accept(std::chrono::milliseconds timeout)
+    {
+        if (!is_listening() || wait_readable(handle_, timeout) <= 0) return LocalSocket();
+        NativeSocket client = ::accept(native(handle_), nullptr, nullptr);
+        return LocalSocket(static_cast<intptr_t>(client));
+    }
+
+} // namespace Core
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+    // Connected Unix domain stream socket. AF_UNIX is also available on Windows 10 1803+,
+    // so local tooling can use the same path-based endpoints on every platform.
+    class DLL_API LocalSocket
+    {
+    public:
+        LocalSocket() = default;
+        explicit LocalSocket(intptr_t handle) : handle_(handle) {}
+        ~LocalSocket();
+
+        LocalSocket(LocalSocket&& other) noexcept;
+        LocalSocket& operator=(LocalSocket&& other) noexcept;
+        LocalSocket(const LocalSocket&) = delete;
+        LocalSocket& operator=(const LocalSocket&) = delete;
+
+        bool is_open() const { return handle_ != kInvalidHandle; }
+        void close();
+
+        bool write_all(std::string_view data);
+        // Reads up to and excluding the next '\n' ("\r\n" is accepted). Returns false on
+        // timeout, disconnect or a line longer than 'maxLength'; the latter two also close
+        // the socket, so is_open() tells a timeout apart.
+        bool read_line(std::string& line, std::chrono::milliseconds timeout, size_t maxLength = 4096);
+
+        static constexpr intptr_t kInvalidHandle = -1;
+
+    private:
+        intptr_t handle_ = kInvalidHandle;
+        std::string pending_; // Bytes received past the last returned line
+    };
+
+    // Listening Unix domain socket bound to a filesystem path.
+    class DLL_API LocalSocketServer
+    {
+    public:
+        LocalSocketServer() = default;
+        ~LocalSocketServer();
+
+        LocalSocketServer(const LocalSocketServer&) = delete;
+        LocalSocketServer& operator=(const LocalSocketServer&) = delete;
+
+        // Removes a stale socket file at 'path' before binding.
+        bool listen(const std::string& path);
+        void close();
+        bool is_listening() const { return handle_ != LocalSocket::kInvalidHandle; }
+
+        // Waits up to 'timeout' for a client; the result is closed if none arrived.
+        LocalSocket accept(std::chrono::milliseconds timeout);
+
+    private:
+        intptr_t handle_ = LocalSocket::kInvalidHandle;
+        std::string path_;
+    };
+
+} // namespace Core
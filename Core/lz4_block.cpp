@@ -0,0 +1,71 @@
+#include "lz4_block.h"
+
+#include <cstring> // std::memcpy
+
+namespace Core
+{
+    namespace
+    {
+        constexpr size_t kMinMatch = 4;
+
+        // Lengths of 15 continue in following bytes, each adding up to 255.
+        bool read_length(const uint8_t*& in, const uint8_t* inEnd, size_t& length)
+        {
+            if (length != 15) return true;
+            uint8_t b = 0;
+            do
+            {
+                if (in == inEnd) return false;
+                b = *in++;
+                length += b;
+            } while (b == 255);
+            return true;
+        }
+    }
+
+    bool lz4_decompress_block(std::span<const uint8_t> input, std::span<uint8_t> output)
+    {
+        const uint8_t* in = input.data();
+        const uint8_t* const inEnd = in + input.size();
+        uint8_t* out = output.data();
+        uint8_t* const outEnd = out + output.size();
+
+        while (in < inEnd)
+        {
+            const uint8_t token = *in++;
+
+            size_t literals = token >> 4;
+            if (!read_length(in, inEnd, literals)) return false;
+            if (literals > size_t(inEnd - in) || literals > size_t(outEnd - out)) return false;
+            std::memcpy(out, in, literals);
+            in += literals;
+            out += literals;
+
+            if (in == inEnd) break; // The last sequence has no match part
+
+            if (inEnd - in < 2) return false;
+            const size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+            in += 2;
+            if (offset == 0 || offset > size_t(out - output.data())) return false;
+
+            size_t match = token & 0x0F;
+            if (!read_length(in, inEnd, match)) return false;
+            match += kMinMatch;
+            if (match > size_t(outEnd - out)) return false;
+
+            // Matches may overlap their own output (offset < length), so copy forward
+            const uint8_t* from = out - offset;
+            if (offset >= match)
+            {
+                std::memcpy(out, from, match);
+                out += match;
+            }
+            else
+            {
+                for (size_t i = 0; i < match; ++i) *out++ = *from++;
+            }
+        }
+        return out == outEnd;
+    }
+
+} // namespace Core
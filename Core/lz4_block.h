@@ -0,0 +1,14 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstdint>
+#include <span>
+
+namespace Core
+{
+    // Decodes one raw LZ4 block (the format LZ4_compress_default() produces, without the
+    // frame header). 'output' must be exactly the uncompressed size, which the block does
+    // not record. Returns false on malformed input; never reads or writes out of bounds.
+    DLL_API bool lz4_decompress_block(std::span<const uint8_t> input, std::span<uint8_t> output);
+
+} // namespace Core
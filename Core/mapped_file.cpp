@@ -0,0 +1,126 @@
+#include "mapped_file.h"
+
+#include <iostream> // For basic error output
+#include <utility>  // std::exchange
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Core
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            isOpen_ = std::exchange(other.isOpen_, false);
+#if defined(_WIN32)
+            file_ = std::exchange(other.file_, nullptr);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+#else
+            fd_ = std::exchange(other.fd_, -1);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            std::cerr << "Error: Failed to open " << path << " for mapping. Error code: " << GetLastError() << std::endl;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        file_ = file;
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        isOpen_ = true;
+        if (size_ == 0) return true; // Empty files cannot be mapped, but are valid.
+
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_)
+        {
+            std::cerr << "Error: CreateFileMapping failed for " << path << ". Error code: " << GetLastError() << std::endl;
+            close();
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_)
+        {
+            std::cerr << "Error: MapViewOfFile failed for " << path << ". Error code: " << GetLastError() << std::endl;
+            close();
+            return false;
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0)
+        {
+            std::cerr << "Error: Failed to open " << path << " for mapping." << std::endl;
+            return false;
+        }
+
+        struct stat st{};
+        fstat(fd_, &st);
+        size_ = static_cast<size_t>(st.st_size);
+        isOpen_ = true;
+        if (size_ == 0) return true;
+
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "Error: mmap failed for " << path << "." << std::endl;
+            close();
+            return false;
+        }
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const uint8_t*>(mapped);
+#endif
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+#if defined(_WIN32)
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = nullptr;
+#else
+        if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        isOpen_ = false;
+    }
+
+} // namespace Core
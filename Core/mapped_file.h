@@ -0,0 +1,45 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Core
+{
+    // Read-only memory mapping of a whole file.
+    class DLL_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        // Non-copyable, movable
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Maps the file. Returns false (and stays closed) if it cannot be opened or mapped.
+        bool open(const std::string& path);
+        void close();
+
+        bool is_open() const { return isOpen_; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        std::span<const uint8_t> bytes() const { return { data_, size_ }; }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        bool isOpen_ = false;
+#if defined(_WIN32)
+        void* file_ = nullptr;    // HANDLE
+        void* mapping_ = nullptr; // HANDLE
+#else
+        int fd_ = -1;
+#endif
+    };
+
+} // namespace Core
@@ -0,0 +1,325 @@
+#include "metrics.h"
+
+#include <algorithm> // std::upper_bound
+#include <bit>       // std::bit_cast
+#include <cstdlib>   // std::abort
+#include <deque>
+#include <iostream>  // For basic error output
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace Core
+{
+    namespace
+    {
+        void atomic_add(std::atomic<uint64_t>& bits, double amount)
+        {
+            uint64_t expected = bits.load(std::memory_order_relaxed);
+            while (!bits.compare_exchange_weak(expected, std::bit_cast<uint64_t>(std::bit_cast<double>(expected) + amount),
+                                               std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // HELP text escapes only backslash and line feed (label values also escape quotes).
+        void write_help(std::ostream& out, std::string_view help)
+        {
+            for (char c : help)
+            {
+                if (c == '\\') out << "\\\\";
+                else if (c == '\n') out << "\\n";
+                else out << c;
+            }
+        }
+
+        // Prometheus wants +Inf spelled out and no locale-dependent formatting.
+        void write_number(std::ostream& out, double value)
+        {
+            if (value == std::numeric_limits<double>::infinity()) out << "+Inf";
+            else out << value;
+        }
+    }
+
+    // --- Counter / Gauge ---
+
+    void Counter::add(double amount)
+    {
+        atomic_add(bits_, amount);
+    }
+
+    double Counter::value() const
+    {
+        return std::bit_cast<double>(bits_.load(std::memory_order_relaxed));
+    }
+
+    void Gauge::set(double value)
+    {
+        bits_.store(std::bit_cast<uint64_t>(value), std::memory_order_relaxed);
+    }
+
+    void Gauge::add(double amount)
+    {
+        atomic_add(bits_, amount);
+    }
+
+    double Gauge::value() const
+    {
+        return std::bit_cast<double>(bits_.load(std::memory_order_relaxed));
+    }
+
+    // --- Histogram ---
+
+    Histogram::Histogram(std::vector<double> upperBounds)
+        : upperBounds_(std::move(upperBounds))
+        , buckets_(new std::atomic<uint64_t>[upperBounds_.size() + 1])
+    {
+        for (size_t i = 0; i <= upperBounds_.size(); ++i) buckets_[i].store(0, std::memory_order_relaxed);
+    }
+
+    void Histogram::observe(double value)
+    {
+        size_t bucket = static_cast<size_t>(std::lower_bound(upperBounds_.begin(), upperBounds_.end(), value) - upperBounds_.begin());
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.add(value);
+    }
+
+    std::vector<uint64_t> Histogram::bucket_counts() const
+    {
+        std::vector<uint64_t> counts(upperBounds_.size() + 1);
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    double Histogram::quantile(double q) const
+    {
+        std::vector<uint64_t> counts = bucket_counts();
+        uint64_t total = 0;
+        for (uint64_t c : counts) total += c;
+        if (total == 0) return 0.0;
+
+        double rank = q * static_cast<double>(total);
+        uint64_t below = 0;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            if (static_cast<double>(below + counts[i]) >= rank && counts[i] > 0)
+            {
+                if (i == upperBounds_.size()) return upperBounds_.empty() ? 0.0 : upperBounds_.back(); // +Inf bucket
+                double lower = i == 0 ? 0.0 : upperBounds_[i - 1];
+                double fraction = (rank - static_cast<double>(below)) / static_cast<double>(counts[i]);
+                return lower + (upperBounds_[i] - lower) * fraction;
+            }
+            below += counts[i];
+        }
+        return upperBounds_.empty() ? 0.0 : upperBounds_.back();
+    }
+
+    std::vector<double> Histogram::exponential_bounds(double start, double factor, int count)
+    {
+        std::vector<double> bounds;
+        bounds.reserve(static_cast<size_t>(count));
+        for (double b = start; static_cast<int>(bounds.size()) < count; b *= factor) bounds.push_back(b);
+        return bounds;
+    }
+
+    // --- MetricsRegistry ---
+
+    struct MetricsRegistry::Impl
+    {
+        enum class Type { Counter, Gauge, Histogram };
+
+        struct Series
+        {
+            std::string labels;
+            void* metric;
+        };
+
+        struct Family
+        {
+            std::string help;
+            Type type;
+            std::vector<Series> series;
+        };
+
+        static const char* type_name(Type type)
+        {
+            return type == Type::Counter ? "counter" : type == Type::Gauge ? "gauge" : "histogram";
+        }
+
+        // Registering a name twice with a different type or bucket layout is a bug in the
+        // caller; handing back the existing metric as the wrong type would corrupt it.
+        [[noreturn]] static void mismatch(std::string_view name, std::string_view labels, const std::string& what)
+        {
+            std::cerr << "Error: Metric '" << name << "' {" << labels << "} registered again with a different " << what << std::endl;
+            std::abort();
+        }
+
+        static void check_series(const Counter&, std::string_view, std::string_view) {}
+        static void check_series(const Gauge&, std::string_view, std::string_view) {}
+        static void check_series(const Histogram& existing, std::string_view name, std::string_view labels,
+                                 const std::vector<double>& upperBounds)
+        {
+            if (existing.upper_bounds() != upperBounds) mismatch(name, labels, "bucket layout");
+        }
+
+        template <typename T, typename... Args>
+        T& get_or_add(std::deque<T>& storage, Type type, std::string_view name, std::string_view help,
+                      std::string_view labels, Args&&... args)
+        {
+            std::lock_guard lock(mutex);
+            Family& family = families[std::string(name)];
+            if (family.series.empty())
+            {
+                family.help = help;
+                family.type = type;
+            }
+            else if (family.type != type)
+            {
+                mismatch(name, labels, std::string("type (") + type_name(type) + ", was " + type_name(family.type) + ")");
+            }
+            for (const Series& s : family.series)
+            {
+                if (s.labels != labels) continue;
+                T& existing = *static_cast<T*>(s.metric);
+                check_series(existing, name, labels, args...);
+                return existing;
+            }
+            T& metric = storage.emplace_back(std::forward<Args>(args)...);
+            family.series.push_back({ std::string(labels), &metric });
+            return metric;
+        }
+
+        mutable std::mutex mutex;
+        std::map<std::string, Family> families; // Sorted, so output is stable
+        std::deque<Counter> counters;           // deque: references stay valid as it grows
+        std::deque<Gauge> gauges;
+        std::deque<Histogram> histograms;
+        std::vector<std::pair<const Histogram*, std::vector<double>>> quantileExports;
+    };
+
+    MetricsRegistry::MetricsRegistry()
+        : impl_(std::make_unique<Impl>())
+    {
+    }
+
+    MetricsRegistry::~MetricsRegistry() = default;
+
+    MetricsRegistry& MetricsRegistry::instance()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    Counter& MetricsRegistry::counter(std::string_view name, std::string_view help, std::string_view labels)
+    {
+        return impl_->get_or_add(impl_->counters, Impl::Type::Counter, name, help, labels);
+    }
+
+    Gauge& MetricsRegistry::gauge(std::string_view name, std::string_view help, std::string_view labels)
+    {
+        return impl_->get_or_add(impl_->gauges, Impl::Type::Gauge, name, help, labels);
+    }
+
+    Histogram& MetricsRegistry::histogram(std::string_view name, std::string_view help, const std::vector<double>& upperBounds,
+                                          std::string_view labels)
+    {
+        return impl_->get_or_add(impl_->histograms, Impl::Type::Histogram, name, help, labels, upperBounds);
+    }
+
+    void MetricsRegistry::export_quantiles(const Histogram& histogram, std::vector<double> quantiles)
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->quantileExports.emplace_back(&histogram, std::move(quantiles));
+    }
+
+    std::string MetricsRegistry::label(std::string_view key, std::string_view value)
+    {
+        std::string result(key);
+        result += "=\"";
+        for (char c : value)
+        {
+            if (c == '\\' || c == '"') result += '\\';
+            if (c == '\n') { result += "\\n"; continue; }
+            result += c;
+        }
+        result += '"';
+        return result;
+    }
+
+    void MetricsRegistry::write_prometheus(std::ostream& out) const
+    {
+        std::lock_guard lock(impl_->mutex);
+        out.precision(12);
+
+        auto open_labels = [&out](const std::string& labels, bool more) {
+            if (labels.empty() && !more) return;
+            out << '{' << labels << (labels.empty() || !more ? "" : ",");
+        };
+
+        for (const auto& [name, family] : impl_->families)
+        {
+            out << "# HELP " << name << ' ';
+            write_help(out, family.help);
+            out << '\n';
+            out << "# TYPE " << name << ' ' << Impl::type_name(family.type) << '\n';
+
+            for (const Impl::Series& series : family.series)
+            {
+                if (family.type == Impl::Type::Counter || family.type == Impl::Type::Gauge)
+                {
+                    double value = family.type == Impl::Type::Counter
+                        ? static_cast<const Counter*>(series.metric)->value()
+                        : static_cast<const Gauge*>(series.metric)->value();
+                    out << name;
+                    if (!series.labels.empty()) out << '{' << series.labels << '}';
+                    out << ' ';
+                    write_number(out, value);
+                    out << '\n';
+                    continue;
+                }
+
+                const Histogram& h = *static_cast<const Histogram*>(series.metric);
+                std::vector<uint64_t> counts = h.bucket_counts();
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < counts.size(); ++i)
+                {
+                    cumulative += counts[i];
+                    out << name << "_bucket";
+                    open_labels(series.labels, true);
+                    out << "le=\"";
+                    write_number(out, i < h.upper_bounds().size() ? h.upper_bounds()[i] : std::numeric_limits<double>::infinity());
+                    out << "\"} " << cumulative << '\n';
+                }
+                out << name << "_sum";
+                if (!series.labels.empty()) out << '{' << series.labels << '}';
+                out << ' ' << h.sum() << '\n';
+                out << name << "_count";
+                if (!series.labels.empty()) out << '{' << series.labels << '}';
+                out << ' ' << cumulative << '\n';
+            }
+        }
+
+        for (const auto& [histogram, quantiles] : impl_->quantileExports)
+        {
+            // Find the family the histogram belongs to
+            for (const auto& [name, family] : impl_->families)
+            {
+                for (const Impl::Series& series : family.series)
+                {
+                    if (series.metric != histogram) continue;
+                    out << "# HELP " << name << "_quantile Estimated from " << name << " buckets\n";
+                    out << "# TYPE " << name << "_quantile gauge\n";
+                    for (double q : quantiles)
+                    {
+                        out << name << "_quantile";
+                        open_labels(series.labels, true);
+                        out << "quantile=\"" << q << "\"} " << histogram->quantile(q) << '\n';
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace Core
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Metrics are updated with relaxed atomics and read by the exporter thread, so recording
+// a value never blocks the frame. Registration takes a lock and is meant for setup code;
+// keep the returned reference instead of looking a metric up every frame.
+
+namespace Core
+{
+    // Monotonic total (events, seconds spent...)
+    class DLL_API Counter
+    {
+    public:
+        void add(double amount = 1.0);
+        double value() const;
+
+    private:
+        std::atomic<uint64_t> bits_{ 0 }; // double, stored as its bit pattern
+    };
+
+    // Value that can go up and down
+    class DLL_API Gauge
+    {
+    public:
+        void set(double value);
+        void add(double amount);
+        double value() const;
+
+    private:
+        std::atomic<uint64_t> bits_{ 0 };
+    };
+
+    // Counts observations into fixed buckets (cumulative 'le' buckets on export)
+    class DLL_API Histogram
+    {
+    public:
+        // 'upperBounds' must be ascending; an implicit +Inf bucket is added.
+        explicit Histogram(std::vector<double> upperBounds);
+
+        void observe(double value);
+
+        const std::vector<double>& upper_bounds() const { return upperBounds_; }
+        // Per-bucket (not cumulative) counts, +Inf bucket last
+        std::vector<uint64_t> bucket_counts() const;
+        uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        double sum() const { return sum_.value(); }
+        // Estimate by linear interpolation inside the bucket holding the quantile.
+        double quantile(double q) const;
+
+        // Buckets growing by 'factor' from 'start'
+        static std::vector<double> exponential_bounds(double start, double factor, int count);
+
+    private:
+        std::vector<double> upperBounds_;
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+        std::atomic<uint64_t> count_{ 0 };
+        Counter sum_;
+    };
+
+    class DLL_API MetricsRegistry
+    {
+    public:
+        MetricsRegistry();
+        ~MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        // Process-wide registry shared by the engine loop and the ScriptAPI.
+        static MetricsRegistry& instance();
+
+        // Returns the existing metric when name and labels match. 'labels' is the
+        // Prometheus label list without braces, e.g. label("script_type", name).
+        // Reusing a name with another metric type or bucket layout is reported and aborts.
+        Counter& counter(std::string_view name, std::string_view help, std::string_view labels = {});
+        Gauge& gauge(std::string_view name, std::string_view help, std::string_view labels = {});
+        Histogram& histogram(std::string_view name, std::string_view help, const std::vector<double>& upperBounds,
+                             std::string_view labels = {});
+
+        // Also export '<name>_quantile{quantile="q"}' gauges estimated from the histogram's
+        // buckets, for consumers that can't run histogram_quantile().
+        void export_quantiles(const Histogram& histogram, std::vector<double> quantiles);
+
+        // Prometheus text exposition format (version 0.0.4)
+        void write_prometheus(std::ostream& out) const;
+
+        // Formats key="value" with the value escaped.
+        static std::string label(std::string_view key, std::string_view value);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+} // namespace Core
@@ -0,0 +1,105 @@
+#include "metrics_exporter.h"
+
+#include <filesystem> // std::filesystem::rename
+#include <fstream>
+#include <iostream>   // For basic error output
+#include <sstream>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr std::string_view kSocketPrefix = "unix:";
+        // How often the socket loop checks for stop()
+        constexpr std::chrono::milliseconds kAcceptTimeout{ 200 };
+    }
+
+    MetricsExporter::MetricsExporter(MetricsRegistry& registry)
+        : registry_(registry)
+    {
+    }
+
+    MetricsExporter::~MetricsExporter()
+    {
+        stop();
+    }
+
+    bool MetricsExporter::start(const std::string& target, std::chrono::milliseconds interval)
+    {
+        stop();
+        stopping_ = false;
+
+        if (target.compare(0, kSocketPrefix.size(), kSocketPrefix) == 0)
+        {
+            if (!server_.listen(target.substr(kSocketPrefix.size()))) return false;
+            thread_ = std::thread(&MetricsExporter::run_socket, this);
+        }
+        else
+        {
+            if (!write_file(target)) return false; // Fail early on a bad path
+            thread_ = std::thread(&MetricsExporter::run_file, this, target, interval);
+        }
+        return true;
+    }
+
+    void MetricsExporter::stop()
+    {
+        if (thread_.joinable())
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            thread_.join();
+        }
+        server_.close();
+    }
+
+    bool MetricsExporter::write_file(const std::string& path)
+    {
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::trunc);
+            if (!out)
+            {
+                std::cerr << "Error: Cannot write metrics file " << tempPath << std::endl;
+                return false;
+            }
+            registry_.write_prometheus(out);
+            if (!out) return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        return !ec;
+    }
+
+    void MetricsExporter::run_file(std::string path, std::chrono::milliseconds interval)
+    {
+        std::unique_lock lock(mutex_);
+        while (!wake_.wait_for(lock, interval, [this] { return stopping_.load(); }))
+        {
+            lock.unlock();
+            write_file(path);
+            lock.lock();
+        }
+        lock.unlock();
+        write_file(path); // Final values
+    }
+
+    void MetricsExporter::run_socket()
+    {
+        std::ostringstream text;
+        while (!stopping_)
+        {
+            LocalSocket client = server_.accept(kAcceptTimeout);
+            if (!client.is_open()) continue;
+
+            text.str({});
+            registry_.write_prometheus(text);
+            client.write_all(text.str());
+        }
+    }
+
+} // namespace Core
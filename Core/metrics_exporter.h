@@ -0,0 +1,50 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "metrics.h"
+#include "local_socket.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Note: uses <thread>/<mutex>, so this header is for native translation units only.
+
+namespace Core
+{
+    // Renders a MetricsRegistry in Prometheus text format on its own thread, so the frame
+    // loop only pays for the atomic updates. Targets:
+    //   <path>        file rewritten every interval (via '<path>.tmp' + rename, suitable
+    //                 for node_exporter's textfile collector)
+    //   unix:<path>   Unix domain socket; every client that connects receives a fresh
+    //                 snapshot and is disconnected
+    class DLL_API MetricsExporter
+    {
+    public:
+        explicit MetricsExporter(MetricsRegistry& registry = MetricsRegistry::instance());
+        ~MetricsExporter();
+
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+        // Fails if the file can't be written or the socket can't be bound.
+        bool start(const std::string& target, std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+        void stop();
+        bool running() const { return thread_.joinable(); }
+
+    private:
+        void run_file(std::string path, std::chrono::milliseconds interval);
+        void run_socket();
+        bool write_file(const std::string& path);
+
+        MetricsRegistry& registry_;
+        LocalSocketServer server_; // Bound by start() so a bad path fails there
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::atomic<bool> stopping_{ false };
+    };
+
+} // namespace Core
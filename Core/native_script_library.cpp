@@ -0,0 +1,45 @@
+#include "native_script_library.h"
+
+#include <algorithm> // std::replace
+#include <iostream>  // For basic error output
+
+namespace Core
+{
+    NativeScriptLibrary::~NativeScriptLibrary()
+    {
+        unload();
+    }
+
+    bool NativeScriptLibrary::load(const std::string& path)
+    {
+        unload();
+        library_ = LoadLibraryExA(path.c_str(), nullptr, 0);
+        if (!library_)
+        {
+            std::cerr << "Error: Failed to load script library " << path << ". Error code: " << GetLastError() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void NativeScriptLibrary::unload()
+    {
+        // Unloading a NativeAOT library is unsupported (its runtime's threads and GC stay
+        // live), so FreeLibrary() is never called; the module stays mapped until exit.
+        library_ = nullptr;
+    }
+
+    std::string NativeScriptLibrary::export_name(const std::string& typeName, const std::string& methodName)
+    {
+        std::string name = typeName + "_" + methodName;
+        std::replace(name.begin(), name.end(), '.', '_');
+        return name;
+    }
+
+    void* NativeScriptLibrary::find_export(const std::string& name) const
+    {
+        if (!library_) return nullptr;
+        return reinterpret_cast<void*>(GetProcAddress(library_, name.c_str()));
+    }
+
+} // namespace Core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <string>
+#include <Windows.h> // HMODULE
+
+namespace Core
+{
+    // Script library compiled ahead of time with NativeAOT: a plain DLL whose entry points
+    // are C exports ([UnmanagedCallersOnly(EntryPoint = ...)]), so no runtime is started,
+    // no TPA list is built and nothing is JIT compiled.
+    //
+    // Entry points keep the contract of the CoreCLR host (same signatures, same
+    // ScriptStatus/ScriptErrorInfo convention); only the lookup differs. The export for
+    // 'Namespace.Type.Method' is named 'Namespace_Type_Method'. NativeScripts/ builds such a
+    // library from the scripts alone (ScriptAPI is C++/CLI and can't be compiled ahead of
+    // time); it supports a subset of the ScriptAPI, see NativeScripts/EngineInterface.cs.
+    class DLL_API NativeScriptLibrary
+    {
+    public:
+        NativeScriptLibrary() = default;
+        ~NativeScriptLibrary();
+
+        // Non-copyable
+        NativeScriptLibrary(const NativeScriptLibrary&) = delete;
+        NativeScriptLibrary& operator=(const NativeScriptLibrary&) = delete;
+
+        bool load(const std::string& path);
+        // Forgets the library without unloading it; NativeAOT modules stay loaded until the
+        // process exits.
+        void unload();
+        bool is_loaded() const { return library_ != nullptr; }
+
+        // Same shape as DotNetRuntime::create_delegate(), minus the assembly name.
+        template <typename TDelegate>
+        bool get_entry_point(const std::string& typeName, const std::string& methodName, TDelegate* delegatePtr)
+        {
+            void* address = find_export(export_name(typeName, methodName));
+            *delegatePtr = reinterpret_cast<TDelegate>(address);
+            return address != nullptr;
+        }
+
+        static std::string export_name(const std::string& typeName, const std::string& methodName);
+
+    private:
+        void* find_export(const std::string& name) const;
+
+        HMODULE library_ = nullptr;
+    };
+
+} // namespace Core
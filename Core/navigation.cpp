@@ -0,0 +1,443 @@
+#include "navigation.h"
+#include "metrics.h"
+#include "thread_pool.h"
+
+#include <algorithm> // std::push_heap, std::pop_heap, std::reverse
+#include <atomic>
+#include <cmath>     // std::floor
+#include <cstdlib>   // std::abs
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr float kDiagonal = 1.41421356f;
+        constexpr int kDx[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+        constexpr int kDz[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+        struct OpenEntry
+        {
+            float f;
+            int32_t cell;
+        };
+
+        // Per-thread A* state, sized to the largest grid searched on the thread. Entries are
+        // valid only where their stamp matches the current search, so nothing is cleared
+        // between searches.
+        struct SearchState
+        {
+            std::vector<float> g;
+            std::vector<int32_t> parent;
+            std::vector<uint32_t> seen;   // == generation: g and parent are set
+            std::vector<uint32_t> closed; // == generation: expanded
+            std::vector<OpenEntry> open;
+            uint32_t generation = 0;
+
+            void begin(size_t cellCount)
+            {
+                if (seen.size() < cellCount) {
+                    g.resize(cellCount);
+                    parent.resize(cellCount);
+                    seen.assign(cellCount, 0);
+                    closed.assign(cellCount, 0);
+                }
+                if (++generation == 0) {
+                    std::fill(seen.begin(), seen.end(), 0);
+                    std::fill(closed.begin(), closed.end(), 0);
+                    generation = 1;
+                }
+                open.clear();
+            }
+        };
+
+        thread_local SearchState tlsSearch;
+
+        bool open_less(const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; } // Min-heap
+
+        // Octile distance; admissible because no cell costs less than 1.
+        float heuristic(int x, int z, int goalX, int goalZ)
+        {
+            int dx = std::abs(x - goalX);
+            int dz = std::abs(z - goalZ);
+            return static_cast<float>(dx + dz) + (kDiagonal - 2.0f) * static_cast<float>(std::min(dx, dz));
+        }
+
+        uint64_t path_key(int startCell, int goalCell)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(startCell)) << 32) | static_cast<uint32_t>(goalCell);
+        }
+    }
+
+    // --- NavGrid ---
+
+    NavGrid::NavGrid(int width, int height, float cellSize, const Math::float3& origin)
+        : width_(std::max(width, 0))
+        , height_(std::max(height, 0))
+        , cellSize_(cellSize)
+        , origin_(origin)
+        , costs_(static_cast<size_t>(width_) * height_, 1)
+    {
+    }
+
+    bool NavGrid::load(const std::string& path, float cellSize, const Math::float3& origin)
+    {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Error: Cannot open navigation grid '" << path << "'." << std::endl;
+            return false;
+        }
+
+        std::vector<std::string> rows;
+        std::string line;
+        size_t width = 0;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            width = std::max(width, line.size());
+            rows.push_back(std::move(line));
+        }
+        if (rows.empty() || width == 0) {
+            std::cerr << "Error: Navigation grid '" << path << "' is empty." << std::endl;
+            return false;
+        }
+
+        *this = NavGrid(static_cast<int>(width), static_cast<int>(rows.size()), cellSize, origin);
+        for (size_t z = 0; z < rows.size(); ++z) {
+            for (size_t x = 0; x < width; ++x) {
+                char c = x < rows[z].size() ? rows[z][x] : '#';
+                uint8_t cost = 0;
+                if (c == '.') cost = 1;
+                else if (c >= '1' && c <= '9') cost = static_cast<uint8_t>(c - '0');
+                else if (c != '#') {
+                    std::cerr << "Error: " << path << ":" << z + 1 << ": unexpected '" << c << "' (use '.', '#' or 1-9)." << std::endl;
+                    return false;
+                }
+                set_cost(static_cast<int>(x), static_cast<int>(z), cost);
+            }
+        }
+        return true;
+    }
+
+    int NavGrid::cell_at(const Math::float3& position) const
+    {
+        if (costs_.empty()) return -1;
+        float fx = std::floor((position.x - origin_.x) / cellSize_);
+        float fz = std::floor((position.z - origin_.z) / cellSize_);
+        if (!(fx >= 0.0f && fz >= 0.0f && fx < static_cast<float>(width_) && fz < static_cast<float>(height_))) return -1;
+        return static_cast<int>(fz) * width_ + static_cast<int>(fx);
+    }
+
+    Math::float3 NavGrid::cell_center(int cell) const
+    {
+        int x = cell % width_;
+        int z = cell / width_;
+        return { origin_.x + (static_cast<float>(x) + 0.5f) * cellSize_, origin_.y,
+                 origin_.z + (static_cast<float>(z) + 0.5f) * cellSize_ };
+    }
+
+    bool NavGrid::find_path(int startCell, int goalCell, std::vector<Math::float3>& waypoints) const
+    {
+        waypoints.clear();
+        const int cellCount = static_cast<int>(costs_.size());
+        if (startCell < 0 || goalCell < 0 || startCell >= cellCount || goalCell >= cellCount) return false;
+        if (costs_[startCell] == 0 || costs_[goalCell] == 0) return false;
+
+        SearchState& s = tlsSearch;
+        s.begin(costs_.size());
+        const uint32_t gen = s.generation;
+        const int goalX = goalCell % width_;
+        const int goalZ = goalCell / width_;
+
+        s.g[startCell] = 0.0f;
+        s.parent[startCell] = -1;
+        s.seen[startCell] = gen;
+        s.open.push_back({ heuristic(startCell % width_, startCell / width_, goalX, goalZ), startCell });
+
+        bool found = false;
+        while (!s.open.empty()) {
+            std::pop_heap(s.open.begin(), s.open.end(), open_less);
+            int cell = s.open.back().cell;
+            s.open.pop_back();
+            if (s.closed[cell] == gen) continue; // Superseded by a cheaper entry
+            s.closed[cell] = gen;
+            if (cell == goalCell) { found = true; break; }
+
+            const int x = cell % width_;
+            const int z = cell / width_;
+            for (int i = 0; i < 8; ++i) {
+                int nx = x + kDx[i];
+                int nz = z + kDz[i];
+                if (nx < 0 || nz < 0 || nx >= width_ || nz >= height_) continue;
+                int next = nz * width_ + nx;
+                uint8_t stepCost = costs_[next];
+                if (stepCost == 0 || s.closed[next] == gen) continue;
+                bool diagonal = i >= 4;
+                if (diagonal && (cost(nx, z) == 0 || cost(x, nz) == 0)) continue; // No corner cutting
+
+                float g = s.g[cell] + static_cast<float>(stepCost) * (diagonal ? kDiagonal : 1.0f);
+                if (s.seen[next] == gen && s.g[next] <= g) continue;
+                s.g[next] = g;
+                s.parent[next] = cell;
+                s.seen[next] = gen;
+                s.open.push_back({ g + heuristic(nx, nz, goalX, goalZ), next });
+                std::push_heap(s.open.begin(), s.open.end(), open_less);
+            }
+        }
+        if (!found) return false;
+
+        // Walk back from the goal, keeping only cells where the direction changes. Steps
+        // are compared as (dx, dz): on narrow grids different moves share an index delta.
+        int cell = goalCell;
+        int lastDx = 0;
+        int lastDz = 0;
+        waypoints.push_back(cell_center(goalCell));
+        while (s.parent[cell] >= 0) {
+            int prev = s.parent[cell];
+            int dx = cell % width_ - prev % width_;
+            int dz = cell / width_ - prev / width_;
+            if ((lastDx != 0 || lastDz != 0) && (dx != lastDx || dz != lastDz)) waypoints.push_back(cell_center(cell));
+            lastDx = dx;
+            lastDz = dz;
+            cell = prev;
+        }
+        if (startCell != goalCell) waypoints.push_back(cell_center(startCell));
+        std::reverse(waypoints.begin(), waypoints.end());
+        return true;
+    }
+
+    // --- NavigationService ---
+
+    struct NavigationService::Impl
+    {
+        struct Path
+        {
+            bool found = false;
+            std::vector<Math::float3> waypoints;
+        };
+
+        struct Request
+        {
+            PathRequestId id;
+            Math::float3 start;
+            Math::float3 goal;
+        };
+
+        struct Job
+        {
+            std::shared_ptr<const NavGrid> grid; // The grid at dispatch, kept alive while searching
+            int startCell;
+            int goalCell;
+            std::vector<PathRequestId> requestIds; // Main thread only
+            std::shared_ptr<Path> path;            // Written by the worker before 'done'
+            std::atomic<bool> done{ false };
+        };
+
+        // Shared with the drain tasks, which may outlive the service at process exit.
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<Job>> jobs;
+        };
+
+        static void drain(const std::shared_ptr<WorkQueue>& work);
+
+        // Request side (any thread)
+        std::mutex requestMutex;
+        std::vector<Request> queued;
+        PathRequestId nextId = 1;
+        std::atomic<size_t> pending{ 0 };
+
+        // Main thread
+        std::shared_ptr<const NavGrid> grid;
+        std::vector<Request> dispatching; // Batch taken from 'queued' by dispatch()
+        std::shared_ptr<WorkQueue> work = std::make_shared<WorkQueue>();
+        std::vector<std::shared_ptr<Job>> running;
+        std::unordered_map<uint64_t, std::shared_ptr<Job>> runningByKey;
+        std::unordered_map<uint64_t, std::shared_ptr<const Path>> cache; // Paths found in the last poll()
+        std::vector<std::pair<PathRequestId, std::shared_ptr<const Path>>> ready; // Resolved, reported by the next poll()
+        std::shared_ptr<const Path> notFound = std::make_shared<Path>();
+        std::atomic<uint64_t> cacheHits{ 0 };
+
+        Counter* requestsTotal = nullptr;
+        Counter* searchesTotal = nullptr;
+        Counter* cacheHitsTotal = nullptr;
+    };
+
+    void NavigationService::Impl::drain(const std::shared_ptr<WorkQueue>& work)
+    {
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::lock_guard lock(work->mutex);
+                if (work->jobs.empty()) return;
+                job = std::move(work->jobs.front());
+                work->jobs.pop_front();
+            }
+            job->path->found = job->grid->find_path(job->startCell, job->goalCell, job->path->waypoints);
+            job->done.store(true, std::memory_order_release);
+        }
+    }
+
+    NavigationService::NavigationService()
+        : impl_(std::make_unique<Impl>())
+    {
+        MetricsRegistry& registry = MetricsRegistry::instance();
+        impl_->requestsTotal = &registry.counter("engine_nav_requests_total", "Path requests submitted");
+        impl_->searchesTotal = &registry.counter("engine_nav_searches_total", "A* searches run on the workers");
+        impl_->cacheHitsTotal = &registry.counter("engine_nav_cache_hits_total", "Path requests served by another request's search");
+    }
+
+    NavigationService::~NavigationService() = default;
+
+    NavigationService& NavigationService::instance()
+    {
+        static NavigationService service;
+        return service;
+    }
+
+    void NavigationService::set_grid(NavGrid grid)
+    {
+        impl_->grid = std::make_shared<const NavGrid>(std::move(grid));
+        impl_->cache.clear();
+        impl_->runningByKey.clear(); // Running searches still report, but new requests don't join them
+    }
+
+    bool NavigationService::has_grid() const
+    {
+        return impl_->grid != nullptr && impl_->grid->cell_count() > 0;
+    }
+
+    PathRequestId NavigationService::request(const Math::float3& start, const Math::float3& goal)
+    {
+        PathRequestId id;
+        {
+            std::lock_guard lock(impl_->requestMutex);
+            id = impl_->nextId++;
+            impl_->queued.push_back({ id, start, goal });
+        }
+        impl_->pending.fetch_add(1, std::memory_order_relaxed);
+        impl_->requestsTotal->add();
+        return id;
+    }
+
+    void NavigationService::dispatch()
+    {
+        Impl& impl = *impl_;
+        // Swapping the emptied batch back in keeps both vectors' capacity across frames
+        std::vector<Impl::Request>& requests = impl.dispatching;
+        requests.clear();
+        {
+            std::lock_guard lock(impl.requestMutex);
+            requests.swap(impl.queued);
+        }
+        if (requests.empty()) return;
+
+        const NavGrid* grid = has_grid() ? impl.grid.get() : nullptr;
+        size_t newJobs = 0;
+        uint64_t hits = 0;
+        for (const Impl::Request& request : requests) {
+            int startCell = grid != nullptr ? grid->cell_at(request.start) : -1;
+            int goalCell = grid != nullptr ? grid->cell_at(request.goal) : -1;
+            if (startCell < 0 || goalCell < 0) {
+                impl.ready.emplace_back(request.id, impl.notFound);
+                continue;
+            }
+
+            uint64_t key = path_key(startCell, goalCell);
+            if (auto cached = impl.cache.find(key); cached != impl.cache.end()) {
+                impl.ready.emplace_back(request.id, cached->second);
+                ++hits;
+                continue;
+            }
+            if (auto running = impl.runningByKey.find(key); running != impl.runningByKey.end()) {
+                running->second->requestIds.push_back(request.id);
+                ++hits;
+                continue;
+            }
+
+            auto job = std::make_shared<Impl::Job>();
+            job->grid = impl.grid;
+            job->startCell = startCell;
+            job->goalCell = goalCell;
+            job->requestIds.push_back(request.id);
+            job->path = std::make_shared<Impl::Path>();
+            impl.running.push_back(job);
+            impl.runningByKey.emplace(key, job);
+            {
+                std::lock_guard lock(impl.work->mutex);
+                impl.work->jobs.push_back(std::move(job));
+            }
+            ++newJobs;
+        }
+        if (hits > 0) {
+            impl.cacheHits.fetch_add(hits, std::memory_order_relaxed);
+            impl.cacheHitsTotal->add(static_cast<double>(hits));
+        }
+        if (newJobs == 0) return;
+        impl.searchesTotal->add(static_cast<double>(newJobs));
+
+        // Each drain task takes jobs until the queue is empty, so a few long searches
+        // don't hold up the short ones behind them
+        ThreadPool& pool = ThreadPool::instance();
+        size_t drains = std::min(newJobs, pool.worker_count());
+        for (size_t i = 0; i < drains; ++i) {
+            pool.submit([work = impl.work] { Impl::drain(work); });
+        }
+    }
+
+    size_t NavigationService::poll(std::vector<PathCompletion>& out, std::vector<Math::float3>& waypoints)
+    {
+        Impl& impl = *impl_;
+        waypoints.clear();
+        impl.cache.clear();
+
+        for (size_t i = 0; i < impl.running.size();) {
+            std::shared_ptr<Impl::Job>& job = impl.running[i];
+            if (!job->done.load(std::memory_order_acquire)) {
+                ++i;
+                continue;
+            }
+
+            uint64_t key = path_key(job->startCell, job->goalCell);
+            std::shared_ptr<const Impl::Path> path = job->path;
+            if (job->grid == impl.grid) {
+                impl.cache[key] = path;
+                auto running = impl.runningByKey.find(key);
+                if (running != impl.runningByKey.end() && running->second == job) impl.runningByKey.erase(running);
+            }
+            for (PathRequestId id : job->requestIds) impl.ready.emplace_back(id, path);
+
+            job = std::move(impl.running.back());
+            impl.running.pop_back();
+        }
+
+        size_t reported = impl.ready.size();
+        for (const auto& [id, path] : impl.ready) {
+            PathCompletion completion;
+            completion.id = id;
+            completion.status = path->found ? PathStatus::Found : PathStatus::NotFound;
+            completion.offset = static_cast<uint32_t>(waypoints.size());
+            completion.count = static_cast<uint32_t>(path->waypoints.size());
+            waypoints.insert(waypoints.end(), path->waypoints.begin(), path->waypoints.end());
+            out.push_back(completion);
+        }
+        impl.ready.clear();
+        impl.pending.fetch_sub(reported, std::memory_order_relaxed);
+        return reported;
+    }
+
+    size_t NavigationService::pending_count() const
+    {
+        return impl_->pending.load(std::memory_order_relaxed);
+    }
+
+    uint64_t NavigationService::cache_hits() const
+    {
+        return impl_->cacheHits.load(std::memory_order_relaxed);
+    }
+
+} // namespace Core
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "simd_math.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    // Walkable area as a uniform grid on the XZ plane. Each cell is one byte of traversal
+    // cost: 0 is blocked, 1 is open ground, higher values are slower terrain. Cells are
+    // stored row by row (x fastest), so cell = z * width + x.
+    class DLL_API NavGrid
+    {
+    public:
+        NavGrid() = default;
+        // All cells start open (cost 1). 'origin' is the corner of cell 0; waypoints use its y.
+        NavGrid(int width, int height, float cellSize, const Math::float3& origin);
+
+        // Loads a text map: one line per row of cells, '.' open, '#' blocked, '1'-'9' cost.
+        // Rows may differ in length; missing cells are blocked.
+        bool load(const std::string& path, float cellSize, const Math::float3& origin);
+
+        int width() const { return width_; }
+        int height() const { return height_; }
+        float cell_size() const { return cellSize_; }
+        const Math::float3& origin() const { return origin_; }
+        size_t cell_count() const { return costs_.size(); }
+
+        // Cell containing the point, -1 if outside the grid.
+        int cell_at(const Math::float3& position) const;
+        Math::float3 cell_center(int cell) const;
+
+        uint8_t cost(int x, int z) const { return costs_[static_cast<size_t>(z) * width_ + x]; }
+        void set_cost(int x, int z, uint8_t cost) { costs_[static_cast<size_t>(z) * width_ + x] = cost; }
+        // Every cell, for bulk edits.
+        std::span<uint8_t> costs() { return costs_; }
+        std::span<const uint8_t> costs() const { return costs_; }
+
+        // A* over the 8 neighbours of each cell; diagonal steps may not cut blocked corners.
+        // On success 'waypoints' holds the centres of the start cell, every cell where the
+        // path turns, and the goal cell. Thread-safe; search state is kept per thread.
+        bool find_path(int startCell, int goalCell, std::vector<Math::float3>& waypoints) const;
+
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        float cellSize_ = 1.0f;
+        Math::float3 origin_{ 0.0f, 0.0f, 0.0f };
+        std::vector<uint8_t> costs_;
+    };
+
+    // Mirrored by ScriptAPI::PathStatus
+    enum class PathStatus : int32_t
+    {
+        Pending = 0,
+        Found,
+        NotFound // Unreachable, outside the grid, or no grid is set
+    };
+
+    // 0 is never a valid request id.
+    using PathRequestId = uint64_t;
+
+    // Slice of the waypoints returned by poll() that belongs to one request.
+    struct PathCompletion
+    {
+        PathRequestId id;
+        PathStatus status;
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    // Pathfinding off the main thread.
+    // Requests queue up during the frame and are handed to the worker threads once per
+    // frame by dispatch(); finished paths are collected at the start of a later frame by
+    // poll(). Requests between the same start and goal cells share one search, whether
+    // they arrive in the same frame or while that search is still running, and paths found
+    // in the last poll() are served again from a per-frame cache without searching.
+    //
+    // request() is thread-safe; everything else belongs to the main thread. The header
+    // stays free of <mutex>/<thread> so the ScriptAPI can include it.
+    class DLL_API NavigationService
+    {
+    public:
+        NavigationService();
+        ~NavigationService();
+
+        NavigationService(const NavigationService&) = delete;
+        NavigationService& operator=(const NavigationService&) = delete;
+
+        // Process-wide service shared by the engine loop and the ScriptAPI.
+        static NavigationService& instance();
+
+        // Replaces the grid for requests dispatched from now on; searches already running
+        // finish on the old one. Clears the path cache.
+        void set_grid(NavGrid grid);
+        bool has_grid() const;
+
+        PathRequestId request(const Math::float3& start, const Math::float3& goal);
+
+        // Hands the requests queued since the last call to the workers. Call once per frame
+        // after the scripts ran.
+        void dispatch();
+        // Appends requests that finished since the last poll; each is reported once. Their
+        // waypoints are in 'waypoints' (replaced on every call) at the completion's offset.
+        size_t poll(std::vector<PathCompletion>& out, std::vector<Math::float3>& waypoints);
+
+        // Requests not yet reported by poll()
+        size_t pending_count() const;
+        uint64_t cache_hits() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+} // namespace Core
@@ -0,0 +1,435 @@
+#include "replication.h"
+#include "bit_stream.h"
+#include "transform_hierarchy.h"
+
+#include <algorithm> // std::max, std::equal
+#include <bit>       // std::bit_cast
+#include <iostream>  // For basic error output
+
+namespace Core
+{
+    namespace
+    {
+        constexpr int kOpBits = 2;
+        constexpr int kKindBits = 2;
+        constexpr uint32_t kHeaderBits = 64;
+        constexpr size_t kMaxVarbits = 37; // write_varbits() of a 31- or 32-bit value
+
+        uint32_t fnv1a(std::string_view text)
+        {
+            uint32_t hash = 2166136261u;
+            for (char c : text)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        void write_value(BitWriter& writer, ReplicatedFieldKind kind, uint32_t bits)
+        {
+            switch (kind)
+            {
+            case ReplicatedFieldKind::Bits: writer.write(bits, 32); break;
+            case ReplicatedFieldKind::Int: writer.write_signed(static_cast<int32_t>(bits)); break;
+            case ReplicatedFieldKind::Bool: writer.write_bool(bits != 0); break;
+            }
+        }
+
+        uint32_t read_value(BitReader& reader, ReplicatedFieldKind kind)
+        {
+            switch (kind)
+            {
+            case ReplicatedFieldKind::Bits: return reader.read(32);
+            case ReplicatedFieldKind::Int: return static_cast<uint32_t>(reader.read_signed());
+            case ReplicatedFieldKind::Bool: return reader.read_bool() ? 1u : 0u;
+            }
+            return 0;
+        }
+    }
+
+    // --- ReplicationServer ---
+
+    ReplicationServer& ReplicationServer::instance()
+    {
+        static ReplicationServer server;
+        return server;
+    }
+
+    int ReplicationServer::register_schema(std::string_view name, std::span<const ReplicatedFieldKind> fields)
+    {
+        if (fields.empty()) return -1;
+
+        // Largest possible spawn: header, 'more' bit, id delta, op, entity id, type hash,
+        // field count, kinds, every value at its widest, terminating bit
+        size_t spawnBits = kHeaderBits + 1 + kMaxVarbits + kOpBits + kMaxVarbits + 32 + kMaxVarbits + 1;
+        for (ReplicatedFieldKind kind : fields)
+        {
+            spawnBits += kKindBits;
+            spawnBits += kind == ReplicatedFieldKind::Bits ? 32 : kind == ReplicatedFieldKind::Int ? kMaxVarbits : 1;
+        }
+        if (spawnBits > kPacketBytes * 8)
+        {
+            std::cerr << "Error: Replication schema '" << name << "' has too many fields (" << fields.size()
+                      << ") for a spawn to fit in a " << kPacketBytes << "-byte packet" << std::endl;
+            return -1;
+        }
+
+        for (size_t i = 0; i < schemas_.size(); ++i)
+        {
+            const Schema& schema = schemas_[i];
+            if (schema.name == name && std::equal(schema.fields.begin(), schema.fields.end(), fields.begin(), fields.end()))
+            {
+                return static_cast<int>(i);
+            }
+        }
+
+        Schema& schema = schemas_.emplace_back();
+        schema.name = name;
+        schema.fields.assign(fields.begin(), fields.end());
+        schema.typeHash = fnv1a(name);
+        freeIds_.emplace_back();
+        return static_cast<int>(schemas_.size() - 1);
+    }
+
+    int ReplicationServer::add_object(int entityId, int schemaId)
+    {
+        if (schemaId < 0 || schemaId >= static_cast<int>(schemas_.size()))
+        {
+            std::cerr << "Error: Unknown replication schema " << schemaId << std::endl;
+            return -1;
+        }
+        const size_t fieldCount = schemas_[schemaId].fields.size();
+
+        uint32_t id;
+        std::vector<uint32_t>& freeIds = freeIds_[schemaId];
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<uint32_t>(schema_.size());
+            entity_.push_back(-1);
+            schema_.push_back(-1);
+            firstField_.push_back(static_cast<uint32_t>(values_.size()));
+            spawnTick_.push_back(0);
+            changeTick_.push_back(0);
+            destroyTick_.push_back(0);
+            values_.resize(values_.size() + fieldCount, 0);
+            fieldTick_.resize(fieldTick_.size() + fieldCount, 0);
+        }
+
+        entity_[id] = entityId;
+        schema_[id] = schemaId;
+        spawnTick_[id] = tick_;
+        changeTick_[id] = tick_;
+        destroyTick_[id] = 0;
+        std::fill_n(values_.begin() + firstField_[id], fieldCount, 0u);
+        std::fill_n(fieldTick_.begin() + firstField_[id], fieldCount, tick_);
+        ++liveObjects_;
+        return static_cast<int>(id);
+    }
+
+    bool ReplicationServer::remove_object(int objectId)
+    {
+        if (objectId < 0 || objectId >= static_cast<int>(schema_.size()) || schema_[objectId] < 0 || destroyTick_[objectId] != 0)
+        {
+            return false;
+        }
+        destroyTick_[objectId] = tick_;
+        changeTick_[objectId] = tick_;
+        removed_.push_back(static_cast<uint32_t>(objectId));
+        --liveObjects_;
+        return true;
+    }
+
+    int ReplicationServer::add_client()
+    {
+        size_t index = 0;
+        while (index < clients_.size() && clients_[index].active) ++index;
+        if (index == clients_.size()) clients_.emplace_back();
+
+        Client& client = clients_[index];
+        client.active = true;
+        client.ackTick.assign(schema_.size(), 0);
+        client.sentTick.assign(schema_.size(), 0);
+        for (SentPacket& packet : client.sent) packet.sequence = 0;
+        client.nextSequence = 1;
+        client.cursor = 0;
+        client.scanTick = 0;
+        client.scanRemaining = 0;
+        client.reportedOversized = false;
+        return static_cast<int>(index);
+    }
+
+    void ReplicationServer::remove_client(int clientId)
+    {
+        if (clientId >= 0 && clientId < static_cast<int>(clients_.size())) clients_[clientId].active = false;
+    }
+
+    bool ReplicationServer::pending(const Client& client, uint32_t objectId, Op& op) const
+    {
+        if (schema_[objectId] < 0 || client.sentTick[objectId] == tick_) return false;
+
+        const uint32_t ack = client.ackTick[objectId];
+        const bool known = ack >= spawnTick_[objectId];
+        if (destroyTick_[objectId] != 0)
+        {
+            // Only clients that may have seen the object need to hear it is gone
+            op = Op::Destroy;
+            return client.sentTick[objectId] >= spawnTick_[objectId] && ack < destroyTick_[objectId];
+        }
+        op = known ? Op::Update : Op::Spawn;
+        return !known || changeTick_[objectId] > ack;
+    }
+
+    void ReplicationServer::write_block(BitWriter& writer, const Client& client, uint32_t objectId, Op op) const
+    {
+        writer.write(static_cast<uint32_t>(op), kOpBits);
+        if (op == Op::Destroy) return;
+
+        const Schema& schema = schemas_[schema_[objectId]];
+        const uint32_t first = firstField_[objectId];
+        const size_t fieldCount = schema.fields.size();
+        if (op == Op::Spawn)
+        {
+            writer.write_signed(entity_[objectId]);
+            writer.write(schema.typeHash, 32);
+            writer.write_varbits(static_cast<uint32_t>(fieldCount));
+            for (ReplicatedFieldKind kind : schema.fields) writer.write(static_cast<uint32_t>(kind), kKindBits);
+            for (size_t i = 0; i < fieldCount; ++i) write_value(writer, schema.fields[i], values_[first + i]);
+            return;
+        }
+
+        const uint32_t ack = client.ackTick[objectId];
+        for (size_t i = 0; i < fieldCount; ++i) writer.write_bool(fieldTick_[first + i] > ack);
+        for (size_t i = 0; i < fieldCount; ++i)
+        {
+            if (fieldTick_[first + i] > ack) write_value(writer, schema.fields[i], values_[first + i]);
+        }
+    }
+
+    size_t ReplicationServer::write_packet(int clientId, std::span<uint8_t> out)
+    {
+        if (clientId < 0 || clientId >= static_cast<int>(clients_.size()) || !clients_[clientId].active) return 0;
+        Client& client = clients_[clientId];
+
+        const uint32_t objectCount = static_cast<uint32_t>(schema_.size());
+        if (client.ackTick.size() < objectCount)
+        {
+            client.ackTick.resize(objectCount, 0);
+            client.sentTick.resize(objectCount, 0);
+        }
+        if (client.scanTick != tick_)
+        {
+            client.scanTick = tick_;
+            client.scanRemaining = objectCount;
+        }
+        if (client.scanRemaining == 0 || out.size() * 8 < kHeaderBits + 1) return 0;
+
+        BitWriter writer(out);
+        const uint32_t sequence = client.nextSequence;
+        writer.write(sequence, 32);
+        writer.write(tick_, 32);
+
+        SentPacket& packet = client.sent[sequence % kSentHistory];
+        packet.objects.clear();
+        int previous = 0;
+        while (client.scanRemaining > 0)
+        {
+            if (client.cursor >= objectCount) client.cursor = 0;
+            const uint32_t objectId = client.cursor;
+
+            Op op;
+            if (pending(client, objectId, op))
+            {
+                const size_t mark = writer.position();
+                writer.write_bool(true);
+                writer.write_signed(static_cast<int>(objectId) - previous);
+                write_block(writer, client, objectId, op);
+                // The block only counts if the terminating bit still fits after it
+                const size_t end = writer.position();
+                writer.write_bool(false);
+                if (writer.overflowed())
+                {
+                    writer.rewind(mark);
+                    if (!packet.objects.empty()) break; // Continues with this object in the next packet
+
+                    // Too big for any packet this size; stopping here would stall the cursor on it
+                    if (!client.reportedOversized)
+                    {
+                        std::cerr << "Error: Replicated object " << objectId << " doesn't fit in a " << out.size()
+                                  << "-byte packet; skipped" << std::endl;
+                        client.reportedOversized = true;
+                    }
+                }
+                else
+                {
+                    writer.rewind(end);
+                    packet.objects.push_back(objectId);
+                    client.sentTick[objectId] = tick_;
+                    previous = static_cast<int>(objectId);
+                }
+            }
+            ++client.cursor;
+            --client.scanRemaining;
+        }
+
+        if (packet.objects.empty()) return 0;
+        writer.write_bool(false);
+        packet.sequence = sequence;
+        packet.tick = tick_;
+        ++client.nextSequence;
+        return writer.bytes();
+    }
+
+    void ReplicationServer::acknowledge(int clientId, uint32_t sequence)
+    {
+        if (clientId < 0 || clientId >= static_cast<int>(clients_.size()) || !clients_[clientId].active) return;
+        Client& client = clients_[clientId];
+
+        SentPacket& packet = client.sent[sequence % kSentHistory];
+        if (sequence == 0 || packet.sequence != sequence) return; // Duplicate, or too old to still be tracked
+        for (uint32_t objectId : packet.objects)
+        {
+            client.ackTick[objectId] = std::max(client.ackTick[objectId], packet.tick);
+        }
+        packet.sequence = 0;
+    }
+
+    bool ReplicationServer::done_with(const Client& client, uint32_t objectId) const
+    {
+        if (!client.active || objectId >= client.sentTick.size()) return true;
+        return client.sentTick[objectId] < spawnTick_[objectId] || client.ackTick[objectId] >= destroyTick_[objectId];
+    }
+
+    void ReplicationServer::end_tick()
+    {
+        // Ids freed here are reused from the next tick on, so every packet that mentions
+        // the old object has an older tick than the new object's spawn.
+        auto freed = std::remove_if(removed_.begin(), removed_.end(), [this](uint32_t objectId) {
+            for (const Client& client : clients_)
+            {
+                if (!done_with(client, objectId)) return false;
+            }
+            freeIds_[schema_[objectId]].push_back(objectId);
+            schema_[objectId] = -1;
+            return true;
+        });
+        removed_.erase(freed, removed_.end());
+        ++tick_;
+    }
+
+    // --- ReplicationClient ---
+
+    bool ReplicationClient::contains(int objectId) const
+    {
+        return objectId >= 0 && objectId < static_cast<int>(objects_.size()) && objects_[objectId].alive;
+    }
+
+    bool ReplicationClient::read_packet(std::span<const uint8_t> packet, uint32_t& sequence)
+    {
+        BitReader reader(packet);
+        sequence = reader.read(32);
+        const uint32_t tick = reader.read(32);
+        if (reader.failed() || tick < latestTick_) return false;
+        latestTick_ = tick;
+
+        int previous = 0;
+        while (reader.read_bool())
+        {
+            const int objectId = previous + reader.read_signed();
+            const uint32_t op = reader.read(kOpBits);
+            if (reader.failed() || objectId < 0) return false;
+            previous = objectId;
+            if (objectId >= static_cast<int>(objects_.size())) objects_.resize(static_cast<size_t>(objectId) + 1);
+            Object& object = objects_[objectId];
+
+            if (op == 1) // Spawn
+            {
+                object.entityId = reader.read_signed();
+                object.typeHash = reader.read(32);
+                const uint32_t fieldCount = reader.read_varbits();
+                if (fieldCount > reader.bits_remaining() / kKindBits) return false;
+                object.kinds.resize(fieldCount);
+                object.values.resize(fieldCount);
+                for (auto& kind : object.kinds) kind = static_cast<ReplicatedFieldKind>(reader.read(kKindBits));
+                for (uint32_t i = 0; i < fieldCount; ++i) object.values[i] = read_value(reader, object.kinds[i]);
+                if (!object.alive) ++liveObjects_;
+                object.alive = true;
+            }
+            else if (op == 0) // Update
+            {
+                if (!object.alive) return false; // Updates only follow an acknowledged spawn
+                // Sized from the spawn, so any field count the server accepts can be updated
+                const size_t fieldCount = object.kinds.size();
+                changed_.resize(fieldCount);
+                for (size_t i = 0; i < fieldCount; ++i) changed_[i] = reader.read_bool() ? 1 : 0;
+                for (size_t i = 0; i < fieldCount; ++i)
+                {
+                    if (changed_[i]) object.values[i] = read_value(reader, object.kinds[i]);
+                }
+            }
+            else if (op == 2) // Destroy
+            {
+                if (object.alive) --liveObjects_;
+                object.alive = false;
+            }
+            else
+            {
+                return false;
+            }
+            if (reader.failed()) return false;
+        }
+        return !reader.failed();
+    }
+
+    // --- ReplicatedTransforms ---
+
+    ReplicatedTransforms::ReplicatedTransforms(ReplicationServer& server)
+        : server_(server)
+    {
+        const ReplicatedFieldKind fields[7] = {
+            ReplicatedFieldKind::Bits, ReplicatedFieldKind::Bits, ReplicatedFieldKind::Bits,                             // position
+            ReplicatedFieldKind::Bits, ReplicatedFieldKind::Bits, ReplicatedFieldKind::Bits, ReplicatedFieldKind::Bits // rotation
+        };
+        schemaId_ = server_.register_schema("Core.Transform", fields);
+    }
+
+    void ReplicatedTransforms::sync(const TransformHierarchy& transforms)
+    {
+        Math::float3 position, scale;
+        Math::quat rotation;
+        for (int entityId : transforms.changed_entities())
+        {
+            auto [it, inserted] = objectOf_.try_emplace(entityId, -1);
+            if (inserted) it->second = server_.add_object(entityId, schemaId_);
+            if (it->second < 0 || !transforms.get_local(entityId, position, rotation, scale)) continue;
+
+            const int objectId = it->second;
+            server_.write(objectId, 0, std::bit_cast<uint32_t>(position.x));
+            server_.write(objectId, 1, std::bit_cast<uint32_t>(position.y));
+            server_.write(objectId, 2, std::bit_cast<uint32_t>(position.z));
+            server_.write(objectId, 3, std::bit_cast<uint32_t>(rotation.x));
+            server_.write(objectId, 4, std::bit_cast<uint32_t>(rotation.y));
+            server_.write(objectId, 5, std::bit_cast<uint32_t>(rotation.z));
+            server_.write(objectId, 6, std::bit_cast<uint32_t>(rotation.w));
+        }
+
+        // Removed entities never show up as changed, so look for them directly
+        if (objectOf_.size() == transforms.size()) return;
+        gone_.clear();
+        for (const auto& [entityId, objectId] : objectOf_)
+        {
+            if (!transforms.contains(entityId)) gone_.push_back(entityId);
+        }
+        for (int entityId : gone_)
+        {
+            server_.remove_object(objectOf_[entityId]);
+            objectOf_.erase(entityId);
+        }
+    }
+
+} // namespace Core
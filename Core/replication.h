@@ -0,0 +1,202 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Server-to-client replication of entity and script state.
+//
+// Replicated objects are flat lists of 32-bit fields described by a schema. The server
+// stamps every field with the tick it last changed; each client has a baseline per
+// object (the newest tick it has acknowledged for it), and packets carry only the fields
+// changed since that baseline. Anything unacknowledged is resent on later ticks, so lost
+// or reordered datagrams cost latency, never correctness.
+//
+// Packet layout (bit-packed, LSB first; see bit_stream.h):
+//   uint32 sequence, uint32 tick
+//   { 1 bit 'more' = 1, object block }*, 1 bit 'more' = 0
+// Object block:
+//   signed objectId delta from the previous block, 2-bit op
+//   Spawn:   signed entityId, uint32 type hash, varbits field count, 2-bit kind per field,
+//            every field value
+//   Update:  1 bit per field (changed), then the changed field values
+//   Destroy: nothing more
+
+namespace Core
+{
+    class BitWriter;
+    class TransformHierarchy;
+
+    enum class ReplicatedFieldKind : uint8_t
+    {
+        Bits = 0, // Any 32-bit value sent verbatim (floats, packed flags)
+        Int = 1,  // Signed integer; small magnitudes take few bits
+        Bool = 2
+    };
+
+    class DLL_API ReplicationServer
+    {
+    public:
+        ReplicationServer() = default;
+
+        // Process-wide server shared by the engine loop and the ScriptAPI.
+        static ReplicationServer& instance();
+
+        // Datagram payload hosts pass to write_packet(); stays under a typical MTU.
+        static constexpr size_t kPacketBytes = 1200;
+
+        // --- Schemas ---
+        // Registering the same name with the same fields again returns the existing id, so
+        // script reloads don't grow the table. -1 if the schema has no fields, or so many
+        // that a spawn of it might not fit in a kPacketBytes packet.
+        int register_schema(std::string_view name, std::span<const ReplicatedFieldKind> fields);
+
+        // --- Objects ---
+        // Returns the object id, which is also the id clients see.
+        int add_object(int entityId, int schemaId);
+        // Clients are told on their next packets; the id is reused once all of them have
+        // acknowledged the removal.
+        bool remove_object(int objectId);
+        // Stamps the field with the current tick if 'bits' differs from its value.
+        void write(int objectId, int field, uint32_t bits)
+        {
+            uint32_t index = firstField_[objectId] + static_cast<uint32_t>(field);
+            if (values_[index] == bits) return;
+            values_[index] = bits;
+            fieldTick_[index] = tick_;
+            changeTick_[objectId] = tick_;
+        }
+        size_t object_count() const { return liveObjects_; }
+
+        // --- Clients ---
+        int add_client();
+        void remove_client(int clientId);
+        // Encodes objects the client has unacknowledged changes for into 'out' (a datagram
+        // payload). Call repeatedly within a tick to spread a large backlog over several
+        // packets; returns 0 once every object has been visited this tick. An object that
+        // doesn't fit even an empty packet (only possible below kPacketBytes) is skipped.
+        size_t write_packet(int clientId, std::span<uint8_t> out);
+        void acknowledge(int clientId, uint32_t sequence);
+
+        // Writes after this belong to the next tick. Also frees the ids of removed objects
+        // that every client is done with.
+        void end_tick();
+        uint32_t tick() const { return tick_; }
+
+    private:
+        enum class Op : uint32_t { Update = 0, Spawn = 1, Destroy = 2 };
+
+        struct Schema
+        {
+            std::string name;
+            std::vector<ReplicatedFieldKind> fields;
+            uint32_t typeHash = 0; // FNV-1a of the name, sent with spawns
+        };
+
+        // Object lists of sent packets, kept until acknowledged or overwritten. Acks for
+        // packets more than this many sequences old are ignored (their objects get resent).
+        static constexpr size_t kSentHistory = 1024;
+        struct SentPacket
+        {
+            uint32_t sequence = 0;
+            uint32_t tick = 0;
+            std::vector<uint32_t> objects;
+        };
+
+        struct Client
+        {
+            bool active = false;
+            // Per object: every change at or before this tick has arrived
+            std::vector<uint32_t> ackTick;
+            // Per object: last tick the object was put in a packet
+            std::vector<uint32_t> sentTick;
+            std::array<SentPacket, kSentHistory> sent;
+            uint32_t nextSequence = 1;
+            uint32_t cursor = 0; // Round-robin position so full packets don't starve high ids
+            uint32_t scanTick = 0;
+            uint32_t scanRemaining = 0;
+            bool reportedOversized = false;
+        };
+
+        bool pending(const Client& client, uint32_t objectId, Op& op) const;
+        void write_block(BitWriter& writer, const Client& client, uint32_t objectId, Op op) const;
+        bool done_with(const Client& client, uint32_t objectId) const;
+
+        std::vector<Schema> schemas_;
+
+        // Per object, indexed by object id
+        std::vector<int> entity_;
+        std::vector<int> schema_; // -1 for free ids
+        std::vector<uint32_t> firstField_;
+        std::vector<uint32_t> spawnTick_;
+        std::vector<uint32_t> changeTick_; // Latest change to any field, or the removal
+        std::vector<uint32_t> destroyTick_; // 0 while alive
+
+        // Per field, indexed by firstField_[object] + field
+        std::vector<uint32_t> values_;
+        std::vector<uint32_t> fieldTick_;
+
+        std::vector<std::vector<uint32_t>> freeIds_; // Per schema, so field storage is reused
+        std::vector<uint32_t> removed_;              // Removed, not yet freed
+        std::vector<Client> clients_;
+        size_t liveObjects_ = 0;
+        uint32_t tick_ = 1; // Tick 0 means "nothing acknowledged"
+    };
+
+    // Applies packets from a ReplicationServer to a local mirror of its objects.
+    class DLL_API ReplicationClient
+    {
+    public:
+        // Applies the packet and returns true if it should be acknowledged with 'sequence'.
+        // Packets from older ticks than one already applied are dropped unacknowledged
+        // (the server resends their content); malformed packets also return false.
+        bool read_packet(std::span<const uint8_t> packet, uint32_t& sequence);
+
+        bool contains(int objectId) const;
+        int entity_id(int objectId) const { return objects_[objectId].entityId; }
+        uint32_t type_hash(int objectId) const { return objects_[objectId].typeHash; }
+        int field_count(int objectId) const { return static_cast<int>(objects_[objectId].values.size()); }
+        uint32_t field(int objectId, int field) const { return objects_[objectId].values[field]; }
+        size_t object_count() const { return liveObjects_; }
+        uint32_t latest_tick() const { return latestTick_; }
+
+    private:
+        struct Object
+        {
+            bool alive = false;
+            int entityId = -1;
+            uint32_t typeHash = 0;
+            std::vector<ReplicatedFieldKind> kinds;
+            std::vector<uint32_t> values;
+        };
+
+        std::vector<Object> objects_;
+        std::vector<uint8_t> changed_; // Per-field flags of the update being read
+        size_t liveObjects_ = 0;
+        uint32_t latestTick_ = 0;
+    };
+
+    // Replicates the local position and rotation of every entity in a transform
+    // hierarchy (schema "Core.Transform": 3 + 4 floats).
+    class DLL_API ReplicatedTransforms
+    {
+    public:
+        explicit ReplicatedTransforms(ReplicationServer& server);
+
+        // Adds objects for new entities, writes the moved ones and removes the objects of
+        // entities that are gone. Call after TransformHierarchy::update().
+        void sync(const TransformHierarchy& transforms);
+
+    private:
+        ReplicationServer& server_;
+        int schemaId_;
+        std::unordered_map<int, int> objectOf_;
+        std::vector<int> gone_;
+    };
+
+} // namespace Core
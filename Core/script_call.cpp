@@ -0,0 +1,72 @@
+#include "script_call.h"
+
+#include <ostream>
+
+namespace Core
+{
+    const char* to_string(ScriptStatus status)
+    {
+        switch (status)
+        {
+        case ScriptStatus::Ok: return "Ok";
+        case ScriptStatus::Failed: return "Failed";
+        case ScriptStatus::ScriptException: return "ScriptException";
+        case ScriptStatus::InternalError: return "InternalError";
+        }
+        return "Unknown";
+    }
+
+    const char* to_string(ScriptPhase phase)
+    {
+        switch (phase)
+        {
+        case ScriptPhase::PreUpdate: return "PreUpdate";
+        case ScriptPhase::Update: return "Update";
+        case ScriptPhase::LateUpdate: return "LateUpdate";
+        case ScriptPhase::PostPhysics: return "PostPhysics";
+        }
+        return "Unknown";
+    }
+
+    void ScriptErrorSummary::record_failure(const char* call, const ScriptCallResult& result)
+    {
+        const ScriptErrorInfo& error = result.error;
+        size_t errors = error.exceptionCount > 0 ? static_cast<size_t>(error.exceptionCount) : 1;
+        frameErrors_ += errors;
+        totalErrors_ += errors;
+        ++frameFailedCalls_;
+
+        std::string where = std::string(call) + " [" + to_string(result.status) + "]";
+        if (error.scriptType[0] != '\0')
+        {
+            where += " ";
+            where += error.scriptType;
+            if (error.entityId >= 0) where += " on entity " + std::to_string(error.entityId);
+        }
+        if (frameFirst_.empty()) frameFirst_ = where;
+
+        if (reported_.insert(where.substr(0, where.find(" on entity"))).second)
+        {
+            frameDetails_ += "  " + where + ": " + (error.message[0] != '\0' ? error.message : "(no details)") + "\n";
+        }
+    }
+
+    size_t ScriptErrorSummary::end_frame(uint64_t frameIndex, std::ostream& out)
+    {
+        size_t errors = frameErrors_;
+        if (errors > 0)
+        {
+            out << "[Scripts] Frame " << frameIndex << ": " << errors << " error(s) in "
+                << frameFailedCalls_ << " call(s), first: " << frameFirst_ << "\n"
+                << frameDetails_;
+            out.flush();
+        }
+
+        frameErrors_ = 0;
+        frameFailedCalls_ = 0;
+        frameFirst_.clear();
+        frameDetails_.clear();
+        return errors;
+    }
+
+} // namespace Core
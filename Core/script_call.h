@@ -0,0 +1,104 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+// Exception boundary between the engine and the ScriptAPI.
+// Managed entry points never let an exception escape: they catch it, describe it in a
+// ScriptErrorInfo supplied by the caller and return a ScriptStatus. Native code checks the
+// status like any other return value, so the fast path costs one compare and no
+// exception frames.
+
+namespace Core
+{
+    enum class ScriptStatus : int32_t
+    {
+        Ok = 0,
+        Failed = 1,          // The call refused or could not do its job (see message)
+        ScriptException = 2, // One or more scripts threw; the call itself completed
+        InternalError = 3    // The ScriptAPI itself threw; state may be inconsistent
+    };
+
+    // Frame phases, in execution order. Values match ScriptAPI::ScriptPhase.
+    enum class ScriptPhase : int32_t
+    {
+        PreUpdate = 0,
+        Update = 1,
+        LateUpdate = 2,
+        PostPhysics = 3 // After native transform/spatial update
+    };
+
+    // Filled by the managed side. Only the first error of a call is described in detail;
+    // later ones are counted.
+    struct ScriptErrorInfo
+    {
+        ScriptErrorInfo() { scriptType[0] = '\0'; message[0] = '\0'; }
+
+        int32_t entityId = -1;      // -1 if not tied to an entity
+        int32_t exceptionCount = 0; // Script exceptions caught during the call
+        char scriptType[128];
+        char message[1024];         // Exception text including the managed stack trace
+    };
+
+    struct ScriptCallResult
+    {
+        ScriptStatus status = ScriptStatus::Ok;
+        ScriptErrorInfo error;
+
+        bool ok() const { return status == ScriptStatus::Ok; }
+        explicit operator bool() const { return ok(); }
+    };
+
+    // Calls a managed entry point of the form 'int32_t fn(args..., ScriptErrorInfo*)'.
+    template <typename... Params, typename... Args>
+    ScriptCallResult call_script(int32_t (*fn)(Params...), Args&&... args)
+    {
+        ScriptCallResult result;
+        if (!fn)
+        {
+            result.status = ScriptStatus::Failed;
+            std::strcpy(result.error.message, "Managed entry point not bound");
+            return result;
+        }
+        result.status = static_cast<ScriptStatus>(fn(std::forward<Args>(args)..., &result.error));
+        return result;
+    }
+
+    DLL_API const char* to_string(ScriptStatus status);
+    DLL_API const char* to_string(ScriptPhase phase);
+
+    // Collects failed calls during a frame and reports them once at the end of it.
+    // Full details (message and stack trace) are printed the first time a given
+    // call/script-type pair fails; after that only the per-frame counts are.
+    class DLL_API ScriptErrorSummary
+    {
+    public:
+        void record(const char* call, const ScriptCallResult& result)
+        {
+            if (result.ok()) return;
+            record_failure(call, result);
+        }
+
+        // Prints the summary for the frame if anything failed, then resets the frame
+        // counters. Returns the number of errors recorded during the frame.
+        size_t end_frame(uint64_t frameIndex, std::ostream& out);
+
+        uint64_t total_errors() const { return totalErrors_; }
+
+    private:
+        void record_failure(const char* call, const ScriptCallResult& result);
+
+        size_t frameErrors_ = 0;
+        size_t frameFailedCalls_ = 0;
+        std::string frameFirst_;
+        std::string frameDetails_;
+        uint64_t totalErrors_ = 0;
+        std::unordered_set<std::string> reported_;
+    };
+
+} // namespace Core
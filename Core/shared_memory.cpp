@@ -0,0 +1,150 @@
+#include "shared_memory.h"
+
+#include <iostream> // For basic error output
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <cstring> // std::strerror
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Core
+{
+    SharedMemory::~SharedMemory()
+    {
+        close();
+    }
+
+#if defined(_WIN32)
+
+    bool SharedMemory::create(const std::string& name, size_t size)
+    {
+        close();
+        std::string fullName = "Local\\" + name;
+        HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                            static_cast<DWORD>(size & 0xFFFFFFFFu), fullName.c_str());
+        if (!mapping)
+        {
+            std::cerr << "Error: CreateFileMapping failed for shared memory '" << name << "'. Error code: " << GetLastError() << std::endl;
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view)
+        {
+            std::cerr << "Error: MapViewOfFile failed for shared memory '" << name << "'. Error code: " << GetLastError() << std::endl;
+            CloseHandle(mapping);
+            return false;
+        }
+        mapping_ = mapping;
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        name_ = name;
+        owner_ = true;
+        return true;
+    }
+
+    bool SharedMemory::open_read_only(const std::string& name)
+    {
+        close();
+        std::string fullName = "Local\\" + name;
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, fullName.c_str());
+        if (!mapping) return false; // Not published (yet)
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info{};
+        if (!view || VirtualQuery(view, &info, sizeof(info)) == 0)
+        {
+            std::cerr << "Error: Failed to map shared memory '" << name << "'. Error code: " << GetLastError() << std::endl;
+            if (view) UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            return false;
+        }
+        mapping_ = mapping;
+        data_ = static_cast<uint8_t*>(view);
+        size_ = info.RegionSize; // Rounded up to whole pages
+        name_ = name;
+        owner_ = false;
+        return true;
+    }
+
+    void SharedMemory::close()
+    {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+        data_ = nullptr;
+        mapping_ = nullptr;
+        size_ = 0;
+        owner_ = false;
+    }
+
+#else
+
+    bool SharedMemory::create(const std::string& name, size_t size)
+    {
+        close();
+        std::string fullName = "/" + name;
+        int fd = shm_open(fullName.c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            std::cerr << "Error: Failed to create shared memory '" << name << "': " << std::strerror(errno) << std::endl;
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps the object alive
+        if (view == MAP_FAILED)
+        {
+            std::cerr << "Error: Failed to map shared memory '" << name << "': " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        name_ = name;
+        owner_ = true;
+        return true;
+    }
+
+    bool SharedMemory::open_read_only(const std::string& name)
+    {
+        close();
+        std::string fullName = "/" + name;
+        int fd = shm_open(fullName.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false; // Not published (yet)
+
+        struct stat info{};
+        void* view = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (view == MAP_FAILED) return false;
+
+        data_ = static_cast<uint8_t*>(view);
+        size_ = static_cast<size_t>(info.st_size);
+        name_ = name;
+        owner_ = false;
+        return true;
+    }
+
+    void SharedMemory::close()
+    {
+        if (data_) munmap(data_, size_);
+        if (owner_) shm_unlink(("/" + name_).c_str());
+        data_ = nullptr;
+        size_ = 0;
+        owner_ = false;
+    }
+
+#endif
+
+} // namespace Core
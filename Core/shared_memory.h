@@ -0,0 +1,41 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Core
+{
+    // Named memory region shared between processes: a pagefile-backed file mapping on
+    // Windows ("Local\<name>"), a POSIX shared memory object ("/<name>") elsewhere.
+    class DLL_API SharedMemory
+    {
+    public:
+        SharedMemory() = default;
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        // Creates the region, or opens it if it already exists with at least 'size' bytes.
+        bool create(const std::string& name, size_t size);
+        // Opens an existing region read-only, mapping all of it.
+        bool open_read_only(const std::string& name);
+        void close();
+
+        bool is_open() const { return data_ != nullptr; }
+        uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        std::string name_;
+        bool owner_ = false; // Created the region; unlinks it on close (POSIX)
+#if defined(_WIN32)
+        void* mapping_ = nullptr; // HANDLE
+#endif
+    };
+
+} // namespace Core
@@ -0,0 +1,61 @@
+#include "shutdown_signal.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib> // std::_Exit
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace Core
+{
+    namespace
+    {
+        std::atomic<bool> g_requested{ false };
+        static_assert(std::atomic<bool>::is_always_lock_free, "Signal handlers need a lock-free flag");
+
+        void on_signal(int)
+        {
+            if (g_requested.exchange(true)) std::_Exit(EXIT_FAILURE); // Second signal: give up waiting
+        }
+
+#ifdef _WIN32
+        BOOL WINAPI on_console_event(DWORD event)
+        {
+            switch (event)
+            {
+            case CTRL_C_EVENT:
+            case CTRL_BREAK_EVENT:
+            case CTRL_CLOSE_EVENT:
+            case CTRL_SHUTDOWN_EVENT:
+                on_signal(0);
+                return TRUE;
+            default:
+                return FALSE;
+            }
+        }
+#endif
+    }
+
+    void ShutdownSignal::install()
+    {
+#ifdef _WIN32
+        SetConsoleCtrlHandler(on_console_event, TRUE);
+#endif
+        std::signal(SIGINT, on_signal);
+        std::signal(SIGTERM, on_signal);
+    }
+
+    void ShutdownSignal::request()
+    {
+        g_requested = true;
+    }
+
+    bool ShutdownSignal::requested()
+    {
+        return g_requested.load(std::memory_order_relaxed);
+    }
+
+} // namespace Core
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+
+namespace Core
+{
+    // Process-wide graceful shutdown flag. install() routes SIGINT/SIGTERM (and on
+    // Windows, console Ctrl+C/Ctrl+Break/close events) to request(); the frame loop polls
+    // requested() and exits at the end of the current frame. A second signal while a
+    // shutdown is already pending terminates the process immediately.
+    class DLL_API ShutdownSignal
+    {
+    public:
+        static void install();
+        static void request();
+        static bool requested();
+    };
+
+} // namespace Core
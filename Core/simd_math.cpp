@@ -0,0 +1,273 @@
+#include "simd_math.h"
+
+#include <algorithm> // std::min, std::max
+#include <limits>
+
+namespace Core::Math
+{
+    namespace
+    {
+        // Directions shorter than this have no meaningful heading and give identity.
+        constexpr float kMinLookLengthSq = 1e-12f;
+
+        // Minimal lane abstraction so every kernel is written once and compiled for the
+        // widest instruction set available.
+#if defined(CORE_SIMD_AVX)
+        using vfloat = __m256;
+        constexpr size_t kLanes = 8;
+        inline vfloat vload(const float* p) { return _mm256_loadu_ps(p); }
+        inline void vstore(float* p, vfloat v) { _mm256_storeu_ps(p, v); }
+        inline vfloat vset1(float s) { return _mm256_set1_ps(s); }
+        inline vfloat vadd(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+        inline vfloat vsub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+        inline vfloat vmul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+        inline vfloat vdiv(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+        inline vfloat vsqrt(vfloat a) { return _mm256_sqrt_ps(a); }
+        inline vfloat vmin(vfloat a, vfloat b) { return _mm256_min_ps(a, b); }
+        inline vfloat vmax(vfloat a, vfloat b) { return _mm256_max_ps(a, b); }
+        inline vfloat vless(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        inline vfloat vselect(vfloat mask, vfloat a, vfloat b) { return _mm256_blendv_ps(b, a, mask); }
+        inline vfloat vcopysign(vfloat mag, vfloat sign)
+        {
+            const vfloat signBit = _mm256_set1_ps(-0.0f);
+            return _mm256_or_ps(_mm256_andnot_ps(signBit, mag), _mm256_and_ps(signBit, sign));
+        }
+        inline float vhmin(vfloat v)
+        {
+            alignas(32) float t[8]; _mm256_store_ps(t, v);
+            return *std::min_element(t, t + 8);
+        }
+        inline float vhmax(vfloat v)
+        {
+            alignas(32) float t[8]; _mm256_store_ps(t, v);
+            return *std::max_element(t, t + 8);
+        }
+#elif defined(CORE_SIMD_SSE)
+        using vfloat = __m128;
+        constexpr size_t kLanes = 4;
+        inline vfloat vload(const float* p) { return _mm_loadu_ps(p); }
+        inline void vstore(float* p, vfloat v) { _mm_storeu_ps(p, v); }
+        inline vfloat vset1(float s) { return _mm_set1_ps(s); }
+        inline vfloat vadd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+        inline vfloat vsub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+        inline vfloat vmul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+        inline vfloat vdiv(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+        inline vfloat vsqrt(vfloat a) { return _mm_sqrt_ps(a); }
+        inline vfloat vmin(vfloat a, vfloat b) { return _mm_min_ps(a, b); }
+        inline vfloat vmax(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+        inline vfloat vless(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+        inline vfloat vselect(vfloat mask, vfloat a, vfloat b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        inline vfloat vcopysign(vfloat mag, vfloat sign)
+        {
+            const vfloat signBit = _mm_set1_ps(-0.0f);
+            return _mm_or_ps(_mm_andnot_ps(signBit, mag), _mm_and_ps(signBit, sign));
+        }
+        inline float vhmin(vfloat v)
+        {
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+        inline float vhmax(vfloat v)
+        {
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(v);
+        }
+#else
+        using vfloat = float;
+        constexpr size_t kLanes = 1;
+        inline vfloat vload(const float* p) { return *p; }
+        inline void vstore(float* p, vfloat v) { *p = v; }
+        inline vfloat vset1(float s) { return s; }
+        inline vfloat vadd(vfloat a, vfloat b) { return a + b; }
+        inline vfloat vsub(vfloat a, vfloat b) { return a - b; }
+        inline vfloat vmul(vfloat a, vfloat b) { return a * b; }
+        inline vfloat vdiv(vfloat a, vfloat b) { return a / b; }
+        inline vfloat vsqrt(vfloat a) { return std::sqrt(a); }
+        inline vfloat vmin(vfloat a, vfloat b) { return std::min(a, b); }
+        inline vfloat vmax(vfloat a, vfloat b) { return std::max(a, b); }
+        inline bool vless(vfloat a, vfloat b) { return a < b; }
+        inline vfloat vselect(bool mask, vfloat a, vfloat b) { return mask ? a : b; }
+        inline vfloat vcopysign(vfloat mag, vfloat sign) { return std::copysign(mag, sign); }
+        inline float vhmin(vfloat v) { return v; }
+        inline float vhmax(vfloat v) { return v; }
+#endif
+
+        // Scalar helpers used for the tail of every kernel
+        inline void integrate_one(Float3SoA p, Float3SoA v, QuatSoA r, Float3SoA w, float dt, size_t i)
+        {
+            p.x[i] += v.x[i] * dt;
+            p.y[i] += v.y[i] * dt;
+            p.z[i] += v.z[i] * dt;
+            if (!r.x || !w.x) return;
+
+            float h = 0.5f * dt;
+            float ax = w.x[i], ay = w.y[i], az = w.z[i];
+            float qx = r.x[i], qy = r.y[i], qz = r.z[i], qw = r.w[i];
+            quat q = normalize(quat{
+                qx + h * (ax * qw + ay * qz - az * qy),
+                qy + h * (-ax * qz + ay * qw + az * qx),
+                qz + h * (ax * qy - ay * qx + az * qw),
+                qw + h * (-ax * qx - ay * qy - az * qz) });
+            r.x[i] = q.x; r.y[i] = q.y; r.z[i] = q.z; r.w[i] = q.w;
+        }
+
+        inline void look_at_one(Float3SoA from, Float3SoA to, QuatSoA out, size_t i)
+        {
+            quat q = look_rotation({ to.x[i] - from.x[i], to.y[i] - from.y[i], to.z[i] - from.z[i] });
+            out.x[i] = q.x; out.y[i] = q.y; out.z[i] = q.z; out.w[i] = q.w;
+        }
+    } // anonymous namespace
+
+    quat look_rotation(float3 forward)
+    {
+        // Yaw around Y followed by pitch around X, built from half-angle identities so the
+        // same formula vectorizes in look_at() without any trigonometry. The operations
+        // mirror the vector path (reciprocal multiplies, 0 - x for negation) so single and
+        // batch results agree bit for bit, signed zeros included.
+        float lengthSq = dot(forward, forward);
+        if (lengthSq < kMinLookLengthSq) return { 0.0f, 0.0f, 0.0f, 1.0f };
+        float invLen = 1.0f / std::max(std::sqrt(lengthSq), 1e-6f);
+        float3 d = forward * invLen;
+
+        float horizontal = std::sqrt(d.x * d.x + d.z * d.z);
+        float hx = 0.0f, hz = 1.0f;
+        if (!(horizontal < 1e-6f))
+        {
+            float invH = 1.0f / std::max(horizontal, 1e-6f);
+            hx = d.x * invH;
+            hz = d.z * invH;
+        }
+
+        float cy = std::sqrt(std::max(0.0f, (1.0f + hz) * 0.5f));
+        float sy = std::copysign(std::sqrt(std::max(0.0f, (1.0f - hz) * 0.5f)), hx);
+        float cp = std::sqrt(std::max(0.0f, (1.0f + horizontal) * 0.5f));
+        float sp = std::copysign(std::sqrt(std::max(0.0f, (1.0f - horizontal) * 0.5f)), 0.0f - d.y);
+
+        return { cy * sp, sy * cp, 0.0f - sy * sp, cy * cp };
+    }
+
+    void integrate_transforms(
+        Float3SoA positions, Float3SoA linearVelocity,
+        QuatSoA rotations, Float3SoA angularVelocity,
+        float dt, size_t count)
+    {
+        const bool rotate = rotations.x && angularVelocity.x;
+        const vfloat vdt = vset1(dt);
+        const vfloat half = vset1(0.5f * dt);
+        const vfloat zero = vset1(0.0f), one = vset1(1.0f);
+        const vfloat minLength = vset1(std::numeric_limits<float>::denorm_min());
+
+        size_t i = 0;
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            vstore(positions.x + i, vadd(vload(positions.x + i), vmul(vload(linearVelocity.x + i), vdt)));
+            vstore(positions.y + i, vadd(vload(positions.y + i), vmul(vload(linearVelocity.y + i), vdt)));
+            vstore(positions.z + i, vadd(vload(positions.z + i), vmul(vload(linearVelocity.z + i), vdt)));
+            if (!rotate) continue;
+
+            vfloat ax = vload(angularVelocity.x + i), ay = vload(angularVelocity.y + i), az = vload(angularVelocity.z + i);
+            vfloat qx = vload(rotations.x + i), qy = vload(rotations.y + i), qz = vload(rotations.z + i), qw = vload(rotations.w + i);
+
+            vfloat nx = vadd(qx, vmul(half, vsub(vadd(vmul(ax, qw), vmul(ay, qz)), vmul(az, qy))));
+            vfloat ny = vadd(qy, vmul(half, vadd(vsub(vmul(ay, qw), vmul(ax, qz)), vmul(az, qx))));
+            vfloat nz = vadd(qz, vmul(half, vadd(vsub(vmul(ax, qy), vmul(ay, qx)), vmul(az, qw))));
+            vfloat nw = vsub(qw, vmul(half, vadd(vadd(vmul(ax, qx), vmul(ay, qy)), vmul(az, qz))));
+
+            vfloat len = vsqrt(vadd(vadd(vmul(nx, nx), vmul(ny, ny)), vadd(vmul(nz, nz), vmul(nw, nw))));
+            // A zero quaternion (default structs, reset components) becomes identity, as in
+            // normalize(); len < denorm_min is len == 0 here, and NaN stays NaN like there
+            auto degenerate = vless(len, minLength);
+            vfloat inv = vdiv(one, len);
+            vstore(rotations.x + i, vselect(degenerate, zero, vmul(nx, inv)));
+            vstore(rotations.y + i, vselect(degenerate, zero, vmul(ny, inv)));
+            vstore(rotations.z + i, vselect(degenerate, zero, vmul(nz, inv)));
+            vstore(rotations.w + i, vselect(degenerate, one, vmul(nw, inv)));
+        }
+        for (; i < count; ++i)
+        {
+            integrate_one(positions, linearVelocity, rotations, angularVelocity, dt, i);
+        }
+    }
+
+    void look_at(Float3SoA from, Float3SoA to, QuatSoA out, size_t count)
+    {
+        const vfloat zero = vset1(0.0f), one = vset1(1.0f), halfOne = vset1(0.5f), eps = vset1(1e-6f);
+        const vfloat minLengthSq = vset1(kMinLookLengthSq);
+
+        size_t i = 0;
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            vfloat dx = vsub(vload(to.x + i), vload(from.x + i));
+            vfloat dy = vsub(vload(to.y + i), vload(from.y + i));
+            vfloat dz = vsub(vload(to.z + i), vload(from.z + i));
+
+            // Normalize; zero-length directions are replaced by identity below.
+            vfloat lengthSq = vadd(vadd(vmul(dx, dx), vmul(dy, dy)), vmul(dz, dz));
+            auto degenerate = vless(lengthSq, minLengthSq);
+            vfloat invLen = vdiv(one, vmax(vsqrt(lengthSq), eps));
+            dx = vmul(dx, invLen); dy = vmul(dy, invLen); dz = vmul(dz, invLen);
+
+            vfloat horizontal = vsqrt(vadd(vmul(dx, dx), vmul(dz, dz)));
+            auto flat = vless(horizontal, eps);
+            vfloat invH = vdiv(one, vmax(horizontal, eps));
+            vfloat hx = vselect(flat, zero, vmul(dx, invH));
+            vfloat hz = vselect(flat, one, vmul(dz, invH));
+
+            vfloat cy = vsqrt(vmax(zero, vmul(vadd(one, hz), halfOne)));
+            vfloat sy = vcopysign(vsqrt(vmax(zero, vmul(vsub(one, hz), halfOne))), hx);
+            vfloat cp = vsqrt(vmax(zero, vmul(vadd(one, horizontal), halfOne)));
+            vfloat sp = vcopysign(vsqrt(vmax(zero, vmul(vsub(one, horizontal), halfOne))), vsub(zero, dy));
+
+            vstore(out.x + i, vselect(degenerate, zero, vmul(cy, sp)));
+            vstore(out.y + i, vselect(degenerate, zero, vmul(sy, cp)));
+            vstore(out.z + i, vselect(degenerate, zero, vsub(zero, vmul(sy, sp))));
+            vstore(out.w + i, vselect(degenerate, one, vmul(cy, cp)));
+        }
+        for (; i < count; ++i)
+        {
+            look_at_one(from, to, out, i);
+        }
+    }
+
+    void merge_bounds(Float3SoA mins, Float3SoA maxs, size_t count, float3& outMin, float3& outMax)
+    {
+        if (count == 0) return;
+
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        float3 lo{ inf, inf, inf };
+        float3 hi{ -inf, -inf, -inf };
+
+        size_t i = 0;
+        if (count >= kLanes)
+        {
+            vfloat lx = vset1(inf), ly = vset1(inf), lz = vset1(inf);
+            vfloat hx = vset1(-inf), hy = vset1(-inf), hz = vset1(-inf);
+            for (; i + kLanes <= count; i += kLanes)
+            {
+                lx = vmin(lx, vload(mins.x + i)); ly = vmin(ly, vload(mins.y + i)); lz = vmin(lz, vload(mins.z + i));
+                hx = vmax(hx, vload(maxs.x + i)); hy = vmax(hy, vload(maxs.y + i)); hz = vmax(hz, vload(maxs.z + i));
+            }
+            lo = { vhmin(lx), vhmin(ly), vhmin(lz) };
+            hi = { vhmax(hx), vhmax(hy), vhmax(hz) };
+        }
+        for (; i < count; ++i)
+        {
+            lo = { std::min(lo.x, mins.x[i]), std::min(lo.y, mins.y[i]), std::min(lo.z, mins.z[i]) };
+            hi = { std::max(hi.x, maxs.x[i]), std::max(hi.y, maxs.y[i]), std::max(hi.z, maxs.z[i]) };
+        }
+
+        outMin = lo;
+        outMax = hi;
+    }
+
+    void transform_points(const float4x4& m, float3* points, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            points[i] = transform_point(m, points[i]);
+        }
+    }
+
+} // namespace Core::Math
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cmath>
+#include <cstddef>
+
+// Instruction set selection. Code compiled with /clr (the ScriptAPI) always takes the
+// scalar path, intrinsics are only used from natively compiled translation units.
+#if !defined(__cplusplus_cli) && !defined(CORE_MATH_FORCE_SCALAR)
+    #if defined(__AVX__)
+        #define CORE_SIMD_AVX 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define CORE_SIMD_SSE 1
+    #endif
+#endif
+
+#if defined(CORE_SIMD_AVX)
+    #include <immintrin.h>
+#elif defined(CORE_SIMD_SSE)
+    #include <emmintrin.h>
+#endif
+
+namespace Core::Math
+{
+    // All types are plain, unpadded and declared without alignas, so pinned managed arrays
+    // of the matching ScriptAPI value types can be reinterpreted directly. SIMD paths
+    // therefore always use unaligned loads and stores.
+
+    struct float3
+    {
+        float x, y, z;
+    };
+
+    struct float4
+    {
+        float x, y, z, w;
+    };
+
+    struct quat
+    {
+        float x, y, z, w;
+    };
+
+    // Column-major: c[3] holds the translation.
+    struct float4x4
+    {
+        float4 c[4];
+    };
+
+    static_assert(sizeof(float3) == 12 && sizeof(float4) == 16 && sizeof(quat) == 16 && sizeof(float4x4) == 64,
+                  "Math types must stay layout-identical to their ScriptAPI counterparts");
+
+    // --- float3 ---
+
+    inline float3 operator+(float3 a, float3 b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    inline float3 operator-(float3 a, float3 b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline float3 operator*(float3 a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    inline float3 operator*(float3 a, float3 b) { return { a.x * b.x, a.y * b.y, a.z * b.z }; }
+
+    inline float dot(float3 a, float3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline float3 cross(float3 a, float3 b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    inline float length(float3 a) { return std::sqrt(dot(a, a)); }
+    inline float3 normalize(float3 a)
+    {
+        float len = length(a);
+        return len > 0.0f ? a * (1.0f / len) : float3{ 0.0f, 0.0f, 0.0f };
+    }
+    inline float3 lerp(float3 a, float3 b, float t) { return a + (b - a) * t; }
+
+    // --- float4 ---
+
+    inline float4 operator+(float4 a, float4 b)
+    {
+#if defined(CORE_SIMD_SSE)
+        float4 r;
+        _mm_storeu_ps(&r.x, _mm_add_ps(_mm_loadu_ps(&a.x), _mm_loadu_ps(&b.x)));
+        return r;
+#else
+        return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+#endif
+    }
+
+    inline float4 operator-(float4 a, float4 b)
+    {
+#if defined(CORE_SIMD_SSE)
+        float4 r;
+        _mm_storeu_ps(&r.x, _mm_sub_ps(_mm_loadu_ps(&a.x), _mm_loadu_ps(&b.x)));
+        return r;
+#else
+        return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+#endif
+    }
+
+    inline float4 operator*(float4 a, float s)
+    {
+#if defined(CORE_SIMD_SSE)
+        float4 r;
+        _mm_storeu_ps(&r.x, _mm_mul_ps(_mm_loadu_ps(&a.x), _mm_set1_ps(s)));
+        return r;
+#else
+        return { a.x * s, a.y * s, a.z * s, a.w * s };
+#endif
+    }
+
+    inline float dot(float4 a, float4 b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+    // --- quat ---
+
+    inline quat quat_identity() { return { 0.0f, 0.0f, 0.0f, 1.0f }; }
+
+    inline quat quat_from_axis_angle(float3 axis, float radians)
+    {
+        float3 n = normalize(axis);
+        float s = std::sin(radians * 0.5f);
+        return { n.x * s, n.y * s, n.z * s, std::cos(radians * 0.5f) };
+    }
+
+    // Hamilton product: applying the result rotates by b first, then by a.
+    inline quat operator*(quat a, quat b)
+    {
+        return {
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+        };
+    }
+
+    inline quat normalize(quat q)
+    {
+        float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (len <= 0.0f) return quat_identity();
+        float inv = 1.0f / len;
+        return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+    }
+
+    inline float3 rotate(quat q, float3 v)
+    {
+        // v' = v + 2w(u x v) + 2u x (u x v)
+        float3 u{ q.x, q.y, q.z };
+        float3 t = cross(u, v) * 2.0f;
+        return v + t * q.w + cross(u, t);
+    }
+
+    // Rotation that turns +Z towards 'forward' while keeping +Y up (no roll). A zero-length
+    // 'forward' gives identity.
+    DLL_API quat look_rotation(float3 forward);
+
+    // --- float4x4 ---
+
+    inline float4x4 float4x4_identity()
+    {
+        return { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    }
+
+    inline float4 mul(const float4x4& m, float4 v)
+    {
+        return m.c[0] * v.x + m.c[1] * v.y + m.c[2] * v.z + m.c[3] * v.w;
+    }
+
+    inline float4x4 mul(const float4x4& a, const float4x4& b)
+    {
+        return { { mul(a, b.c[0]), mul(a, b.c[1]), mul(a, b.c[2]), mul(a, b.c[3]) } };
+    }
+
+    inline float3 transform_point(const float4x4& m, float3 p)
+    {
+        float4 r = mul(m, float4{ p.x, p.y, p.z, 1.0f });
+        return { r.x, r.y, r.z };
+    }
+
+    // Translation * Rotation * Scale
+    inline float4x4 trs(float3 t, quat r, float3 s)
+    {
+        float xx = r.x * r.x, yy = r.y * r.y, zz = r.z * r.z;
+        float xy = r.x * r.y, xz = r.x * r.z, yz = r.y * r.z;
+        float wx = r.w * r.x, wy = r.w * r.y, wz = r.w * r.z;
+        return { {
+            { (1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy + wz) * s.x, 2.0f * (xz - wy) * s.x, 0.0f },
+            { 2.0f * (xy - wz) * s.y, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz + wx) * s.y, 0.0f },
+            { 2.0f * (xz + wy) * s.z, 2.0f * (yz - wx) * s.z, (1.0f - 2.0f * (xx + yy)) * s.z, 0.0f },
+            { t.x, t.y, t.z, 1.0f }
+        } };
+    }
+
+    // --- Batch kernels over SoA streams ---
+    // The pointers of one stream must each address 'count' floats. Kernels use AVX or SSE
+    // when Core is compiled with them and fall back to scalar code otherwise.
+
+    struct Float3SoA
+    {
+        float* x;
+        float* y;
+        float* z;
+    };
+
+    struct QuatSoA
+    {
+        float* x;
+        float* y;
+        float* z;
+        float* w;
+    };
+
+    // positions += linearVelocity * dt
+    // rotations  = normalize(rotations + 0.5 * dt * (angularVelocity, 0) * rotations)
+    // 'rotations' and 'angularVelocity' may be null to integrate positions only.
+    DLL_API void integrate_transforms(
+        Float3SoA positions, Float3SoA linearVelocity,
+        QuatSoA rotations, Float3SoA angularVelocity,
+        float dt, size_t count);
+
+    // Writes look_rotation(to - from) for every element.
+    DLL_API void look_at(Float3SoA from, Float3SoA to, QuatSoA outRotations, size_t count);
+
+    // Merges 'count' boxes into one. outMin/outMax are left untouched when count is 0.
+    DLL_API void merge_bounds(Float3SoA mins, Float3SoA maxs, size_t count, float3& outMin, float3& outMax);
+
+    // In-place transform of an AoS point array
+    DLL_API void transform_points(const float4x4& m, float3* points, size_t count);
+
+} // namespace Core::Math
@@ -0,0 +1,460 @@
+#include "spatial_index.h"
+#include "simd_math.h" // CORE_SIMD_SSE and intrinsics
+
+#include <algorithm> // std::sort, std::max, std::min
+#include <cmath>     // std::floor, std::sqrt
+
+namespace Core
+{
+    namespace
+    {
+        // Cell coordinates are packed into 21 bits each, which covers +-1M cells per axis.
+        constexpr int kCellBits = 21;
+        constexpr int64_t kCellBias = int64_t(1) << (kCellBits - 1);
+        constexpr uint64_t kCellMask = (uint64_t(1) << kCellBits) - 1;
+
+        // Above this many cells in a query box it is cheaper to walk the occupied cells.
+        constexpr int64_t kMaxCellsToScan = 4096;
+
+        uint64_t pack_cell(int64_t cx, int64_t cy, int64_t cz)
+        {
+            return (uint64_t(cx + kCellBias) & kCellMask) |
+                  ((uint64_t(cy + kCellBias) & kCellMask) << kCellBits) |
+                  ((uint64_t(cz + kCellBias) & kCellMask) << (kCellBits * 2));
+        }
+
+        void unpack_cell(uint64_t key, int64_t& cx, int64_t& cy, int64_t& cz)
+        {
+            cx = int64_t(key & kCellMask) - kCellBias;
+            cy = int64_t((key >> kCellBits) & kCellMask) - kCellBias;
+            cz = int64_t((key >> (kCellBits * 2)) & kCellMask) - kCellBias;
+        }
+
+        // Per-thread scratch so queries stay const and can run from worker threads.
+        struct QueryScratch
+        {
+            std::vector<uint32_t> slots;
+            std::vector<float> x, y, z, r;
+            std::vector<uint8_t> hit;
+            std::vector<std::pair<float, int>> rayHits;
+
+            void load(std::span<const uint32_t> candidates,
+                      const std::vector<float>& px, const std::vector<float>& py,
+                      const std::vector<float>& pz, const std::vector<float>& pr)
+            {
+                // Pad to a multiple of 4 so the SIMD loops never need a scalar tail.
+                size_t padded = (candidates.size() + 3) & ~size_t(3);
+                x.resize(padded); y.resize(padded); z.resize(padded); r.resize(padded);
+                hit.resize(padded);
+                for (size_t i = 0; i < candidates.size(); ++i)
+                {
+                    uint32_t s = candidates[i];
+                    x[i] = px[s]; y[i] = py[s]; z[i] = pz[s]; r[i] = pr[s];
+                }
+                for (size_t i = candidates.size(); i < padded; ++i)
+                {
+                    // Far-away, zero sized padding never passes a test.
+                    x[i] = y[i] = z[i] = 3.0e38f; r[i] = 0.0f;
+                }
+            }
+        };
+
+        QueryScratch& scratch()
+        {
+            thread_local QueryScratch s;
+            return s;
+        }
+
+        // Marks spheres that intersect the query sphere.
+        void cull_spheres(const QueryScratch& s, size_t count, float cx, float cy, float cz, float cr, uint8_t* hit)
+        {
+            size_t i = 0;
+#if defined(CORE_SIMD_SSE)
+            const __m128 qx = _mm_set1_ps(cx), qy = _mm_set1_ps(cy), qz = _mm_set1_ps(cz), qr = _mm_set1_ps(cr);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 dx = _mm_sub_ps(_mm_loadu_ps(&s.x[i]), qx);
+                __m128 dy = _mm_sub_ps(_mm_loadu_ps(&s.y[i]), qy);
+                __m128 dz = _mm_sub_ps(_mm_loadu_ps(&s.z[i]), qz);
+                __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                __m128 rr = _mm_add_ps(_mm_loadu_ps(&s.r[i]), qr);
+                int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(rr, rr)));
+                hit[i + 0] = uint8_t(mask & 1);
+                hit[i + 1] = uint8_t((mask >> 1) & 1);
+                hit[i + 2] = uint8_t((mask >> 2) & 1);
+                hit[i + 3] = uint8_t((mask >> 3) & 1);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                float dx = s.x[i] - cx, dy = s.y[i] - cy, dz = s.z[i] - cz;
+                float rr = s.r[i] + cr;
+                hit[i] = uint8_t(dx * dx + dy * dy + dz * dz <= rr * rr);
+            }
+        }
+
+        // Marks spheres that intersect the box.
+        void cull_box(const QueryScratch& s, size_t count, const AabbQuery& q, uint8_t* hit)
+        {
+            size_t i = 0;
+#if defined(CORE_SIMD_SSE)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 minX = _mm_set1_ps(q.minX), minY = _mm_set1_ps(q.minY), minZ = _mm_set1_ps(q.minZ);
+            const __m128 maxX = _mm_set1_ps(q.maxX), maxY = _mm_set1_ps(q.maxY), maxZ = _mm_set1_ps(q.maxZ);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 px = _mm_loadu_ps(&s.x[i]), py = _mm_loadu_ps(&s.y[i]), pz = _mm_loadu_ps(&s.z[i]);
+                // Distance from the center to the box along each axis (0 when inside).
+                __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minX, px), _mm_sub_ps(px, maxX)), zero);
+                __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minY, py), _mm_sub_ps(py, maxY)), zero);
+                __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minZ, pz), _mm_sub_ps(pz, maxZ)), zero);
+                __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                __m128 r = _mm_loadu_ps(&s.r[i]);
+                int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(r, r)));
+                hit[i + 0] = uint8_t(mask & 1);
+                hit[i + 1] = uint8_t((mask >> 1) & 1);
+                hit[i + 2] = uint8_t((mask >> 2) & 1);
+                hit[i + 3] = uint8_t((mask >> 3) & 1);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                float dx = std::max(std::max(q.minX - s.x[i], s.x[i] - q.maxX), 0.0f);
+                float dy = std::max(std::max(q.minY - s.y[i], s.y[i] - q.maxY), 0.0f);
+                float dz = std::max(std::max(q.minZ - s.z[i], s.z[i] - q.maxZ), 0.0f);
+                hit[i] = uint8_t(dx * dx + dy * dy + dz * dz <= s.r[i] * s.r[i]);
+            }
+        }
+
+        // Marks spheres hit by the (normalized) ray segment and stores the distance along it.
+        void cull_ray(const QueryScratch& s, size_t count,
+                      float ox, float oy, float oz, float dx, float dy, float dz,
+                      float maxDist, float rayRadius, uint8_t* hit, float* tOut)
+        {
+            size_t i = 0;
+#if defined(CORE_SIMD_SSE)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 vox = _mm_set1_ps(ox), voy = _mm_set1_ps(oy), voz = _mm_set1_ps(oz);
+            const __m128 vdx = _mm_set1_ps(dx), vdy = _mm_set1_ps(dy), vdz = _mm_set1_ps(dz);
+            const __m128 vmax = _mm_set1_ps(maxDist), vrr = _mm_set1_ps(rayRadius);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 px = _mm_sub_ps(_mm_loadu_ps(&s.x[i]), vox);
+                __m128 py = _mm_sub_ps(_mm_loadu_ps(&s.y[i]), voy);
+                __m128 pz = _mm_sub_ps(_mm_loadu_ps(&s.z[i]), voz);
+                // Closest point on the segment to the sphere center.
+                __m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, vdx), _mm_mul_ps(py, vdy)), _mm_mul_ps(pz, vdz));
+                t = _mm_min_ps(_mm_max_ps(t, zero), vmax);
+                __m128 cx = _mm_sub_ps(px, _mm_mul_ps(vdx, t));
+                __m128 cy = _mm_sub_ps(py, _mm_mul_ps(vdy, t));
+                __m128 cz = _mm_sub_ps(pz, _mm_mul_ps(vdz, t));
+                __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+                __m128 rr = _mm_add_ps(_mm_loadu_ps(&s.r[i]), vrr);
+                int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(rr, rr)));
+                _mm_storeu_ps(&tOut[i], t);
+                hit[i + 0] = uint8_t(mask & 1);
+                hit[i + 1] = uint8_t((mask >> 1) & 1);
+                hit[i + 2] = uint8_t((mask >> 2) & 1);
+                hit[i + 3] = uint8_t((mask >> 3) & 1);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                float px = s.x[i] - ox, py = s.y[i] - oy, pz = s.z[i] - oz;
+                float t = std::min(std::max(px * dx + py * dy + pz * dz, 0.0f), maxDist);
+                float cx = px - dx * t, cy = py - dy * t, cz = pz - dz * t;
+                float rr = s.r[i] + rayRadius;
+                tOut[i] = t;
+                hit[i] = uint8_t(cx * cx + cy * cy + cz * cz <= rr * rr);
+            }
+        }
+    } // anonymous namespace
+
+    SpatialIndex::SpatialIndex(float cellSize)
+        : cellSize_(cellSize > 0.0f ? cellSize : 8.0f)
+        , invCellSize_(1.0f / cellSize_)
+    {
+    }
+
+    SpatialIndex& SpatialIndex::instance()
+    {
+        static SpatialIndex index;
+        return index;
+    }
+
+    SpatialIndex::CellKey SpatialIndex::cell_key_for(float x, float y, float z) const
+    {
+        return pack_cell(
+            static_cast<int64_t>(std::floor(x * invCellSize_)),
+            static_cast<int64_t>(std::floor(y * invCellSize_)),
+            static_cast<int64_t>(std::floor(z * invCellSize_)));
+    }
+
+    void SpatialIndex::insert_into_cell(CellKey key, uint32_t slot)
+    {
+        cells_[key].push_back(slot);
+    }
+
+    void SpatialIndex::remove_from_cell(CellKey key, uint32_t slot)
+    {
+        auto it = cells_.find(key);
+        if (it == cells_.end()) return;
+
+        auto& slots = it->second;
+        auto pos = std::find(slots.begin(), slots.end(), slot);
+        if (pos != slots.end())
+        {
+            *pos = slots.back();
+            slots.pop_back();
+        }
+        if (slots.empty())
+        {
+            cells_.erase(it);
+        }
+    }
+
+    void SpatialIndex::update(int entityId, float x, float y, float z, float radius)
+    {
+        radius = std::max(radius, 0.0f);
+        maxRadius_ = std::max(maxRadius_, radius);
+        CellKey key = cell_key_for(x, y, z);
+
+        auto found = slotOfEntity_.find(entityId);
+        if (found == slotOfEntity_.end())
+        {
+            uint32_t slot = static_cast<uint32_t>(entity_.size());
+            posX_.push_back(x);
+            posY_.push_back(y);
+            posZ_.push_back(z);
+            radius_.push_back(radius);
+            entity_.push_back(entityId);
+            cellOf_.push_back(key);
+            slotOfEntity_.emplace(entityId, slot);
+            insert_into_cell(key, slot);
+            return;
+        }
+
+        uint32_t slot = found->second;
+        posX_[slot] = x;
+        posY_[slot] = y;
+        posZ_[slot] = z;
+        radius_[slot] = radius;
+        if (cellOf_[slot] != key)
+        {
+            remove_from_cell(cellOf_[slot], slot);
+            insert_into_cell(key, slot);
+            cellOf_[slot] = key;
+        }
+    }
+
+    void SpatialIndex::move(int entityId, float x, float y, float z)
+    {
+        auto found = slotOfEntity_.find(entityId);
+        update(entityId, x, y, z, found == slotOfEntity_.end() ? 0.0f : radius_[found->second]);
+    }
+
+    bool SpatialIndex::remove(int entityId)
+    {
+        auto found = slotOfEntity_.find(entityId);
+        if (found == slotOfEntity_.end()) return false;
+
+        uint32_t slot = found->second;
+        uint32_t last = static_cast<uint32_t>(entity_.size() - 1);
+        remove_from_cell(cellOf_[slot], slot);
+        slotOfEntity_.erase(found);
+
+        if (slot != last)
+        {
+            // Swap the last entity into the freed slot and patch its cell bucket.
+            posX_[slot] = posX_[last];
+            posY_[slot] = posY_[last];
+            posZ_[slot] = posZ_[last];
+            radius_[slot] = radius_[last];
+            entity_[slot] = entity_[last];
+            cellOf_[slot] = cellOf_[last];
+
+            auto& bucket = cells_[cellOf_[slot]];
+            std::replace(bucket.begin(), bucket.end(), last, slot);
+            slotOfEntity_[entity_[slot]] = slot;
+        }
+
+        posX_.pop_back();
+        posY_.pop_back();
+        posZ_.pop_back();
+        radius_.pop_back();
+        entity_.pop_back();
+        cellOf_.pop_back();
+        return true;
+    }
+
+    void SpatialIndex::clear()
+    {
+        posX_.clear();
+        posY_.clear();
+        posZ_.clear();
+        radius_.clear();
+        entity_.clear();
+        cellOf_.clear();
+        slotOfEntity_.clear();
+        cells_.clear();
+        maxRadius_ = 0.0f;
+    }
+
+    void SpatialIndex::set_cell_size(float cellSize)
+    {
+        if (cellSize <= 0.0f || cellSize == cellSize_) return;
+        cellSize_ = cellSize;
+        invCellSize_ = 1.0f / cellSize;
+        rebuild_cells();
+    }
+
+    void SpatialIndex::rebuild_cells()
+    {
+        cells_.clear();
+        for (uint32_t slot = 0; slot < entity_.size(); ++slot)
+        {
+            cellOf_[slot] = cell_key_for(posX_[slot], posY_[slot], posZ_[slot]);
+            insert_into_cell(cellOf_[slot], slot);
+        }
+    }
+
+    void SpatialIndex::gather_candidates(float minX, float minY, float minZ,
+                                         float maxX, float maxY, float maxZ,
+                                         std::vector<uint32_t>& outSlots) const
+    {
+        outSlots.clear();
+
+        // Entities are bucketed by center only, so widen by the loosest radius.
+        minX -= maxRadius_; minY -= maxRadius_; minZ -= maxRadius_;
+        maxX += maxRadius_; maxY += maxRadius_; maxZ += maxRadius_;
+
+        const int64_t x0 = static_cast<int64_t>(std::floor(minX * invCellSize_));
+        const int64_t y0 = static_cast<int64_t>(std::floor(minY * invCellSize_));
+        const int64_t z0 = static_cast<int64_t>(std::floor(minZ * invCellSize_));
+        const int64_t x1 = static_cast<int64_t>(std::floor(maxX * invCellSize_));
+        const int64_t y1 = static_cast<int64_t>(std::floor(maxY * invCellSize_));
+        const int64_t z1 = static_cast<int64_t>(std::floor(maxZ * invCellSize_));
+
+        const int64_t cellCount = (x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1);
+        if (cellCount > kMaxCellsToScan || cellCount > static_cast<int64_t>(cells_.size()))
+        {
+            // Large query: filter the occupied cells instead of probing every coordinate.
+            for (const auto& [key, slots] : cells_)
+            {
+                int64_t cx, cy, cz;
+                unpack_cell(key, cx, cy, cz);
+                if (cx < x0 || cx > x1 || cy < y0 || cy > y1 || cz < z0 || cz > z1) continue;
+                outSlots.insert(outSlots.end(), slots.begin(), slots.end());
+            }
+            return;
+        }
+
+        for (int64_t cz = z0; cz <= z1; ++cz)
+            for (int64_t cy = y0; cy <= y1; ++cy)
+                for (int64_t cx = x0; cx <= x1; ++cx)
+                {
+                    auto it = cells_.find(pack_cell(cx, cy, cz));
+                    if (it != cells_.end())
+                    {
+                        outSlots.insert(outSlots.end(), it->second.begin(), it->second.end());
+                    }
+                }
+    }
+
+    int SpatialIndex::query_radius(std::span<const RadiusQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const
+    {
+        QueryScratch& s = scratch();
+        size_t written = 0;
+
+        for (size_t q = 0; q < queries.size() && q < ranges.size(); ++q)
+        {
+            const RadiusQuery& query = queries[q];
+            ranges[q] = { static_cast<int>(written), 0 };
+
+            gather_candidates(query.x - query.radius, query.y - query.radius, query.z - query.radius,
+                              query.x + query.radius, query.y + query.radius, query.z + query.radius, s.slots);
+            if (s.slots.empty()) continue;
+
+            s.load(s.slots, posX_, posY_, posZ_, radius_);
+            cull_spheres(s, s.x.size(), query.x, query.y, query.z, query.radius, s.hit.data());
+
+            for (size_t i = 0; i < s.slots.size() && written < results.size(); ++i)
+            {
+                if (s.hit[i]) results[written++] = entity_[s.slots[i]];
+            }
+            ranges[q].count = static_cast<int>(written) - ranges[q].offset;
+        }
+        return static_cast<int>(written);
+    }
+
+    int SpatialIndex::query_aabb(std::span<const AabbQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const
+    {
+        QueryScratch& s = scratch();
+        size_t written = 0;
+
+        for (size_t q = 0; q < queries.size() && q < ranges.size(); ++q)
+        {
+            const AabbQuery& query = queries[q];
+            ranges[q] = { static_cast<int>(written), 0 };
+
+            gather_candidates(query.minX, query.minY, query.minZ, query.maxX, query.maxY, query.maxZ, s.slots);
+            if (s.slots.empty()) continue;
+
+            s.load(s.slots, posX_, posY_, posZ_, radius_);
+            cull_box(s, s.x.size(), query, s.hit.data());
+
+            for (size_t i = 0; i < s.slots.size() && written < results.size(); ++i)
+            {
+                if (s.hit[i]) results[written++] = entity_[s.slots[i]];
+            }
+            ranges[q].count = static_cast<int>(written) - ranges[q].offset;
+        }
+        return static_cast<int>(written);
+    }
+
+    int SpatialIndex::query_ray(std::span<const RayQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const
+    {
+        QueryScratch& s = scratch();
+        std::vector<float> t;
+        size_t written = 0;
+
+        for (size_t q = 0; q < queries.size() && q < ranges.size(); ++q)
+        {
+            const RayQuery& query = queries[q];
+            ranges[q] = { static_cast<int>(written), 0 };
+
+            float len = std::sqrt(query.dirX * query.dirX + query.dirY * query.dirY + query.dirZ * query.dirZ);
+            if (len <= 0.0f || query.maxDistance <= 0.0f) continue;
+            float dx = query.dirX / len, dy = query.dirY / len, dz = query.dirZ / len;
+
+            float ex = query.originX + dx * query.maxDistance;
+            float ey = query.originY + dy * query.maxDistance;
+            float ez = query.originZ + dz * query.maxDistance;
+            float r = std::max(query.radius, 0.0f);
+            gather_candidates(std::min(query.originX, ex) - r, std::min(query.originY, ey) - r, std::min(query.originZ, ez) - r,
+                              std::max(query.originX, ex) + r, std::max(query.originY, ey) + r, std::max(query.originZ, ez) + r,
+                              s.slots);
+            if (s.slots.empty()) continue;
+
+            s.load(s.slots, posX_, posY_, posZ_, radius_);
+            t.resize(s.x.size());
+            cull_ray(s, s.x.size(), query.originX, query.originY, query.originZ, dx, dy, dz,
+                     query.maxDistance, r, s.hit.data(), t.data());
+
+            s.rayHits.clear();
+            for (size_t i = 0; i < s.slots.size(); ++i)
+            {
+                if (s.hit[i]) s.rayHits.emplace_back(t[i], entity_[s.slots[i]]);
+            }
+            std::sort(s.rayHits.begin(), s.rayHits.end());
+
+            for (size_t i = 0; i < s.rayHits.size() && written < results.size(); ++i)
+            {
+                results[written++] = s.rayHits[i].second;
+            }
+            ranges[q].count = static_cast<int>(written) - ranges[q].offset;
+        }
+        return static_cast<int>(written);
+    }
+
+} // namespace Core
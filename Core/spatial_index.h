@@ -0,0 +1,104 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <unordered_map>
+
+namespace Core
+{
+    // Query descriptors. These are plain, tightly packed structs so the ScriptAPI can
+    // pin arrays of its layout-identical value types and hand them over without conversion.
+    struct RadiusQuery
+    {
+        float x, y, z;
+        float radius;
+    };
+
+    struct AabbQuery
+    {
+        float minX, minY, minZ;
+        float maxX, maxY, maxZ;
+    };
+
+    // dir does not need to be normalized. radius > 0 turns the ray into a sphere cast.
+    struct RayQuery
+    {
+        float originX, originY, originZ;
+        float dirX, dirY, dirZ;
+        float maxDistance;
+        float radius;
+    };
+
+    // Slice of the shared results span that belongs to one query of a batch.
+    struct QueryRange
+    {
+        int offset;
+        int count;
+    };
+
+    // Loose uniform grid over entity bounding spheres.
+    // Entities are bucketed by the cell containing their center; queries widen their
+    // search by the largest radius seen so nothing overlapping a neighbour cell is missed.
+    // Entity data is kept in SoA arrays so candidate sets can be culled with SIMD.
+    class DLL_API SpatialIndex
+    {
+    public:
+        explicit SpatialIndex(float cellSize = 8.0f);
+
+        // Process-wide index shared by the engine loop and the ScriptAPI.
+        static SpatialIndex& instance();
+
+        // Inserts the entity or moves it. Only touches the cell buckets when the entity
+        // actually crosses a cell boundary.
+        void update(int entityId, float x, float y, float z, float radius = 0.0f);
+        // Same as update() but keeps the entity's current radius.
+        void move(int entityId, float x, float y, float z);
+        bool remove(int entityId);
+        void clear();
+
+        // Changing the cell size rebuilds all buckets.
+        void set_cell_size(float cellSize);
+        float cell_size() const { return cellSize_; }
+        size_t size() const { return entity_.size(); }
+
+        // Batch queries. Matching entity ids are appended to 'results' and each query's
+        // slice is written to the matching element of 'ranges' (which must be at least as
+        // long as 'queries'). Matches that do not fit in 'results' are dropped.
+        // Returns the total number of ids written.
+        int query_radius(std::span<const RadiusQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const;
+        int query_aabb(std::span<const AabbQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const;
+        // Ray hits of each query are sorted by distance along the ray.
+        int query_ray(std::span<const RayQuery> queries, std::span<int> results, std::span<QueryRange> ranges) const;
+
+    private:
+        using CellKey = uint64_t;
+
+        CellKey cell_key_for(float x, float y, float z) const;
+        void insert_into_cell(CellKey key, uint32_t slot);
+        void remove_from_cell(CellKey key, uint32_t slot);
+        void rebuild_cells();
+
+        // Collects the slots of every entity whose cell lies in the given world-space box.
+        void gather_candidates(float minX, float minY, float minZ,
+                               float maxX, float maxY, float maxZ,
+                               std::vector<uint32_t>& outSlots) const;
+
+        float cellSize_;
+        float invCellSize_;
+        float maxRadius_ = 0.0f;
+
+        // SoA entity storage, indexed by slot
+        std::vector<float> posX_;
+        std::vector<float> posY_;
+        std::vector<float> posZ_;
+        std::vector<float> radius_;
+        std::vector<int> entity_;
+        std::vector<CellKey> cellOf_;
+
+        std::unordered_map<int, uint32_t> slotOfEntity_;
+        std::unordered_map<CellKey, std::vector<uint32_t>> cells_;
+    };
+
+} // namespace Core
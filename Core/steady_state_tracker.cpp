@@ -0,0 +1,60 @@
+#include "steady_state_tracker.h"
+
+#include <algorithm> // std::nth_element, std::max_element
+
+namespace Core
+{
+    namespace
+    {
+        // Absolute slack so sub-millisecond frames don't flag timer noise as unsteady
+        constexpr double kNoiseFloorSeconds = 0.0002;
+    }
+
+    SteadyStateTracker::SteadyStateTracker(size_t windowFrames, double tolerance)
+        : windowFrames_(std::max<size_t>(windowFrames, 2))
+        , tolerance_(tolerance)
+        , window_(windowFrames_)
+    {
+    }
+
+    void SteadyStateTracker::begin(const std::string& label)
+    {
+        label_ = label;
+        measuring_ = true;
+        observed_ = 0;
+        totalSeconds_ = 0.0;
+        steadyFrame_ = 0;
+        secondsToSteady_ = 0.0;
+        steadyMedian_ = 0.0;
+        firstFrame_ = 0.0;
+        worstFrame_ = 0.0;
+    }
+
+    bool SteadyStateTracker::observe(double frameSeconds)
+    {
+        if (!measuring_) return false;
+        if (observed_ == 0) firstFrame_ = frameSeconds;
+        worstFrame_ = std::max(worstFrame_, frameSeconds);
+        window_[observed_ % windowFrames_] = frameSeconds;
+        totalSeconds_ += frameSeconds;
+        if (++observed_ < windowFrames_) return false;
+
+        // Order doesn't matter for the median and maximum, so the ring is used as is
+        scratch_.assign(window_.begin(), window_.end());
+        auto middle = scratch_.begin() + static_cast<std::ptrdiff_t>(scratch_.size() / 2);
+        std::nth_element(scratch_.begin(), middle, scratch_.end());
+        double median = *middle;
+        double worst = *std::max_element(window_.begin(), window_.end());
+        if (worst > median * (1.0 + tolerance_) + kNoiseFloorSeconds) return false;
+
+        double windowSeconds = 0.0;
+        for (double seconds : window_) windowSeconds += seconds;
+
+        measuring_ = false;
+        steadyFrame_ = observed_ - windowFrames_;
+        steadyMedian_ = median;
+        secondsToSteady_ = std::max(0.0, totalSeconds_ - windowSeconds);
+        return true;
+    }
+
+} // namespace Core
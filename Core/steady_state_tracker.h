@@ -0,0 +1,50 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    // Measures how long frame times take to settle after a (re)load, while the JIT is
+    // still compiling and tiering up script code.
+    // The frame loop feeds it one frame time per frame; steady state is reached at the
+    // first frame of a window of 'windowFrames' frames that all stay within 'tolerance'
+    // of the window's median. observe() returns true once, when that happens.
+    class DLL_API SteadyStateTracker
+    {
+    public:
+        explicit SteadyStateTracker(size_t windowFrames = 30, double tolerance = 0.25);
+
+        // Starts a new measurement, e.g. "startup" or "reload".
+        void begin(const std::string& label);
+        bool observe(double frameSeconds);
+
+        bool measuring() const { return measuring_; }
+        const std::string& label() const { return label_; }
+        // Valid after observe() returned true
+        size_t frames_to_steady() const { return steadyFrame_; }
+        double seconds_to_steady() const { return secondsToSteady_; }
+        double steady_frame_seconds() const { return steadyMedian_; }
+        double first_frame_seconds() const { return firstFrame_; }
+        double worst_frame_seconds() const { return worstFrame_; }
+
+    private:
+        size_t windowFrames_;
+        double tolerance_;
+        std::string label_;
+        bool measuring_ = false;
+
+        std::vector<double> window_; // Ring of the last 'windowFrames_' frame times
+        std::vector<double> scratch_;
+        size_t observed_ = 0;        // Frames since begin()
+        double totalSeconds_ = 0.0;  // Sum of every frame since begin()
+        size_t steadyFrame_ = 0;
+        double secondsToSteady_ = 0.0;
+        double steadyMedian_ = 0.0;
+        double firstFrame_ = 0.0;
+        double worstFrame_ = 0.0;
+    };
+
+} // namespace Core
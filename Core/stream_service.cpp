@@ -0,0 +1,276 @@
+#include "stream_service.h"
+#include "lz4_block.h"
+#include "mapped_file.h"
+
+#include <algorithm>  // std::min
+#include <condition_variable>
+#include <filesystem> // std::filesystem::file_size
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr uint64_t kDefaultMapThreshold = 1024 * 1024;
+    }
+
+    struct StreamService::Impl
+    {
+        struct Request
+        {
+            StreamRequestId id = 0;
+            std::string path;
+            StreamReadDesc desc;
+            StreamStatus status = StreamStatus::Pending;
+            bool inFlight = false;
+            bool cancelRequested = false;
+
+            // Written by the I/O thread while in flight, read-only once finished
+            MappedFile mapping;
+            std::vector<uint8_t> buffer;
+            std::span<const uint8_t> view; // Into 'buffer' or 'mapping'
+            std::string error;
+        };
+
+        struct QueueEntry
+        {
+            StreamPriority priority;
+            StreamRequestId id; // Ids increase, so they double as FIFO order
+            std::shared_ptr<Request> request;
+
+            bool operator<(const QueueEntry& other) const
+            {
+                if (priority != other.priority) return priority < other.priority;
+                return id > other.id;
+            }
+        };
+
+        void io_loop();
+        static bool read(Request& request, uint64_t mapThreshold);
+        void finish(const std::shared_ptr<Request>& request, bool ok);
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::priority_queue<QueueEntry> queue;
+        std::unordered_map<StreamRequestId, std::shared_ptr<Request>> requests;
+        std::vector<StreamCompletion> completions;
+        std::vector<std::thread> threads;
+        StreamRequestId nextId = 1;
+        uint64_t mapThreshold = kDefaultMapThreshold;
+        bool stopping = false;
+    };
+
+    void StreamService::Impl::io_loop()
+    {
+        std::unique_lock lock(mutex);
+        for (;;)
+        {
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+
+            std::shared_ptr<Request> request = queue.top().request;
+            queue.pop();
+            if (request->status != StreamStatus::Pending) continue; // Cancelled while queued
+
+            request->inFlight = true;
+            uint64_t threshold = mapThreshold;
+            lock.unlock();
+            bool ok = read(*request, threshold);
+            lock.lock();
+            request->inFlight = false;
+            finish(request, ok);
+        }
+    }
+
+    bool StreamService::Impl::read(Request& request, uint64_t mapThreshold)
+    {
+        const StreamReadDesc& desc = request.desc;
+        std::error_code ec;
+        uint64_t fileSize = std::filesystem::file_size(request.path, ec);
+        if (ec)
+        {
+            request.error = "Cannot open " + request.path + ": " + ec.message();
+            return false;
+        }
+        uint64_t length = desc.length != 0 ? desc.length : fileSize - std::min(desc.offset, fileSize);
+        if (desc.offset > fileSize || length > fileSize - desc.offset)
+        {
+            request.error = "Read past the end of " + request.path;
+            return false;
+        }
+
+        // Large files are mapped, so neither path below copies them into a staging buffer
+        std::span<const uint8_t> source;
+        if (length >= mapThreshold)
+        {
+            if (!request.mapping.open(request.path))
+            {
+                request.error = "Cannot map " + request.path;
+                return false;
+            }
+            source = request.mapping.bytes().subspan(static_cast<size_t>(desc.offset), static_cast<size_t>(length));
+        }
+        else
+        {
+            request.buffer.resize(static_cast<size_t>(length));
+            std::ifstream in(request.path, std::ios::binary);
+            in.seekg(static_cast<std::streamoff>(desc.offset));
+            if (!in || !in.read(reinterpret_cast<char*>(request.buffer.data()), static_cast<std::streamsize>(length)))
+            {
+                request.error = "Cannot read " + request.path;
+                return false;
+            }
+            source = request.buffer;
+        }
+
+        if (desc.compression == StreamCompression::Lz4Block)
+        {
+            if (desc.uncompressedSize == 0)
+            {
+                request.error = "LZ4 read of " + request.path + " has no uncompressed size";
+                return false;
+            }
+            std::vector<uint8_t> decompressed(static_cast<size_t>(desc.uncompressedSize));
+            if (!lz4_decompress_block(source, decompressed))
+            {
+                request.error = "Corrupt LZ4 block in " + request.path;
+                return false;
+            }
+            request.buffer = std::move(decompressed);
+            request.mapping.close();
+            source = request.buffer;
+        }
+
+        request.view = source;
+        return true;
+    }
+
+    // Called with the mutex held.
+    void StreamService::Impl::finish(const std::shared_ptr<Request>& request, bool ok)
+    {
+        if (request->cancelRequested) request->status = StreamStatus::Cancelled;
+        else request->status = ok ? StreamStatus::Completed : StreamStatus::Failed;
+
+        if (request->status != StreamStatus::Completed)
+        {
+            request->view = {};
+            request->buffer = {};
+            request->mapping.close();
+        }
+        if (requests.count(request->id) != 0) // Not released meanwhile
+        {
+            completions.push_back({ request->id, request->status });
+        }
+    }
+
+    // --- StreamService ---
+
+    StreamService::StreamService(size_t ioThreadCount)
+        : impl_(std::make_unique<Impl>())
+    {
+        if (ioThreadCount == 0) ioThreadCount = 1;
+        for (size_t i = 0; i < ioThreadCount; ++i)
+        {
+            impl_->threads.emplace_back(&Impl::io_loop, impl_.get());
+        }
+    }
+
+    StreamService::~StreamService()
+    {
+        {
+            std::lock_guard lock(impl_->mutex);
+            impl_->stopping = true;
+        }
+        impl_->wake.notify_all();
+        for (std::thread& thread : impl_->threads) thread.join();
+    }
+
+    StreamService& StreamService::instance()
+    {
+        static StreamService service;
+        return service;
+    }
+
+    StreamRequestId StreamService::submit(const std::string& path, const StreamReadDesc& desc)
+    {
+        auto request = std::make_shared<Impl::Request>();
+        request->path = path;
+        request->desc = desc;
+        {
+            std::lock_guard lock(impl_->mutex);
+            request->id = impl_->nextId++;
+            impl_->requests.emplace(request->id, request);
+            impl_->queue.push({ desc.priority, request->id, request });
+        }
+        impl_->wake.notify_one();
+        return request->id;
+    }
+
+    bool StreamService::cancel(StreamRequestId id)
+    {
+        std::lock_guard lock(impl_->mutex);
+        auto it = impl_->requests.find(id);
+        if (it == impl_->requests.end()) return false;
+
+        Impl::Request& request = *it->second;
+        if (request.status != StreamStatus::Pending) return false;
+        if (request.cancelRequested) return true;
+
+        request.cancelRequested = true;
+        if (!request.inFlight) impl_->finish(it->second, false); // Skipped when dequeued
+        return true;
+    }
+
+    size_t StreamService::poll(std::vector<StreamCompletion>& out)
+    {
+        std::lock_guard lock(impl_->mutex);
+        size_t count = impl_->completions.size();
+        out.insert(out.end(), impl_->completions.begin(), impl_->completions.end());
+        impl_->completions.clear();
+        return count;
+    }
+
+    std::span<const uint8_t> StreamService::data(StreamRequestId id) const
+    {
+        std::lock_guard lock(impl_->mutex);
+        auto it = impl_->requests.find(id);
+        if (it == impl_->requests.end() || it->second->status != StreamStatus::Completed) return {};
+        return it->second->view;
+    }
+
+    std::string StreamService::error(StreamRequestId id) const
+    {
+        std::lock_guard lock(impl_->mutex);
+        auto it = impl_->requests.find(id);
+        return it != impl_->requests.end() && it->second->status == StreamStatus::Failed ? it->second->error : std::string();
+    }
+
+    void StreamService::release(StreamRequestId id)
+    {
+        std::shared_ptr<Impl::Request> request;
+        {
+            std::lock_guard lock(impl_->mutex);
+            auto it = impl_->requests.find(id);
+            if (it == impl_->requests.end()) return;
+            request = std::move(it->second);
+            impl_->requests.erase(it);
+            if (request->status == StreamStatus::Pending)
+            {
+                request->cancelRequested = true;
+                if (!request->inFlight) request->status = StreamStatus::Cancelled; // Skipped when dequeued
+            }
+        }
+        // An in-flight read still holds a reference and frees the buffers when it returns
+    }
+
+    void StreamService::set_map_threshold(uint64_t bytes)
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->mapThreshold = bytes;
+    }
+
+} // namespace Core
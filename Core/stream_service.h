@@ -0,0 +1,98 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    // Mirrored by ScriptAPI::StreamPriority
+    enum class StreamPriority : int32_t
+    {
+        Low = 0,
+        Normal,
+        High,
+        Critical
+    };
+
+    // Mirrored by ScriptAPI::StreamCompression
+    enum class StreamCompression : int32_t
+    {
+        None = 0,
+        Lz4Block // Raw LZ4 block; StreamReadDesc::uncompressedSize is required
+    };
+
+    enum class StreamStatus : int32_t
+    {
+        Pending = 0,
+        Completed,
+        Failed,
+        Cancelled
+    };
+
+    // 0 is never a valid request id.
+    using StreamRequestId = uint64_t;
+
+    struct StreamReadDesc
+    {
+        uint64_t offset = 0;
+        uint64_t length = 0; // 0 reads to the end of the file
+        StreamPriority priority = StreamPriority::Normal;
+        StreamCompression compression = StreamCompression::None;
+        uint64_t uncompressedSize = 0;
+    };
+
+    struct StreamCompletion
+    {
+        StreamRequestId id;
+        StreamStatus status;
+    };
+
+    // Asynchronous file reads for engine and script data.
+    // Requests are served by dedicated I/O threads in priority order (FIFO within a
+    // priority), so blocking reads never occupy the compute ThreadPool. Decompression also
+    // happens on the I/O thread. Uncompressed reads of large files are memory-mapped and
+    // handed out as views into the mapping without a copy.
+    //
+    // The consumer polls for finished requests, reads their bytes through data() and
+    // calls release() when done. All members are thread-safe. The header stays free of
+    // <mutex>/<thread> so the ScriptAPI can include it.
+    class DLL_API StreamService
+    {
+    public:
+        explicit StreamService(size_t ioThreadCount = 2);
+        ~StreamService();
+
+        StreamService(const StreamService&) = delete;
+        StreamService& operator=(const StreamService&) = delete;
+
+        // Process-wide service shared by the engine loop and the ScriptAPI.
+        static StreamService& instance();
+
+        StreamRequestId submit(const std::string& path, const StreamReadDesc& desc = {});
+        // A queued request is dropped at once; one already being read completes as
+        // Cancelled when the read returns. Returns false if it had already finished.
+        bool cancel(StreamRequestId id);
+
+        // Appends requests that finished since the last poll. Each is reported once.
+        size_t poll(std::vector<StreamCompletion>& out);
+
+        // Bytes of a Completed request, valid until release(). Empty otherwise.
+        std::span<const uint8_t> data(StreamRequestId id) const;
+        // Why a request Failed.
+        std::string error(StreamRequestId id) const;
+        // Frees the request's buffer or mapping. Pending requests are cancelled first.
+        void release(StreamRequestId id);
+
+        // Uncompressed reads of files at least this large are mapped rather than copied.
+        void set_map_threshold(uint64_t bytes);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+} // namespace Core
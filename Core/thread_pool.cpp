@@ -0,0 +1,122 @@
+#include "thread_pool.h"
+
+#include <algorithm> // std::max, std::min
+#include <memory>    // std::shared_ptr
+
+namespace Core
+{
+    ThreadPool::ThreadPool(size_t workerCount)
+    {
+        if (workerCount == 0)
+        {
+            unsigned int hw = std::thread::hardware_concurrency();
+            workerCount = hw > 1 ? hw - 1 : 1;
+        }
+
+        workers_.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_)
+        {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    void ThreadPool::worker_loop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    void ThreadPool::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+    {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        const size_t maxChunks = (count + grain - 1) / grain;
+        const size_t chunks = std::min(maxChunks, workers_.size() + 1);
+        if (chunks <= 1)
+        {
+            body(0, count);
+            return;
+        }
+
+        // Chunks are claimed dynamically so a slow worker does not hold up the others.
+        // The state is shared because helpers may still be dequeued after we return.
+        struct State
+        {
+            std::atomic<size_t> next{ 0 };
+            std::atomic<size_t> done{ 0 };
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        auto state = std::make_shared<State>();
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+        const auto* bodyPtr = &body;
+
+        auto run = [state, chunkSize, chunks, count, bodyPtr]
+        {
+            for (;;)
+            {
+                size_t chunk = state->next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks) return;
+
+                size_t begin = chunk * chunkSize;
+                size_t end = std::min(begin + chunkSize, count);
+                if (begin < end) (*bodyPtr)(begin, end);
+
+                if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks)
+                {
+                    std::lock_guard lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        for (size_t i = 1; i < chunks; ++i)
+        {
+            submit(run);
+        }
+        run();
+
+        std::unique_lock lock(state->mutex);
+        state->finished.wait(lock, [&] { return state->done.load(std::memory_order_acquire) == chunks; });
+    }
+
+} // namespace Core
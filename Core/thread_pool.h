@@ -0,0 +1,52 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Note: <mutex>/<thread> cannot be compiled with /clr, so this header is for native
+// translation units only. Managed code reaches the pool through the subsystems using it.
+
+namespace Core
+{
+    // Fixed set of worker threads shared by the engine's parallel subsystems.
+    class DLL_API ThreadPool
+    {
+    public:
+        // workerCount == 0 picks hardware_concurrency() - 1 (at least one worker).
+        explicit ThreadPool(size_t workerCount = 0);
+        ~ThreadPool();
+
+        // Non-copyable
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Process-wide pool.
+        static ThreadPool& instance();
+
+        // Queues a fire-and-forget task.
+        void submit(std::function<void()> task);
+
+        // Splits [0, count) into chunks of at least 'grain' items and runs them on the
+        // workers and the calling thread. Returns once every chunk has finished.
+        void parallel_for(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+
+        size_t worker_count() const { return workers_.size(); }
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+    };
+
+} // namespace Core
@@ -0,0 +1,351 @@
+#include "transform_hierarchy.h"
+#include "thread_pool.h"
+
+#include <algorithm> // std::fill
+
+namespace Core
+{
+    namespace
+    {
+        // Levels smaller than this are updated on the calling thread.
+        constexpr size_t kParallelGrain = 1024;
+
+        template <typename T>
+        void apply_permutation(std::vector<T>& values, const std::vector<uint32_t>& newIndexOf)
+        {
+            std::vector<T> sorted(values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                sorted[newIndexOf[i]] = std::move(values[i]);
+            }
+            values.swap(sorted);
+        }
+
+        // A span is either empty (component not touched) or matches the id count.
+        template <typename T>
+        bool span_fits(std::span<T> values, size_t count)
+        {
+            return values.empty() || values.size() == count;
+        }
+    }
+
+    TransformHierarchy& TransformHierarchy::instance()
+    {
+        static TransformHierarchy hierarchy;
+        return hierarchy;
+    }
+
+    uint32_t TransformHierarchy::append_node(int entityId)
+    {
+        uint32_t node = static_cast<uint32_t>(entity_.size());
+        entity_.push_back(entityId);
+        parentEntity_.push_back(-1);
+        parent_.push_back(-1);
+        localPosition_.push_back({ 0.0f, 0.0f, 0.0f });
+        localRotation_.push_back(Math::quat_identity());
+        localScale_.push_back({ 1.0f, 1.0f, 1.0f });
+        world_.push_back(Math::float4x4_identity());
+        dirty_.push_back(1);
+        worldChanged_.push_back(0);
+        nodeOf_.emplace(entityId, node);
+        return node;
+    }
+
+    void TransformHierarchy::add(int entityId)
+    {
+        if (contains(entityId)) return;
+        append_node(entityId);
+        orderDirty_ = true;
+    }
+
+    bool TransformHierarchy::remove(int entityId)
+    {
+        auto found = nodeOf_.find(entityId);
+        if (found == nodeOf_.end()) return false;
+
+        // Detach children first; they keep their local transform as a root.
+        for (uint32_t i = 0; i < entity_.size(); ++i)
+        {
+            if (parentEntity_[i] == entityId)
+            {
+                parentEntity_[i] = -1;
+                mark_dirty(i);
+            }
+        }
+
+        uint32_t node = found->second;
+        uint32_t last = static_cast<uint32_t>(entity_.size() - 1);
+        nodeOf_.erase(found);
+
+        if (node != last)
+        {
+            entity_[node] = entity_[last];
+            parentEntity_[node] = parentEntity_[last];
+            localPosition_[node] = localPosition_[last];
+            localRotation_[node] = localRotation_[last];
+            localScale_[node] = localScale_[last];
+            world_[node] = world_[last];
+            dirty_[node] = dirty_[last];
+            nodeOf_[entity_[node]] = node;
+        }
+
+        entity_.pop_back();
+        parentEntity_.pop_back();
+        parent_.pop_back();
+        localPosition_.pop_back();
+        localRotation_.pop_back();
+        localScale_.pop_back();
+        world_.pop_back();
+        dirty_.pop_back();
+        worldChanged_.pop_back();
+
+        orderDirty_ = true;
+        return true;
+    }
+
+    bool TransformHierarchy::set_parent(int entityId, int parentId)
+    {
+        auto found = nodeOf_.find(entityId);
+        if (found == nodeOf_.end()) return false;
+        if (parentId == entityId) return false;
+
+        if (parentId != -1)
+        {
+            // Walk up from the new parent; meeting the entity itself means a cycle.
+            int ancestor = parentId;
+            while (ancestor != -1)
+            {
+                auto ancestorNode = nodeOf_.find(ancestor);
+                if (ancestorNode == nodeOf_.end()) return false;
+                if (ancestor == entityId) return false;
+                ancestor = parentEntity_[ancestorNode->second];
+            }
+        }
+
+        uint32_t node = found->second;
+        if (parentEntity_[node] == parentId) return true;
+
+        parentEntity_[node] = parentId;
+        mark_dirty(node);
+        orderDirty_ = true;
+        return true;
+    }
+
+    int TransformHierarchy::get_parent(int entityId) const
+    {
+        auto found = nodeOf_.find(entityId);
+        return found == nodeOf_.end() ? -1 : parentEntity_[found->second];
+    }
+
+    void TransformHierarchy::clear()
+    {
+        entity_.clear();
+        parentEntity_.clear();
+        parent_.clear();
+        localPosition_.clear();
+        localRotation_.clear();
+        localScale_.clear();
+        world_.clear();
+        dirty_.clear();
+        worldChanged_.clear();
+        levelStart_.clear();
+        changed_.clear();
+        nodeOf_.clear();
+        orderDirty_ = false;
+    }
+
+    bool TransformHierarchy::set_local(int entityId, const Math::float3& position, const Math::quat& rotation, const Math::float3& scale)
+    {
+        auto found = nodeOf_.find(entityId);
+        if (found == nodeOf_.end()) return false;
+
+        uint32_t node = found->second;
+        localPosition_[node] = position;
+        localRotation_[node] = rotation;
+        localScale_[node] = scale;
+        mark_dirty(node);
+        return true;
+    }
+
+    bool TransformHierarchy::get_local(int entityId, Math::float3& position, Math::quat& rotation, Math::float3& scale) const
+    {
+        auto found = nodeOf_.find(entityId);
+        if (found == nodeOf_.end()) return false;
+
+        uint32_t node = found->second;
+        position = localPosition_[node];
+        rotation = localRotation_[node];
+        scale = localScale_[node];
+        return true;
+    }
+
+    bool TransformHierarchy::get_world(int entityId, Math::float4x4& world) const
+    {
+        auto found = nodeOf_.find(entityId);
+        if (found == nodeOf_.end()) return false;
+        world = world_[found->second];
+        return true;
+    }
+
+    size_t TransformHierarchy::set_local_bulk(std::span<const int> entityIds,
+                                              std::span<const Math::float3> positions,
+                                              std::span<const Math::quat> rotations,
+                                              std::span<const Math::float3> scales)
+    {
+        const size_t count = entityIds.size();
+        if (!span_fits(positions, count) || !span_fits(rotations, count) || !span_fits(scales, count)) return 0;
+
+        size_t written = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto found = nodeOf_.find(entityIds[i]);
+            if (found == nodeOf_.end()) continue;
+
+            uint32_t node = found->second;
+            if (!positions.empty()) localPosition_[node] = positions[i];
+            if (!rotations.empty()) localRotation_[node] = rotations[i];
+            if (!scales.empty()) localScale_[node] = scales[i];
+            mark_dirty(node);
+            ++written;
+        }
+        return written;
+    }
+
+    size_t TransformHierarchy::get_local_bulk(std::span<const int> entityIds,
+                                              std::span<Math::float3> positions,
+                                              std::span<Math::quat> rotations,
+                                              std::span<Math::float3> scales) const
+    {
+        const size_t count = entityIds.size();
+        if (!span_fits(positions, count) || !span_fits(rotations, count) || !span_fits(scales, count)) return 0;
+
+        size_t read = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto found = nodeOf_.find(entityIds[i]);
+            if (found == nodeOf_.end()) continue;
+
+            uint32_t node = found->second;
+            if (!positions.empty()) positions[i] = localPosition_[node];
+            if (!rotations.empty()) rotations[i] = localRotation_[node];
+            if (!scales.empty()) scales[i] = localScale_[node];
+            ++read;
+        }
+        return read;
+    }
+
+    size_t TransformHierarchy::get_world_bulk(std::span<const int> entityIds, std::span<Math::float4x4> worlds) const
+    {
+        if (worlds.size() != entityIds.size()) return 0;
+
+        size_t read = 0;
+        for (size_t i = 0; i < entityIds.size(); ++i)
+        {
+            auto found = nodeOf_.find(entityIds[i]);
+            if (found == nodeOf_.end()) continue;
+            worlds[i] = world_[found->second];
+            ++read;
+        }
+        return read;
+    }
+
+    void TransformHierarchy::rebuild_order()
+    {
+        const size_t count = entity_.size();
+
+        // Depth of every node, resolving each parent chain once.
+        std::vector<int32_t> depth(count, -1);
+        std::vector<uint32_t> chain;
+        uint32_t maxDepth = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t node = i;
+            chain.clear();
+            while (depth[node] < 0)
+            {
+                chain.push_back(node);
+                int parentEntity = parentEntity_[node];
+                if (parentEntity == -1) break;
+                node = nodeOf_.at(parentEntity);
+            }
+
+            int32_t d = depth[node] >= 0 ? depth[node] : -1;
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                depth[*it] = ++d;
+            }
+            maxDepth = std::max<uint32_t>(maxDepth, static_cast<uint32_t>(depth[i]));
+        }
+
+        // Counting sort by depth; stable, so siblings keep their relative order.
+        levelStart_.assign(count > 0 ? maxDepth + 2 : 1, 0);
+        for (uint32_t i = 0; i < count; ++i) ++levelStart_[depth[i] + 1];
+        for (size_t d = 1; d < levelStart_.size(); ++d) levelStart_[d] += levelStart_[d - 1];
+
+        std::vector<uint32_t> cursor(levelStart_.begin(), levelStart_.end() - 1);
+        std::vector<uint32_t> newIndexOf(count);
+        for (uint32_t i = 0; i < count; ++i) newIndexOf[i] = cursor[depth[i]]++;
+
+        apply_permutation(entity_, newIndexOf);
+        apply_permutation(parentEntity_, newIndexOf);
+        apply_permutation(localPosition_, newIndexOf);
+        apply_permutation(localRotation_, newIndexOf);
+        apply_permutation(localScale_, newIndexOf);
+        apply_permutation(world_, newIndexOf);
+        apply_permutation(dirty_, newIndexOf);
+
+        for (uint32_t i = 0; i < count; ++i) nodeOf_[entity_[i]] = i;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            parent_[i] = parentEntity_[i] == -1 ? -1 : static_cast<int32_t>(nodeOf_.at(parentEntity_[i]));
+        }
+
+        orderDirty_ = false;
+    }
+
+    void TransformHierarchy::update_range(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            int32_t parent = parent_[i];
+            if (!dirty_[i] && (parent < 0 || !worldChanged_[parent]))
+            {
+                worldChanged_[i] = 0;
+                continue;
+            }
+
+            Math::float4x4 local = Math::trs(localPosition_[i], localRotation_[i], localScale_[i]);
+            world_[i] = parent < 0 ? local : Math::mul(world_[parent], local);
+            worldChanged_[i] = 1;
+        }
+    }
+
+    void TransformHierarchy::update()
+    {
+        if (orderDirty_) rebuild_order();
+        changed_.clear();
+        if (entity_.empty()) return;
+
+        // Levels run in order; each level only reads parents from earlier, finished levels.
+        for (size_t level = 0; level + 1 < levelStart_.size(); ++level)
+        {
+            const size_t begin = levelStart_[level];
+            const size_t end = levelStart_[level + 1];
+            if (end - begin < kParallelGrain * 2)
+            {
+                update_range(begin, end);
+                continue;
+            }
+
+            ThreadPool::instance().parallel_for(end - begin, kParallelGrain,
+                [this, begin](size_t chunkBegin, size_t chunkEnd) { update_range(begin + chunkBegin, begin + chunkEnd); });
+        }
+
+        for (size_t i = 0; i < entity_.size(); ++i)
+        {
+            if (worldChanged_[i]) changed_.push_back(entity_[i]);
+        }
+        std::fill(dirty_.begin(), dirty_.end(), uint8_t(0));
+    }
+
+} // namespace Core
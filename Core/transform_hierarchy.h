@@ -0,0 +1,89 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "simd_math.h"
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+    // Parent/child transforms for entities.
+    // Nodes are stored as SoA arrays sorted by depth, so every level is a contiguous range
+    // whose parents all live in earlier ranges. update() walks the levels in order and
+    // only recomputes nodes that were written to or whose parent's world matrix changed;
+    // large levels are split across the thread pool.
+    class DLL_API TransformHierarchy
+    {
+    public:
+        TransformHierarchy() = default;
+
+        // Process-wide hierarchy shared by the engine loop and the ScriptAPI.
+        static TransformHierarchy& instance();
+
+        // --- Structure ---
+        // Adds the entity as a root with an identity local transform. No-op if present.
+        void add(int entityId);
+        // Children of a removed entity become roots and keep their local transform.
+        bool remove(int entityId);
+        // parentId == -1 detaches. Fails if either entity is unknown or a cycle would form.
+        bool set_parent(int entityId, int parentId);
+        int get_parent(int entityId) const;
+        bool contains(int entityId) const { return nodeOf_.count(entityId) != 0; }
+        size_t size() const { return entity_.size(); }
+        // All entities, parents before children as of the last update().
+        std::span<const int> entities() const { return entity_; }
+        void clear();
+
+        // --- Single access ---
+        bool set_local(int entityId, const Math::float3& position, const Math::quat& rotation, const Math::float3& scale);
+        bool get_local(int entityId, Math::float3& position, Math::quat& rotation, Math::float3& scale) const;
+        // World matrices are as of the last update().
+        bool get_world(int entityId, Math::float4x4& world) const;
+
+        // --- Bulk access ---
+        // All spans must have the same length as 'entityIds'. Unknown entities are skipped
+        // (writes) or left untouched (reads). Returns the number of entities processed.
+        size_t set_local_bulk(std::span<const int> entityIds,
+                              std::span<const Math::float3> positions,
+                              std::span<const Math::quat> rotations,
+                              std::span<const Math::float3> scales);
+        size_t get_local_bulk(std::span<const int> entityIds,
+                              std::span<Math::float3> positions,
+                              std::span<Math::quat> rotations,
+                              std::span<Math::float3> scales) const;
+        size_t get_world_bulk(std::span<const int> entityIds, std::span<Math::float4x4> worlds) const;
+
+        // Recomputes dirty world matrices level by level.
+        void update();
+
+        // Entities whose world matrix changed during the last update().
+        std::span<const int> changed_entities() const { return changed_; }
+
+    private:
+        uint32_t append_node(int entityId);
+        void mark_dirty(uint32_t node) { dirty_[node] = 1; }
+        void rebuild_order();
+        void update_range(size_t begin, size_t end);
+
+        // SoA node storage, indexed by node. Depth-sorted after rebuild_order().
+        std::vector<int> entity_;
+        std::vector<int> parentEntity_;
+        std::vector<int32_t> parent_; // node index of the parent, -1 for roots
+        std::vector<Math::float3> localPosition_;
+        std::vector<Math::quat> localRotation_;
+        std::vector<Math::float3> localScale_;
+        std::vector<Math::float4x4> world_;
+        std::vector<uint8_t> dirty_;
+        std::vector<uint8_t> worldChanged_;
+
+        // levelStart_[d] .. levelStart_[d + 1] is the node range at depth d
+        std::vector<uint32_t> levelStart_;
+        std::vector<int> changed_;
+
+        std::unordered_map<int, uint32_t> nodeOf_;
+        bool orderDirty_ = false;
+    };
+
+} // namespace Core
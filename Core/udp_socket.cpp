@@ -0,0 +1,159 @@
+#include "udp_socket.h"
+
+#include <iostream> // For basic error output
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #include <mstcpip.h> // SIO_UDP_CONNRESET
+    using NativeSocket = SOCKET;
+    using SocketLength = int;
+#else
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    using NativeSocket = int;
+    using SocketLength = socklen_t;
+#endif
+
+namespace Core
+{
+    namespace
+    {
+        NativeSocket native(intptr_t handle) { return static_cast<NativeSocket>(handle); }
+
+        bool ensure_sockets_initialized()
+        {
+#if defined(_WIN32)
+            static const bool initialized = [] {
+                WSADATA data;
+                return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+            }();
+            return initialized;
+#else
+            return true;
+#endif
+        }
+
+        void close_native(intptr_t handle)
+        {
+#if defined(_WIN32)
+            closesocket(native(handle));
+#else
+            ::close(native(handle));
+#endif
+        }
+
+        bool set_non_blocking(intptr_t handle)
+        {
+#if defined(_WIN32)
+            u_long enabled = 1;
+            return ioctlsocket(native(handle), FIONBIO, &enabled) == 0;
+#else
+            int flags = fcntl(native(handle), F_GETFL, 0);
+            return flags >= 0 && fcntl(native(handle), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+        }
+
+        // An earlier send to a closed port must not fail later receives
+        void ignore_port_unreachable(intptr_t handle)
+        {
+#if defined(_WIN32)
+            BOOL report = FALSE;
+            DWORD bytes = 0;
+            WSAIoctl(native(handle), SIO_UDP_CONNRESET, &report, sizeof(report), nullptr, 0, &bytes, nullptr, nullptr);
+#else
+            (void)handle; // Unconnected UDP sockets don't report it
+#endif
+        }
+
+        bool would_block()
+        {
+#if defined(_WIN32)
+            int error = WSAGetLastError();
+            return error == WSAEWOULDBLOCK || error == WSAECONNRESET;
+#else
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED;
+#endif
+        }
+
+        sockaddr_in loopback_address(uint16_t port)
+        {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+            return address;
+        }
+    }
+
+    LoopbackUdpSocket::~LoopbackUdpSocket()
+    {
+        close();
+    }
+
+    bool LoopbackUdpSocket::open(uint16_t port)
+    {
+        close();
+        if (!ensure_sockets_initialized()) return false;
+
+        intptr_t handle = static_cast<intptr_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+        if (handle == kInvalidHandle)
+        {
+            std::cerr << "Error: Failed to create UDP socket" << std::endl;
+            return false;
+        }
+
+        sockaddr_in address = loopback_address(port);
+        SocketLength length = sizeof(address);
+        if (bind(native(handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            getsockname(native(handle), reinterpret_cast<sockaddr*>(&address), &length) != 0 ||
+            !set_non_blocking(handle))
+        {
+            std::cerr << "Error: Failed to bind UDP socket to 127.0.0.1:" << port << std::endl;
+            close_native(handle);
+            return false;
+        }
+
+        ignore_port_unreachable(handle);
+        // Room for a burst of datagrams between two receive loops
+        int receiveBuffer = 1 << 20;
+        setsockopt(native(handle), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&receiveBuffer), sizeof(receiveBuffer));
+        handle_ = handle;
+        port_ = ntohs(address.sin_port);
+        return true;
+    }
+
+    void LoopbackUdpSocket::close()
+    {
+        if (handle_ != kInvalidHandle) close_native(handle_);
+        handle_ = kInvalidHandle;
+        port_ = 0;
+    }
+
+    bool LoopbackUdpSocket::send_to(uint16_t port, std::span<const uint8_t> datagram)
+    {
+        if (!is_open()) return false;
+        sockaddr_in address = loopback_address(port);
+        auto sent = sendto(native(handle_), reinterpret_cast<const char*>(datagram.data()), static_cast<int>(datagram.size()), 0,
+                           reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        return sent == static_cast<decltype(sent)>(datagram.size());
+    }
+
+    int LoopbackUdpSocket::receive(std::span<uint8_t> buffer, uint16_t* fromPort)
+    {
+        if (!is_open()) return -1;
+        sockaddr_in address{};
+        SocketLength length = sizeof(address);
+        auto received = recvfrom(native(handle_), reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0,
+                                 reinterpret_cast<sockaddr*>(&address), &length);
+        if (received < 0) return would_block() ? 0 : -1;
+        if (fromPort) *fromPort = ntohs(address.sin_port);
+        return static_cast<int>(received);
+    }
+
+} // namespace Core
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include <cstdint>
+#include <span>
+
+namespace Core
+{
+    // Non-blocking UDP socket bound to 127.0.0.1. A test transport for network code
+    // (e.g. replication) within one process or between local processes.
+    class DLL_API LoopbackUdpSocket
+    {
+    public:
+        LoopbackUdpSocket() = default;
+        ~LoopbackUdpSocket();
+
+        LoopbackUdpSocket(const LoopbackUdpSocket&) = delete;
+        LoopbackUdpSocket& operator=(const LoopbackUdpSocket&) = delete;
+
+        // Port 0 picks a free port; see port().
+        bool open(uint16_t port = 0);
+        void close();
+        bool is_open() const { return handle_ != kInvalidHandle; }
+        uint16_t port() const { return port_; }
+
+        bool send_to(uint16_t port, std::span<const uint8_t> datagram);
+        // Returns the size of the next waiting datagram (truncated to the buffer), 0 if none
+        // is waiting and -1 on error.
+        int receive(std::span<uint8_t> buffer, uint16_t* fromPort = nullptr);
+
+        static constexpr intptr_t kInvalidHandle = -1;
+
+    private:
+        intptr_t handle_ = kInvalidHandle;
+        uint16_t port_ = 0;
+    };
+
+} // namespace Core
@@ -0,0 +1,193 @@
+#include "world_export.h"
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace Core
+{
+    using namespace WorldExport;
+
+    namespace
+    {
+        FrameHeader* frame_header(uint8_t* buffer) { return reinterpret_cast<FrameHeader*>(buffer); }
+        const FrameHeader* frame_header(const uint8_t* buffer) { return reinterpret_cast<const FrameHeader*>(buffer); }
+    }
+
+    // --- WorldExporter ---
+
+    bool WorldExporter::open(const std::string& name, uint32_t capacity)
+    {
+        close();
+        if (capacity == 0 || capacity > max_capacity()) {
+            std::cerr << "Error: World export '" << name << "' needs a capacity of 1 to " << max_capacity()
+                      << " entities, got " << capacity << "." << std::endl;
+            return false;
+        }
+        if (!memory_.create(name, region_bytes(capacity))) return false;
+
+        // Rebuild the header in place; a reader of a previous run sees the magic change last
+        uint8_t* data = memory_.data();
+        std::memset(data, 0, first_buffer_offset());
+        header_ = new (data) RegionHeader{};
+        header_->versionMajor = kVersionMajor;
+        header_->versionMinor = kVersionMinor;
+        header_->capacity = capacity;
+        header_->bufferBytes = static_cast<uint32_t>(buffer_bytes(capacity));
+        header_->writerAlive = 1;
+        for (uint32_t i = 0; i < kBufferCount; ++i) {
+            FrameHeader* frame = new (buffer(i)) FrameHeader{};
+            frame->sequence.store(0, std::memory_order_relaxed);
+        }
+        capacity_ = capacity;
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = kMagic;
+        return true;
+    }
+
+    void WorldExporter::close()
+    {
+        if (header_ != nullptr) {
+            header_->writerAlive = 0;
+            std::atomic_thread_fence(std::memory_order_release);
+            header_ = nullptr;
+        }
+        memory_.close();
+        capacity_ = 0;
+    }
+
+    uint8_t* WorldExporter::buffer(uint32_t index) const
+    {
+        return memory_.data() + first_buffer_offset() + static_cast<size_t>(index) * header_->bufferBytes;
+    }
+
+    void WorldExporter::publish(const TransformHierarchy& transforms, FrameStats stats)
+    {
+        if (header_ == nullptr) return;
+
+        std::span<const int> entities = transforms.entities();
+        uint32_t exported = static_cast<uint32_t>(std::min<size_t>(entities.size(), capacity_));
+        stats.entityCount = static_cast<uint32_t>(entities.size());
+        stats.exportedEntities = exported;
+
+        uint32_t target = (header_->latest.load(std::memory_order_relaxed) + 1) % kBufferCount;
+        uint8_t* data = buffer(target);
+        FrameHeader* frame = frame_header(data);
+
+        // Odd sequence: readers that started on this buffer a frame ago will retry
+        uint64_t sequence = frame->sequence.load(std::memory_order_relaxed);
+        frame->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        frame->stats = stats;
+        int32_t* ids = reinterpret_cast<int32_t*>(data + ids_offset());
+        Math::float4x4* worlds = reinterpret_cast<Math::float4x4*>(data + worlds_offset(capacity_));
+        std::memcpy(ids, entities.data(), exported * sizeof(int32_t));
+        transforms.get_world_bulk(entities.first(exported), std::span<Math::float4x4>(worlds, exported));
+
+        frame->sequence.store(sequence + 2, std::memory_order_release);
+        header_->latest.store(target, std::memory_order_release);
+        header_->publishCount.fetch_add(1, std::memory_order_release);
+    }
+
+    // --- WorldExportReader ---
+
+    bool WorldExportReader::open(const std::string& name)
+    {
+        close();
+        if (!memory_.open_read_only(name)) {
+            error_ = "No world export named '" + name + "'";
+            return false;
+        }
+
+        const RegionHeader* header = reinterpret_cast<const RegionHeader*>(memory_.data());
+        if (memory_.size() < first_buffer_offset() || header->magic != kMagic) {
+            error_ = "'" + name + "' is not a world export (or the engine is still creating it)";
+            memory_.close();
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->versionMajor != kVersionMajor) {
+            error_ = "'" + name + "' uses layout version " + std::to_string(header->versionMajor) +
+                     ", this reader supports " + std::to_string(kVersionMajor);
+            memory_.close();
+            return false;
+        }
+        if (memory_.size() < region_bytes(header->capacity)) {
+            error_ = "'" + name + "' is smaller than its header says";
+            memory_.close();
+            return false;
+        }
+        if (header->bufferBytes != buffer_bytes(header->capacity)) {
+            error_ = "'" + name + "' has a buffer size that doesn't match its capacity";
+            memory_.close();
+            return false;
+        }
+
+        header_ = header;
+        capacity_ = header->capacity; // The engine never changes these; don't trust later reads
+        bufferBytes_ = header->bufferBytes;
+        error_.clear();
+        tornReads_ = 0;
+        return true;
+    }
+
+    void WorldExportReader::close()
+    {
+        header_ = nullptr;
+        memory_.close();
+    }
+
+    uint64_t WorldExportReader::publish_count() const
+    {
+        return header_ == nullptr ? 0 : header_->publishCount.load(std::memory_order_acquire);
+    }
+
+    bool WorldExportReader::writer_alive() const
+    {
+        if (header_ == nullptr) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return header_->writerAlive != 0;
+    }
+
+    bool WorldExportReader::read(Frame& out, int attempts)
+    {
+        if (header_ == nullptr || publish_count() == 0) return false;
+
+        uint32_t capacity = capacity_;
+        for (int attempt = 0; attempt < attempts; ++attempt) {
+            uint32_t index = header_->latest.load(std::memory_order_acquire);
+            if (index >= kBufferCount) {
+                error_ = "World export names buffer " + std::to_string(index) + " as the latest";
+                return false;
+            }
+            const uint8_t* data = memory_.data() + first_buffer_offset() + static_cast<size_t>(index) * bufferBytes_;
+            const FrameHeader* frame = frame_header(data);
+
+            uint64_t before = frame->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                ++tornReads_;
+                continue;
+            }
+
+            FrameStats stats;
+            std::memcpy(&stats, &frame->stats, sizeof(stats));
+            uint32_t count = std::min(stats.exportedEntities, capacity);
+            out.entityIds.resize(count);
+            out.worlds.resize(count);
+            std::memcpy(out.entityIds.data(), data + ids_offset(), count * sizeof(int32_t));
+            std::memcpy(out.worlds.data(), data + worlds_offset(capacity), count * sizeof(Math::float4x4));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (frame->sequence.load(std::memory_order_relaxed) == before) {
+                out.stats = stats;
+                return true;
+            }
+            ++tornReads_; // The engine came back around to this buffer while we copied
+        }
+        return false;
+    }
+
+} // namespace Core
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "shared_memory.h"
+#include "simd_math.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-frame world state published into shared memory for out-of-process tools
+// (dashboards, analytics sidecars, debuggers).
+//
+//   RegionHeader
+//   FrameBuffer[2]   -- FrameHeader, then entityIds[capacity], then worlds[capacity]
+//
+// The engine writes each frame into the buffer readers are not pointed at, then makes it
+// the latest one. Each buffer also carries a sequence number that is odd while it is being
+// written (a seqlock), so a reader that was slower than a whole frame notices the overwrite
+// and retries instead of returning a torn copy. Writing never waits for readers.
+
+namespace Core::WorldExport
+{
+    constexpr uint32_t kMagic = 0x58455753; // "SWEX"
+    constexpr uint16_t kVersionMajor = 1;
+    constexpr uint16_t kVersionMinor = 0;
+    constexpr uint32_t kBufferCount = 2;
+
+    // Engine-wide numbers for the frame
+    struct FrameStats
+    {
+        uint64_t frameIndex;
+        double uptimeSeconds;
+        double frameSeconds;       // Simulation time of the frame, without the limiter sleep
+        uint32_t entityCount;      // In the transform hierarchy; may exceed what was exported
+        uint32_t exportedEntities; // min(entityCount, capacity)
+        uint64_t scriptErrors;     // Total since start
+        uint64_t hitches;          // Total since start
+    };
+
+    struct FrameHeader
+    {
+        std::atomic<uint64_t> sequence; // Odd while the buffer is being written
+        FrameStats stats;
+    };
+
+    struct RegionHeader
+    {
+        uint32_t magic;
+        uint16_t versionMajor;
+        uint16_t versionMinor;
+        uint32_t capacity;    // Entities per buffer
+        uint32_t bufferBytes; // Stride between buffers
+        std::atomic<uint32_t> latest;     // Buffer holding the newest complete frame
+        uint32_t writerAlive;             // Cleared when the engine closes the export
+        std::atomic<uint64_t> publishCount;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared counters must be lock-free");
+
+    constexpr size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+    constexpr size_t ids_offset() { return align_up(sizeof(FrameHeader), 64); }
+    constexpr size_t worlds_offset(uint32_t capacity) { return align_up(ids_offset() + capacity * sizeof(int32_t), 64); }
+    constexpr size_t buffer_bytes(uint32_t capacity) { return align_up(worlds_offset(capacity) + capacity * sizeof(Math::float4x4), 64); }
+    constexpr size_t first_buffer_offset() { return align_up(sizeof(RegionHeader), 64); }
+    constexpr size_t region_bytes(uint32_t capacity) { return first_buffer_offset() + kBufferCount * buffer_bytes(capacity); }
+
+    // Largest capacity whose buffer stride still fits RegionHeader::bufferBytes (~63M entities)
+    constexpr uint32_t max_capacity()
+    {
+        return static_cast<uint32_t>((UINT32_MAX - ids_offset() - 2 * 64) / (sizeof(int32_t) + sizeof(Math::float4x4)));
+    }
+    static_assert(buffer_bytes(max_capacity()) <= UINT32_MAX, "max_capacity() must keep bufferBytes in range");
+
+    // One frame as copied out by WorldExportReader.
+    struct Frame
+    {
+        FrameStats stats{};
+        std::vector<int32_t> entityIds;
+        std::vector<Math::float4x4> worlds; // Same order as entityIds
+    };
+}
+
+namespace Core
+{
+    class TransformHierarchy;
+
+    // Engine side. publish() copies entity ids with one memcpy and lets the transform
+    // hierarchy write world matrices straight into the shared buffer.
+    class DLL_API WorldExporter
+    {
+    public:
+        ~WorldExporter() { close(); }
+
+        // Creates the region '<name>' with room for 'capacity' entities per frame. Entities
+        // beyond it are left out (stats.exportedEntities says how many made it).
+        bool open(const std::string& name, uint32_t capacity);
+        void close();
+        bool is_open() const { return memory_.is_open(); }
+
+        // Call after the transform update. Fills in entityCount and exportedEntities.
+        void publish(const TransformHierarchy& transforms, WorldExport::FrameStats stats);
+
+    private:
+        uint8_t* buffer(uint32_t index) const;
+
+        SharedMemory memory_;
+        WorldExport::RegionHeader* header_ = nullptr;
+        uint32_t capacity_ = 0;
+    };
+
+    // Tool side: maps the region read-only and copies out the latest complete frame.
+    class DLL_API WorldExportReader
+    {
+    public:
+        // False if no engine is exporting under 'name', the layout version differs or the
+        // header doesn't describe a valid region.
+        bool open(const std::string& name);
+        void close();
+        bool is_open() const { return header_ != nullptr; }
+        const std::string& error() const { return error_; }
+
+        // Frames published so far; cheap to poll before read().
+        uint64_t publish_count() const;
+        // False once the engine closed the export (or exited cleanly).
+        bool writer_alive() const;
+
+        // Copies the newest complete frame into 'out'. Returns false if nothing was
+        // published yet, if the engine overwrote the buffer during every attempt, or if
+        // the header is corrupt (see error()).
+        bool read(WorldExport::Frame& out, int attempts = 4);
+        // Attempts that found their buffer overwritten mid-copy, since open().
+        uint64_t torn_reads() const { return tornReads_; }
+
+    private:
+        SharedMemory memory_;
+        const WorldExport::RegionHeader* header_ = nullptr;
+        uint32_t capacity_ = 0;
+        uint32_t bufferBytes_ = 0;
+        std::string error_;
+        uint64_t tornReads_ = 0;
+    };
+
+} // namespace Core
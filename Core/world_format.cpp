@@ -0,0 +1,243 @@
+#include "world_format.h"
+
+#include <cstdio>     // std::remove
+#include <cstring>    // std::memcpy
+#include <filesystem> // std::filesystem::rename
+#include <iostream>   // For basic error output
+
+namespace Core
+{
+    using namespace WorldFormat;
+
+    // --- WorldWriter ---
+
+    WorldWriter::~WorldWriter()
+    {
+        if (out_.is_open())
+        {
+            abort();
+        }
+    }
+
+    bool WorldWriter::open(const std::string& path)
+    {
+        if (out_.is_open()) abort();
+
+        path_ = path;
+        tempPath_ = path + ".tmp";
+        out_.open(tempPath_, std::ios::binary | std::ios::trunc);
+        if (!out_)
+        {
+            std::cerr << "Error: Failed to open world file for writing: " << tempPath_ << std::endl;
+            return false;
+        }
+
+        FileHeader header{ kMagic, kVersionMajor, kVersionMinor, 0, 0 };
+        bytesWritten_ = 0;
+        inChunk_ = false;
+        write_raw(&header, sizeof(header));
+        return static_cast<bool>(out_);
+    }
+
+    void WorldWriter::write_raw(const void* data, size_t size)
+    {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        bytesWritten_ += size;
+        if (inChunk_) chunk_.size += size;
+    }
+
+    bool WorldWriter::begin_chunk(uint32_t tag)
+    {
+        if (inChunk_ && chunk_.tag == tag && chunk_.size < kTargetChunkBytes) return true;
+        if (inChunk_ && !end_chunk()) return false;
+
+        // The header is written with a zero size and patched in end_chunk().
+        chunkStart_ = out_.tellp();
+        chunk_ = { tag, 0, 0 };
+        write_raw(&chunk_, sizeof(chunk_));
+        inChunk_ = true;
+        chunk_.size = 0;
+        return static_cast<bool>(out_);
+    }
+
+    bool WorldWriter::end_chunk()
+    {
+        if (!inChunk_) return true;
+        inChunk_ = false;
+
+        std::streampos end = out_.tellp();
+        out_.seekp(chunkStart_);
+        out_.write(reinterpret_cast<const char*>(&chunk_), sizeof(chunk_));
+        out_.seekp(end);
+        return static_cast<bool>(out_);
+    }
+
+    bool WorldWriter::write_entity(const EntityRecord& record)
+    {
+        if (!out_.is_open() || !begin_chunk(kTagEntities)) return false;
+        write_raw(&record, sizeof(record));
+        ++chunk_.recordCount;
+        return static_cast<bool>(out_);
+    }
+
+    bool WorldWriter::write_script(int32_t entityId, std::string_view typeName, std::span<const uint8_t> fields)
+    {
+        if (!out_.is_open() || typeName.size() > UINT16_MAX || fields.size() > UINT32_MAX) return false;
+        if (!begin_chunk(kTagScripts)) return false;
+
+        uint16_t nameLength = static_cast<uint16_t>(typeName.size());
+        uint32_t fieldLength = static_cast<uint32_t>(fields.size());
+        write_raw(&entityId, sizeof(entityId));
+        write_raw(&nameLength, sizeof(nameLength));
+        write_raw(typeName.data(), typeName.size());
+        write_raw(&fieldLength, sizeof(fieldLength));
+        if (!fields.empty()) write_raw(fields.data(), fields.size());
+        ++chunk_.recordCount;
+        return static_cast<bool>(out_);
+    }
+
+    bool WorldWriter::finish()
+    {
+        if (!out_.is_open()) return false;
+
+        bool ok = end_chunk();
+        ChunkHeader terminator{ kTagEnd, 0, 0 };
+        write_raw(&terminator, sizeof(terminator));
+        ok = ok && static_cast<bool>(out_);
+        out_.close();
+        if (!ok)
+        {
+            std::remove(tempPath_.c_str());
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath_, path_, ec);
+        if (ec)
+        {
+            std::cerr << "Error: Failed to move world file into place: " << path_ << " (" << ec.message() << ")" << std::endl;
+            std::remove(tempPath_.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void WorldWriter::abort()
+    {
+        if (out_.is_open()) out_.close();
+        if (!tempPath_.empty()) std::remove(tempPath_.c_str());
+        inChunk_ = false;
+    }
+
+    // --- WorldReader ---
+
+    bool WorldReader::open(const std::string& path)
+    {
+        close();
+        if (!file_.open(path))
+        {
+            error_ = "Cannot map " + path;
+            return false;
+        }
+
+        FileHeader header{};
+        if (!read_raw(&header, sizeof(header)) || header.magic != kMagic)
+        {
+            close(); // Before the message, which close() clears
+            error_ = "Not a world file: " + path;
+            return false;
+        }
+        if (header.versionMajor != kVersionMajor)
+        {
+            close();
+            error_ = "Unsupported world file version " + std::to_string(header.versionMajor);
+            return false;
+        }
+
+        versionMinor_ = header.versionMinor;
+        chunkEnd_ = offset_;
+        return true;
+    }
+
+    void WorldReader::close()
+    {
+        file_.close();
+        offset_ = 0;
+        chunkEnd_ = 0;
+        chunkTag_ = 0;
+        error_.clear();
+    }
+
+    bool WorldReader::read_raw(void* out, size_t size)
+    {
+        if (offset_ + size > file_.size()) return false;
+        std::memcpy(out, file_.data() + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    WorldReader::RecordType WorldReader::fail(const char* message)
+    {
+        error_ = message;
+        offset_ = file_.size();
+        chunkEnd_ = offset_;
+        return RecordType::Error;
+    }
+
+    WorldReader::RecordType WorldReader::next(Record& record)
+    {
+        if (!file_.is_open()) return fail("World file not open");
+
+        // Move to the next chunk whose records we understand.
+        while (offset_ >= chunkEnd_)
+        {
+            ChunkHeader chunk{};
+            if (!read_raw(&chunk, sizeof(chunk))) return fail("Truncated world file (missing END chunk)");
+            if (chunk.tag == kTagEnd)
+            {
+                chunkEnd_ = offset_;
+                record.type = RecordType::End;
+                return RecordType::End;
+            }
+            if (chunk.size > file_.size() - offset_) return fail("Chunk extends past end of file");
+
+            chunkTag_ = chunk.tag;
+            chunkEnd_ = offset_ + static_cast<size_t>(chunk.size);
+            if (chunkTag_ != kTagEntities && chunkTag_ != kTagScripts)
+            {
+                offset_ = chunkEnd_; // Unknown chunk from a newer minor version
+            }
+        }
+
+        if (chunkTag_ == kTagEntities)
+        {
+            if (chunkEnd_ - offset_ < sizeof(EntityRecord)) return fail("Malformed entity chunk");
+            read_raw(&record.entity, sizeof(EntityRecord));
+            record.type = RecordType::Entity;
+            return RecordType::Entity;
+        }
+
+        // kTagScripts
+        int32_t entityId = 0;
+        uint16_t nameLength = 0;
+        uint32_t fieldLength = 0;
+        if (!read_raw(&entityId, sizeof(entityId)) || !read_raw(&nameLength, sizeof(nameLength)) ||
+            offset_ + nameLength > chunkEnd_)
+        {
+            return fail("Malformed script record");
+        }
+        const char* name = reinterpret_cast<const char*>(file_.data() + offset_);
+        offset_ += nameLength;
+        if (!read_raw(&fieldLength, sizeof(fieldLength)) || offset_ + fieldLength > chunkEnd_)
+        {
+            return fail("Malformed script record");
+        }
+        const uint8_t* fields = file_.data() + offset_;
+        offset_ += fieldLength;
+
+        record.script = { entityId, std::string_view(name, nameLength), std::span<const uint8_t>(fields, fieldLength) };
+        record.type = RecordType::Script;
+        return RecordType::Script;
+    }
+
+} // namespace Core
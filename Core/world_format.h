@@ -0,0 +1,163 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "mapped_file.h"
+#include "simd_math.h"
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Binary world snapshot format (little-endian):
+//
+//   FileHeader
+//   { ChunkHeader, payload }*   -- any number of ENTS / SCRP chunks, in any order
+//   ChunkHeader(END)            -- terminator, size 0
+//
+// Readers skip chunks with unknown tags, so new record kinds can be added with a minor
+// version bump. A major version bump means existing chunk layouts changed.
+
+namespace Core::WorldFormat
+{
+    constexpr uint32_t make_tag(const char (&s)[5])
+    {
+        return uint32_t(uint8_t(s[0])) | (uint32_t(uint8_t(s[1])) << 8) |
+               (uint32_t(uint8_t(s[2])) << 16) | (uint32_t(uint8_t(s[3])) << 24);
+    }
+
+    constexpr uint32_t kMagic = make_tag("NSWD");
+    constexpr uint16_t kVersionMajor = 1;
+    constexpr uint16_t kVersionMinor = 0;
+
+    constexpr uint32_t kTagEntities = make_tag("ENTS");
+    constexpr uint32_t kTagScripts = make_tag("SCRP");
+    constexpr uint32_t kTagEnd = make_tag("END ");
+
+    // Writers start a new chunk once the current one grows past this size.
+    constexpr uint64_t kTargetChunkBytes = 64 * 1024;
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint16_t versionMajor;
+        uint16_t versionMinor;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    struct ChunkHeader
+    {
+        uint32_t tag;
+        uint32_t recordCount;
+        uint64_t size; // payload bytes following this header
+    };
+
+    // ENTS payload: tightly packed EntityRecords
+    struct EntityRecord
+    {
+        int32_t entityId;
+        int32_t parentId; // -1 for roots
+        Math::float3 position;
+        Math::quat rotation;
+        Math::float3 scale;
+    };
+
+    // SCRP payload, per record:
+    //   int32 entityId, uint16 typeNameLength, typeName bytes, uint32 fieldLength, field bytes
+    // The field blob is opaque to native code; the ScriptAPI serializer owns its layout.
+    struct ScriptRecordView
+    {
+        int32_t entityId;
+        std::string_view typeName;
+        std::span<const uint8_t> fields;
+    };
+
+    static_assert(sizeof(FileHeader) == 16 && sizeof(ChunkHeader) == 16 && sizeof(EntityRecord) == 48,
+                  "World format structs must not change size within a major version");
+
+} // namespace Core::WorldFormat
+
+namespace Core
+{
+    // Streams records to disk chunk by chunk; nothing but the current chunk header is
+    // kept in memory. Output goes to '<path>.tmp' and is renamed over 'path' in finish(),
+    // so a crash mid-save never leaves a truncated snapshot behind.
+    class DLL_API WorldWriter
+    {
+    public:
+        WorldWriter() = default;
+        ~WorldWriter();
+
+        WorldWriter(const WorldWriter&) = delete;
+        WorldWriter& operator=(const WorldWriter&) = delete;
+
+        bool open(const std::string& path);
+        bool write_entity(const WorldFormat::EntityRecord& record);
+        bool write_script(int32_t entityId, std::string_view typeName, std::span<const uint8_t> fields);
+        // Terminates the file and moves it into place.
+        bool finish();
+        // Discards the partially written file.
+        void abort();
+
+        bool is_open() const { return out_.is_open(); }
+        uint64_t bytes_written() const { return bytesWritten_; }
+
+    private:
+        bool begin_chunk(uint32_t tag);
+        bool end_chunk();
+        void write_raw(const void* data, size_t size);
+
+        std::ofstream out_;
+        std::string path_;
+        std::string tempPath_;
+        std::streampos chunkStart_{};
+        WorldFormat::ChunkHeader chunk_{};
+        bool inChunk_ = false;
+        uint64_t bytesWritten_ = 0;
+    };
+
+    // Iterates the records of a memory-mapped snapshot. Script records are views into the
+    // mapping and stay valid until the reader is closed.
+    class DLL_API WorldReader
+    {
+    public:
+        enum class RecordType
+        {
+            Entity,
+            Script,
+            End,
+            Error
+        };
+
+        struct Record
+        {
+            RecordType type = RecordType::End;
+            WorldFormat::EntityRecord entity{};
+            WorldFormat::ScriptRecordView script{};
+        };
+
+        bool open(const std::string& path);
+        void close();
+
+        // Advances to the next record. Returns End after the terminator and Error on
+        // malformed input (see error()).
+        RecordType next(Record& record);
+
+        uint16_t version_minor() const { return versionMinor_; }
+        const std::string& error() const { return error_; }
+        size_t bytes_read() const { return offset_; }
+
+    private:
+        RecordType fail(const char* message);
+        bool read_raw(void* out, size_t size);
+
+        MappedFile file_;
+        size_t offset_ = 0;
+        size_t chunkEnd_ = 0;
+        uint32_t chunkTag_ = 0;
+        uint16_t versionMinor_ = 0;
+        std::string error_;
+    };
+
+} // namespace Core
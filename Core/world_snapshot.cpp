@@ -0,0 +1,271 @@
+#include "world_snapshot.h"
+#include "entity_ids.h"
+#include "transform_hierarchy.h"
+
+#include <iostream> // For basic error output
+
+namespace Core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Reading the clock after every record costs more than small records do.
+        constexpr int kRecordsPerClockCheck = 16;
+        constexpr int kTypeNameCapacity = 256;
+
+        void report_script_error(const char* call, const ScriptCallResult& result)
+        {
+            std::cerr << "Warning: " << call << " returned " << to_string(result.status);
+            if (result.error.scriptType[0] != '\0') std::cerr << " (" << result.error.scriptType << ")";
+            std::cerr << ": " << result.error.message << std::endl;
+        }
+    }
+
+    // --- WorldSaveJob ---
+
+    WorldSaveJob::WorldSaveJob(const TransformHierarchy& transforms, const ScriptSnapshotCallbacks& scripts)
+        : transforms_(transforms)
+        , scripts_(scripts)
+    {
+    }
+
+    WorldSaveJob::~WorldSaveJob()
+    {
+        if (active_) cancel();
+    }
+
+    bool WorldSaveJob::begin(const std::string& path)
+    {
+        if (active_) cancel();
+        if (!writer_.open(path)) return false;
+
+        auto entities = transforms_.entities();
+        entityIds_.assign(entities.begin(), entities.end());
+        nextEntity_ = 0;
+        nextScript_ = 0;
+        scriptCount_ = 0;
+        scriptsCaptured_ = false;
+        entitiesWritten_ = 0;
+        scriptsWritten_ = 0;
+        succeeded_ = false;
+        active_ = true;
+
+        if (scripts_.capture)
+        {
+            int count = 0;
+            ScriptCallResult result = call_script(scripts_.capture, &count);
+            if (!result) report_script_error("CaptureScriptSnapshot", result);
+            scriptCount_ = count;
+            scriptsCaptured_ = true;
+        }
+        return true;
+    }
+
+    bool WorldSaveJob::write_next_entity()
+    {
+        int entityId = entityIds_[nextEntity_++];
+
+        WorldFormat::EntityRecord record{};
+        if (!transforms_.get_local(entityId, record.position, record.rotation, record.scale))
+        {
+            return true; // Removed since begin()
+        }
+        record.entityId = entityId;
+        record.parentId = transforms_.get_parent(entityId);
+
+        if (!writer_.write_entity(record)) return false;
+        ++entitiesWritten_;
+        return true;
+    }
+
+    bool WorldSaveJob::write_next_script()
+    {
+        int index = nextScript_++;
+        char typeName[kTypeNameCapacity];
+        int entityId = -1;
+
+        if (fieldBuffer_.empty()) fieldBuffer_.resize(1024);
+        int length = 0;
+        ScriptCallResult result = call_script(scripts_.serialize, index, &entityId, typeName, kTypeNameCapacity,
+                                              fieldBuffer_.data(), static_cast<int>(fieldBuffer_.size()), &length);
+        if (result && length < 0)
+        {
+            fieldBuffer_.resize(static_cast<size_t>(-length));
+            result = call_script(scripts_.serialize, index, &entityId, typeName, kTypeNameCapacity,
+                                 fieldBuffer_.data(), static_cast<int>(fieldBuffer_.size()), &length);
+            if (result && length < 0) return false;
+        }
+        if (!result)
+        {
+            // One bad script doesn't fail the save; it is left out of the file
+            report_script_error("SerializeSnapshotScript", result);
+            return result.status != ScriptStatus::InternalError;
+        }
+        if (entityId < 0) return true; // Removed since capture()
+
+        if (!writer_.write_script(entityId, typeName, std::span<const uint8_t>(fieldBuffer_.data(), static_cast<size_t>(length))))
+        {
+            return false;
+        }
+        ++scriptsWritten_;
+        return true;
+    }
+
+    bool WorldSaveJob::step(std::chrono::microseconds budget)
+    {
+        if (!active_) return true;
+
+        const auto deadline = Clock::now() + budget;
+        for (int n = 1;; ++n)
+        {
+            bool ok = true;
+            if (nextEntity_ < entityIds_.size())
+            {
+                ok = write_next_entity();
+            }
+            else if (scripts_.serialize && nextScript_ < scriptCount_)
+            {
+                ok = write_next_script();
+            }
+            else
+            {
+                finish(writer_.finish());
+                return true;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "Error: World save failed while writing records." << std::endl;
+                finish(false);
+                return true;
+            }
+            if (n % kRecordsPerClockCheck == 0 && Clock::now() >= deadline) return false;
+        }
+    }
+
+    void WorldSaveJob::cancel()
+    {
+        finish(false);
+    }
+
+    void WorldSaveJob::finish(bool ok)
+    {
+        if (!ok) writer_.abort();
+        if (scriptsCaptured_ && scripts_.release)
+        {
+            ScriptCallResult result = call_script(scripts_.release);
+            if (!result) report_script_error("ReleaseScriptSnapshot", result);
+        }
+        scriptsCaptured_ = false;
+        entityIds_.clear();
+        entityIds_.shrink_to_fit();
+        active_ = false;
+        succeeded_ = ok;
+    }
+
+    // --- WorldLoadJob ---
+
+    WorldLoadJob::WorldLoadJob(TransformHierarchy& transforms, const ScriptSnapshotCallbacks& scripts)
+        : transforms_(transforms)
+        , scripts_(scripts)
+    {
+    }
+
+    bool WorldLoadJob::begin(const std::string& path)
+    {
+        if (active_) cancel();
+        if (!reader_.open(path))
+        {
+            std::cerr << "Error: " << reader_.error() << std::endl;
+            return false;
+        }
+
+        pendingParents_.clear();
+        entitiesLoaded_ = 0;
+        scriptsLoaded_ = 0;
+        succeeded_ = false;
+        active_ = true;
+        return true;
+    }
+
+    void WorldLoadJob::apply_entity(const WorldFormat::EntityRecord& record)
+    {
+        EntityIds::instance().reserve(record.entityId);
+        transforms_.add(record.entityId);
+        transforms_.set_local(record.entityId, record.position, record.rotation, record.scale);
+        if (record.parentId != -1 && !transforms_.set_parent(record.entityId, record.parentId))
+        {
+            pendingParents_.emplace_back(record.entityId, record.parentId);
+        }
+        ++entitiesLoaded_;
+    }
+
+    void WorldLoadJob::apply_script(const WorldFormat::ScriptRecordView& record)
+    {
+        if (!scripts_.restore) return;
+
+        typeName_.assign(record.typeName); // restore() needs a terminated string
+        ScriptCallResult result = call_script(scripts_.restore, record.entityId, typeName_.c_str(),
+                                              record.fields.data(), static_cast<int>(record.fields.size()));
+        if (!result)
+        {
+            report_script_error("RestoreScript", result);
+            // ScriptException: the script exists but kept its default field values
+            if (result.status != ScriptStatus::ScriptException)
+            {
+                std::cerr << "Warning: Could not restore script '" << typeName_ << "' on entity " << record.entityId << std::endl;
+                return;
+            }
+        }
+        ++scriptsLoaded_;
+        if (onScriptRestored) onScriptRestored(record.entityId, typeName_);
+    }
+
+    bool WorldLoadJob::step(std::chrono::microseconds budget)
+    {
+        if (!active_) return true;
+
+        const auto deadline = Clock::now() + budget;
+        WorldReader::Record record;
+        for (int n = 1;; ++n)
+        {
+            switch (reader_.next(record))
+            {
+            case WorldReader::RecordType::Entity:
+                apply_entity(record.entity);
+                break;
+            case WorldReader::RecordType::Script:
+                apply_script(record.script);
+                break;
+            case WorldReader::RecordType::End:
+                for (const auto& [child, parent] : pendingParents_)
+                {
+                    transforms_.set_parent(child, parent);
+                }
+                finish(true);
+                return true;
+            case WorldReader::RecordType::Error:
+                std::cerr << "Error: World load failed: " << reader_.error() << std::endl;
+                finish(false);
+                return true;
+            }
+
+            if (n % kRecordsPerClockCheck == 0 && Clock::now() >= deadline) return false;
+        }
+    }
+
+    void WorldLoadJob::cancel()
+    {
+        finish(false);
+    }
+
+    void WorldLoadJob::finish(bool ok)
+    {
+        reader_.close();
+        pendingParents_.clear();
+        active_ = false;
+        succeeded_ = ok;
+    }
+
+} // namespace Core
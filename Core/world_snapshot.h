@@ -0,0 +1,115 @@
+#pragma once
+
+#include "import_export.h" // For DLL_API
+#include "world_format.h"
+#include "script_call.h" // For ScriptErrorInfo
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    class TransformHierarchy;
+
+    // Managed entry points the snapshot jobs use to reach script state.
+    // These match the ScriptAPI EngineInterface snapshot methods.
+    struct ScriptSnapshotCallbacks
+    {
+        // Each returns a ScriptStatus and describes failures in the trailing ScriptErrorInfo.
+        // Records the current set of scripts and stores how many there are in *count.
+        int32_t (*capture)(int* count, ScriptErrorInfo* error) = nullptr;
+        // Serializes captured script 'index'. *length receives the field byte count, or the
+        // negated required size if 'fieldCapacity' is too small. *entityId stays -1 when the
+        // script was removed since capture() or failed to serialize, and should be skipped.
+        int32_t (*serialize)(int index, int* entityId, char* typeName, int typeNameCapacity,
+                             uint8_t* fields, int fieldCapacity, int* length, ScriptErrorInfo* error) = nullptr;
+        // Drops the references taken by capture().
+        int32_t (*release)(ScriptErrorInfo* error) = nullptr;
+        // Adds a script of the named type to the entity and applies the serialized fields.
+        // ScriptException means the script was added but kept its default field values.
+        int32_t (*restore)(int entityId, const char* typeName, const uint8_t* fields, int fieldLength,
+                           ScriptErrorInfo* error) = nullptr;
+    };
+
+    // Writes the world to disk a slice at a time so checkpoints never stall a frame.
+    // Entity ids and script references are captured in begin(); each record reflects its
+    // entity's state at the frame it is written. Entities added later are not included.
+    class DLL_API WorldSaveJob
+    {
+    public:
+        WorldSaveJob(const TransformHierarchy& transforms, const ScriptSnapshotCallbacks& scripts);
+        ~WorldSaveJob();
+
+        bool begin(const std::string& path);
+        // Writes records until 'budget' is used up. Returns true once the job is finished.
+        bool step(std::chrono::microseconds budget);
+        void cancel();
+
+        bool active() const { return active_; }
+        bool succeeded() const { return succeeded_; }
+        size_t entities_written() const { return entitiesWritten_; }
+        size_t scripts_written() const { return scriptsWritten_; }
+        uint64_t bytes_written() const { return writer_.bytes_written(); }
+
+    private:
+        bool write_next_entity();
+        bool write_next_script();
+        void finish(bool ok);
+
+        const TransformHierarchy& transforms_;
+        ScriptSnapshotCallbacks scripts_;
+        WorldWriter writer_;
+
+        std::vector<int> entityIds_;
+        std::vector<uint8_t> fieldBuffer_;
+        size_t nextEntity_ = 0;
+        int scriptCount_ = 0;
+        int nextScript_ = 0;
+        bool scriptsCaptured_ = false;
+        bool active_ = false;
+        bool succeeded_ = false;
+        size_t entitiesWritten_ = 0;
+        size_t scriptsWritten_ = 0;
+    };
+
+    // Reads a memory-mapped snapshot back into the world over several frames.
+    class DLL_API WorldLoadJob
+    {
+    public:
+        WorldLoadJob(TransformHierarchy& transforms, const ScriptSnapshotCallbacks& scripts);
+
+        bool begin(const std::string& path);
+        // Applies records until 'budget' is used up. Returns true once the job is finished.
+        bool step(std::chrono::microseconds budget);
+        void cancel();
+
+        bool active() const { return active_; }
+        bool succeeded() const { return succeeded_; }
+        const std::string& error() const { return reader_.error(); }
+        size_t entities_loaded() const { return entitiesLoaded_; }
+        size_t scripts_loaded() const { return scriptsLoaded_; }
+
+        // Called for every script that was restored successfully.
+        std::function<void(int entityId, const std::string& typeName)> onScriptRestored;
+
+    private:
+        void apply_entity(const WorldFormat::EntityRecord& record);
+        void apply_script(const WorldFormat::ScriptRecordView& record);
+        void finish(bool ok);
+
+        TransformHierarchy& transforms_;
+        ScriptSnapshotCallbacks scripts_;
+        WorldReader reader_;
+
+        // Parent links whose parent had not been loaded yet
+        std::vector<std::pair<int, int>> pendingParents_;
+        std::string typeName_;
+        bool active_ = false;
+        bool succeeded_ = false;
+        size_t entitiesLoaded_ = 0;
+        size_t scriptsLoaded_ = 0;
+    };
+
+} // namespace Core
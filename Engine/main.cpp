@@ -4,202 +4,821 @@
 #include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
 #include <thread>  // For std::this_thread::sleep_for
 #include <chrono>  // For std::chrono::seconds, milliseconds
-#include <Windows.h> // For GetAsyncKeyState, VK_ESCAPE, VK_SPACE
+#include <string_view>
+#include <cstring> // std::memcpy
+#include <optional>
+#include <Windows.h> // For GetAsyncKeyState, VK_ESCAPE, VK_SPACE, VK_F5
 
 // Include Core library headers
 #include "dot_net_runtime.h" // Correct include path
+#include "native_script_library.h"
 #include "host_utils.h"      // Correct include path
+#include "spatial_index.h"
+#include "transform_hierarchy.h"
+#include "world_snapshot.h"
+#include "script_call.h"
+#include "entity_ids.h"
+#include "metrics.h"
+#include "metrics_exporter.h"
+#include "control_channel.h"
+#include "shutdown_signal.h"
+#include "steady_state_tracker.h"
+#include "replication.h"
+#include "udp_socket.h"
+#include "frame_watchdog.h"
+#include "activation_regions.h"
+#include "world_export.h"
+#include "navigation.h"
 
-// Define the function pointer types for the managed delegates
-using InitDelegate = bool(*)();
-using ShutdownDelegate = void(*)();
-using ReloadDelegate = bool(*)(); // Delegate for Reload
-using AddScriptDelegate = bool(*)(int, const char*);
-using ExecuteStartDelegate = void(*)(int);
-using ExecuteUpdateDelegate = void(*)();
+// Define the function pointer types for the managed delegates.
+// Each returns a Core::ScriptStatus and fills the trailing ScriptErrorInfo on failure;
+// see script_call.h. Call them through Core::call_script().
+using InitDelegate = int32_t(*)(Core::ScriptErrorInfo*);
+using ShutdownDelegate = int32_t(*)(Core::ScriptErrorInfo*);
+using ReloadDelegate = int32_t(*)(Core::ScriptErrorInfo*); // Delegate for Reload
+using GetScriptTypeIdDelegate = int32_t(*)(const char*); // Returns -1 if unknown, never fails otherwise
+using AddScriptByIdDelegate = int32_t(*)(int, int, Core::ScriptErrorInfo*);
+using RunPendingStartsDelegate = int32_t(*)(int, Core::ScriptErrorInfo*); // Budget in microseconds
+using ExecutePhaseDelegate = int32_t(*)(int, Core::ScriptErrorInfo*);
+using SetJitWarmupDelegate = void(*)(int);
+using SetReplicationDelegate = void(*)(int);
+using GatherReplicatedDelegate = int32_t(*)(Core::ScriptErrorInfo*);
+using SetAllocationTrackingDelegate = void(*)(int);
+using LoadPrefabsDelegate = int32_t(*)(const char*, Core::ScriptErrorInfo*);
+using GetPrefabIdDelegate = int32_t(*)(const char*); // Returns -1 if unknown
+using InstantiatePrefabDelegate = int32_t(*)(int, int, int*, Core::ScriptErrorInfo*); // Prefab id, count, entity ids out
+using SleepEntityDelegate = int32_t(*)(int, float, int, Core::ScriptErrorInfo*); // Entity, wake after seconds, compact
+using WakeEntityDelegate = int32_t(*)(int, Core::ScriptErrorInfo*);
+
+const char* const kEntryPointType = "ScriptAPI.EngineInterface";
+
+// Time given to an in-progress world save/load each frame
+constexpr std::chrono::microseconds kSnapshotBudgetPerFrame{2000};
+// Time given to queued script Start() calls each frame
+constexpr std::chrono::microseconds kStartBudgetPerFrame{4000};
+const char* const kCheckpointPath = "checkpoint.nsw";
+const char* const kDefaultControlPath = "engine.sock"; // Headless control channel unless --control is given
+constexpr int kMemorySampleInterval = 60; // Frames between resident memory samples
+constexpr uint32_t kDefaultExportCapacity = 65536; // Entities per frame in the shared-memory export
+constexpr size_t kReplicationBytesPerTick = 256 * 1024; // Backlog beyond this goes out on later ticks
 
 // Simple state tracking for hot reload
 struct ScriptInstanceInfo {
     int entityId;
     std::string scriptName;
+    int typeId = -1; // Resolved from scriptName after every load/reload
     // Add other config/state if needed
 };
 
-// Helper function to add a script and execute its start method
-bool AddAndStartScript(
-    AddScriptDelegate addFunc,
-    ExecuteStartDelegate startFunc,
-    const ScriptInstanceInfo& info)
+// Recomputes world matrices and pushes moved entities into the spatial index
+void UpdateTransforms()
+{
+    auto& transforms = Core::TransformHierarchy::instance();
+    auto& spatial = Core::SpatialIndex::instance();
+
+    transforms.update();
+    Core::Math::float4x4 world;
+    for (int entityId : transforms.changed_entities()) {
+        if (transforms.get_world(entityId, world)) {
+            spatial.move(entityId, world.c[3].x, world.c[3].y, world.c[3].z);
+        }
+    }
+}
+
+// In-process replication client reached over loopback UDP (--replicate). Stands in for
+// remote clients so the full encode/send/apply/acknowledge path runs every frame.
+struct ReplicationLoopback
+{
+    Core::LoopbackUdpSocket serverSocket;
+    Core::LoopbackUdpSocket clientSocket;
+    Core::ReplicationClient client;
+    int clientId = -1;
+    std::vector<uint8_t> packet = std::vector<uint8_t>(Core::ReplicationServer::kPacketBytes);
+};
+
+// Sends this tick's changes to the loopback client, which applies and acknowledges them.
+// Returns the bytes sent; 'encodeSeconds' receives the time spent encoding packets.
+size_t ReplicateTick(Core::ReplicationServer& server, ReplicationLoopback& loopback, double& encodeSeconds)
+{
+    size_t sent = 0;
+    encodeSeconds = 0.0;
+    while (sent < kReplicationBytesPerTick) {
+        auto encodeStart = std::chrono::steady_clock::now();
+        size_t bytes = server.write_packet(loopback.clientId, loopback.packet);
+        encodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - encodeStart).count();
+        if (bytes == 0) break;
+        loopback.serverSocket.send_to(loopback.clientSocket.port(), std::span<const uint8_t>(loopback.packet.data(), bytes));
+        sent += bytes;
+    }
+    server.end_tick();
+
+    uint32_t sequence = 0;
+    int received = 0;
+    while ((received = loopback.clientSocket.receive(loopback.packet)) > 0) {
+        if (loopback.client.read_packet(std::span<const uint8_t>(loopback.packet.data(), static_cast<size_t>(received)), sequence)) {
+            loopback.clientSocket.send_to(loopback.serverSocket.port(),
+                                          std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&sequence), sizeof(sequence)));
+        }
+    }
+    while ((received = loopback.serverSocket.receive(loopback.packet)) == static_cast<int>(sizeof(sequence))) {
+        std::memcpy(&sequence, loopback.packet.data(), sizeof(sequence));
+        server.acknowledge(loopback.clientId, sequence);
+    }
+    return sent;
+}
+
+// Reports a failed one-off call (init, reload, add...) immediately.
+// Per-frame calls go through Core::ScriptErrorSummary instead.
+void LogScriptError(const char* call, const Core::ScriptCallResult& result)
 {
-    if (!addFunc || !startFunc) return false;
+    if (result.ok()) return;
+    std::cerr << "!!! " << call << " failed (" << Core::to_string(result.status) << ")";
+    if (result.error.scriptType[0] != '\0') {
+        std::cerr << " in " << result.error.scriptType;
+        if (result.error.entityId >= 0) std::cerr << " on entity " << result.error.entityId;
+    }
+    if (result.error.exceptionCount > 1) std::cerr << " (" << result.error.exceptionCount << " exceptions)";
+    std::cerr << ": " << result.error.message << std::endl;
+}
+
+// Script type ids are dense indices into the ScriptAPI's type table. They change when the
+// script assembly is reloaded, so they are looked up by name once per load.
+void ResolveScriptTypeIds(GetScriptTypeIdDelegate getTypeId, std::vector<ScriptInstanceInfo>& instances)
+{
+    for (auto& info : instances) {
+        info.typeId = getTypeId(info.scriptName.c_str());
+    }
+}
+
+// Helper function to add a script. Its Start() is queued and runs within the per-frame
+// start budget; the script receives no updates until then.
+bool AddScriptInstance(AddScriptByIdDelegate addFunc, const ScriptInstanceInfo& info)
+{
+    if (!addFunc) return false;
+    if (info.typeId < 0) {
+        std::cerr << "Failed to add script '" << info.scriptName << "': unknown script type." << std::endl;
+        return false;
+    }
 
     std::cout << "Attempting to add script '" << info.scriptName << "' to entity " << info.entityId << "..." << std::endl;
-    bool added = false;
-    try { added = addFunc(info.entityId, info.scriptName.c_str()); }
-    catch (...) { std::cerr << "!!! Exception caught calling AddScript delegate." << std::endl; return false; }
+    Core::ScriptCallResult added = Core::call_script(addFunc, info.entityId, info.typeId);
 
     if (added) {
-        std::cout << "Script added. Executing Start() for entity " << info.entityId << "..." << std::endl;
-        try { startFunc(info.entityId); }
-        catch (...) { std::cerr << "!!! Exception caught calling ExecuteStart delegate." << std::endl; /* Continue? */ }
+        std::cout << "Script added; Start() queued for entity " << info.entityId << "." << std::endl;
         return true;
     } else {
+        LogScriptError("AddScriptById", added);
         std::cerr << "Failed to add script '" << info.scriptName << "'." << std::endl;
         return false;
     }
 }
 
-int main()
+// Reloads the script assembly and re-adds every tracked script instance.
+bool ReloadScripts(
+    ReloadDelegate reloadFunc,
+    GetScriptTypeIdDelegate getTypeIdFunc,
+    AddScriptByIdDelegate addFunc,
+    std::vector<ScriptInstanceInfo>& instances)
 {
-    std::cout << "Engine starting..." << std::endl;
+    if (!reloadFunc) {
+        std::cerr << "Hot reload is not available with a NativeAOT script library." << std::endl;
+        return false;
+    }
+    std::cout << "--- Reloading .NET Scripts ---" << std::endl;
+    Core::FrameWatchdog& watchdog = Core::FrameWatchdog::instance();
+    watchdog.set_host_activity("Reload");
+    Core::ScriptCallResult reloadResult = Core::call_script(reloadFunc);
+    if (!reloadResult) {
+        watchdog.set_host_activity(nullptr);
+        LogScriptError("Reload", reloadResult);
+        std::cerr << "--- Hot Reload FAILED ---" << std::endl;
+        // For now, just log the error. Update loop will continue using old state if reload failed badly.
+        return false;
+    }
 
-    // --- Initialization Steps (Same as before) ---
-    std::cout << "Searching for .NET 9+ runtime..." << std::endl;
-    const int requiredMajorVersion = 9;
-    std::string runtimePath = Core::HostUtils::find_latest_dot_net_runtime(requiredMajorVersion);
-    if (runtimePath.empty()) { std::cerr << "Error: .NET Runtime not found." << std::endl; return EXIT_FAILURE; }
-    std::cout << "Found .NET Runtime at: " << runtimePath << std::endl;
+    std::cout << "--- Re-adding script instances ---" << std::endl;
+    ResolveScriptTypeIds(getTypeIdFunc, instances);
+    // Re-add all previously active scripts
+    for (const auto& scriptInfo : instances) {
+        AddScriptInstance(addFunc, scriptInfo);
+    }
+    watchdog.set_host_activity(nullptr);
+    std::cout << "--- Hot Reload Complete ---" << std::endl;
+    return true;
+}
 
-    std::string appBasePath = Core::HostUtils::get_current_executable_directory();
-    if (appBasePath.empty()) { std::cerr << "Error: Cannot get app base path." << std::endl; return EXIT_FAILURE; }
-    std::cout << "Application Base Path: " << appBasePath << std::endl;
+int main(int argc, char** argv)
+{
+    const auto processStart = std::chrono::steady_clock::now();
+    std::cout << "Engine starting..." << std::endl;
 
-    std::cout << "Building TPA list..." << std::endl;
-    std::string tpaList = Core::HostUtils::build_tpa_list(runtimePath);
-    tpaList += Core::HostUtils::build_tpa_list(appBasePath);
-    if (tpaList.empty()) { std::cerr << "Warning: TPA list is empty." << std::endl; }
-    else { std::cout << "TPA list built." << std::endl; }
+    // --- Command Line ---
+    std::string loadPath; // --load <file>: restore a world snapshot instead of the default scene
+    std::string metricsTarget; // --metrics <file|unix:path>: export Prometheus metrics
+    bool headless = false; // --headless: no input polling; driven by signals and the control channel
+    std::string controlPath; // --control <path>: control channel socket (defaults to engine.sock when headless)
+    long long maxFrames = 0; // --max-frames <n>: exit after n simulated frames (0 = no limit)
+    double maxSeconds = 0.0; // --max-seconds <s>: exit after s seconds in the main loop (0 = no limit)
+    bool jitWarmup = true; // --no-jit-warmup: skip pre-JITting scripts after loads (for comparison runs)
+    std::string pgoCapturePath; // --pgo-capture <file>: write the JIT's profile data on exit
+    std::string pgoUsePath; // --pgo-use <file>: seed the JIT with profile data from a capture run; with warm-up, scripts skip Tier-0
+    bool replicate = false; // --replicate: replicate transforms and [Replicated] script fields to a loopback UDP client
+    bool allocTracking = false; // --alloc-tracking: report managed allocations and GC pauses per script type
+    Core::WatchdogSettings watchdogSettings; // --hitch-ms <n> (0 = off), --hitch-dir <dir>: frame hitch reports
+    std::string prefabsPath; // --prefabs <file>: prefab definitions for the 'spawn' control command
+    std::string exportName; // --export <name>: publish per-frame world state to shared memory (see WorldMonitor)
+    uint32_t exportCapacity = kDefaultExportCapacity; // --export-capacity <n>: entities per exported frame
+    std::string navGridPath; // --nav-grid <file>: navigation grid as a text map ('.' open, '#' blocked, 1-9 cost)
+    float navCellSize = 1.0f; // --nav-cell <size>: world units per navigation cell
+    std::string aotLibraryPath; // --aot <library>: run a NativeAOT-compiled script library instead of CoreCLR (no hot reload)
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--load" && i + 1 < argc) { loadPath = argv[++i]; }
+        else if (arg == "--metrics" && i + 1 < argc) { metricsTarget = argv[++i]; }
+        else if (arg == "--headless") { headless = true; }
+        else if (arg == "--control" && i + 1 < argc) { controlPath = argv[++i]; }
+        else if (arg == "--max-frames" && i + 1 < argc) { maxFrames = std::atoll(argv[++i]); }
+        else if (arg == "--max-seconds" && i + 1 < argc) { maxSeconds = std::atof(argv[++i]); }
+        else if (arg == "--no-jit-warmup") { jitWarmup = false; }
+        else if (arg == "--pgo-capture" && i + 1 < argc) { pgoCapturePath = argv[++i]; }
+        else if (arg == "--pgo-use" && i + 1 < argc) { pgoUsePath = argv[++i]; }
+        else if (arg == "--aot" && i + 1 < argc) { aotLibraryPath = argv[++i]; }
+        else if (arg == "--replicate") { replicate = true; }
+        else if (arg == "--alloc-tracking") { allocTracking = true; }
+        else if (arg == "--prefabs" && i + 1 < argc) { prefabsPath = argv[++i]; }
+        else if (arg == "--hitch-ms" && i + 1 < argc) { watchdogSettings.thresholdMs = std::atoi(argv[++i]); }
+        else if (arg == "--hitch-dir" && i + 1 < argc) { watchdogSettings.reportDirectory = argv[++i]; }
+        else if (arg == "--export" && i + 1 < argc) { exportName = argv[++i]; }
+        else if (arg == "--nav-grid" && i + 1 < argc) { navGridPath = argv[++i]; }
+        else if (arg == "--nav-cell" && i + 1 < argc) { navCellSize = std::strtof(argv[++i], nullptr); }
+        else if (arg == "--export-capacity" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long long value = std::strtoull(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || value == 0 || value > Core::WorldExport::max_capacity()) {
+                std::cerr << "Warning: Ignoring --export-capacity '" << argv[i] << "'; expected 1 to "
+                          << Core::WorldExport::max_capacity() << " entities." << std::endl;
+            }
+            else {
+                exportCapacity = static_cast<uint32_t>(value);
+            }
+        }
+        else { std::cerr << "Warning: Ignoring unknown argument '" << arg << "'." << std::endl; }
+    }
+    if (headless && controlPath.empty()) controlPath = kDefaultControlPath;
+    Core::ShutdownSignal::install(); // SIGINT/SIGTERM end the loop after the current frame
 
-    std::cout << "Initializing CoreCLR..." << std::endl;
+    // --- Host Backend ---
+    // CoreCLR (default) loads ScriptAPI and the script assembly and JITs them, which is what
+    // hot reload needs. --aot loads a NativeAOT-compiled library exporting the same entry
+    // points instead (NativeScripts/): no runtime to boot and nothing to JIT, but no reload
+    // and only part of the ScriptAPI. Whether that pays off in startup, memory and frame
+    // time hasn't been measured yet; compare the host summaries of both backends.
+    const bool useAot = !aotLibraryPath.empty();
+    const char* const hostName = useAot ? "nativeaot" : "coreclr";
     Core::DotNetRuntime runtime;
-    bool initialized = runtime.initialize(runtimePath, appBasePath, tpaList);
-    if (!initialized) { std::cerr << "Failed to initialize .NET runtime." << std::endl; return EXIT_FAILURE; }
-    std::cout << "CoreCLR Initialized successfully!" << std::endl;
+    Core::NativeScriptLibrary aotLibrary;
+    if (useAot) {
+        std::cout << "Loading NativeAOT script library '" << aotLibraryPath << "'..." << std::endl;
+        if (!aotLibrary.load(aotLibraryPath)) { std::cerr << "Failed to load NativeAOT script library." << std::endl; return EXIT_FAILURE; }
+        if (!pgoCapturePath.empty() || !pgoUsePath.empty()) {
+            std::cerr << "Warning: --pgo-capture/--pgo-use have no effect with --aot." << std::endl;
+        }
+    } else {
+        // --- Initialization Steps (Same as before) ---
+        std::cout << "Searching for .NET 9+ runtime..." << std::endl;
+        const int requiredMajorVersion = 9;
+        std::string runtimePath = Core::HostUtils::find_latest_dot_net_runtime(requiredMajorVersion);
+        if (runtimePath.empty()) { std::cerr << "Error: .NET Runtime not found." << std::endl; return EXIT_FAILURE; }
+        std::cout << "Found .NET Runtime at: " << runtimePath << std::endl;
+
+        std::string appBasePath = Core::HostUtils::get_current_executable_directory();
+        if (appBasePath.empty()) { std::cerr << "Error: Cannot get app base path." << std::endl; return EXIT_FAILURE; }
+        std::cout << "Application Base Path: " << appBasePath << std::endl;
+
+        std::cout << "Building TPA list..." << std::endl;
+        std::string tpaList = Core::HostUtils::build_tpa_list(runtimePath);
+        tpaList += Core::HostUtils::build_tpa_list(appBasePath);
+        if (tpaList.empty()) { std::cerr << "Warning: TPA list is empty." << std::endl; }
+        else { std::cout << "TPA list built." << std::endl; }
+
+        // Static PGO: a capture run (typically a --headless benchmark with --max-frames)
+        // writes the profile the JIT gathered; later runs read it so Tier-1 code is optimized
+        // for the recorded behaviour from its first compilation.
+        if (!pgoCapturePath.empty()) {
+            Core::DotNetRuntime::set_config("WritePGOData", "1");
+            Core::DotNetRuntime::set_config("PGODataPath", pgoCapturePath);
+        } else if (!pgoUsePath.empty()) {
+            Core::DotNetRuntime::set_config("ReadPGOData", "1");
+            Core::DotNetRuntime::set_config("PGODataPath", pgoUsePath);
+            // With a profile there is nothing left for Tier-0 to instrument: skip it, so JIT
+            // warm-up compiles script methods straight to optimized code before the first
+            // frame instead of leaving them to tier up during it. Framework code keeps its
+            // ReadyToRun code and still tiers up when hot.
+            if (jitWarmup) Core::DotNetRuntime::set_config("TC_QuickJit", "0");
+        }
+
+        std::cout << "Initializing CoreCLR..." << std::endl;
+        bool initialized = runtime.initialize(runtimePath, appBasePath, tpaList);
+        if (!initialized) { std::cerr << "Failed to initialize .NET runtime." << std::endl; return EXIT_FAILURE; }
+        std::cout << "CoreCLR Initialized successfully!" << std::endl;
+    }
 
     // --- Get Delegates for ScriptAPI ---
     std::cout << "Getting delegates from ScriptAPI..." << std::endl;
     InitDelegate scriptApiInit = nullptr;
     ShutdownDelegate scriptApiShutdown = nullptr;
     ReloadDelegate scriptApiReload = nullptr; // Get Reload delegate
-    AddScriptDelegate scriptApiAddScript = nullptr;
-    ExecuteStartDelegate scriptApiExecuteStart = nullptr;
-    ExecuteUpdateDelegate scriptApiExecuteUpdate = nullptr;
+    GetScriptTypeIdDelegate scriptApiGetScriptTypeId = nullptr;
+    AddScriptByIdDelegate scriptApiAddScript = nullptr;
+    RunPendingStartsDelegate scriptApiRunPendingStarts = nullptr;
+    ExecutePhaseDelegate scriptApiExecutePhase = nullptr;
+
+    // Both backends resolve the same entry points by type and method name.
+    auto bindEntryPoint = [&](const char* method, auto* delegatePtr) {
+        return useAot ? aotLibrary.get_entry_point(kEntryPointType, method, delegatePtr)
+                      : runtime.create_delegate("ScriptAPI", kEntryPointType, method, delegatePtr);
+    };
 
     bool delegatesOk = true;
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "Init", &scriptApiInit);
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "Shutdown", &scriptApiShutdown);
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "Reload", &scriptApiReload); // Add Reload
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "AddScript", &scriptApiAddScript);
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "ExecuteStartForEntity", &scriptApiExecuteStart);
-    delegatesOk &= runtime.create_delegate("ScriptAPI", "ScriptAPI.EngineInterface", "ExecuteUpdate", &scriptApiExecuteUpdate);
-
-    if (!delegatesOk || !scriptApiInit || !scriptApiShutdown || !scriptApiReload || !scriptApiAddScript || !scriptApiExecuteStart || !scriptApiExecuteUpdate) {
+    delegatesOk &= bindEntryPoint("Init", &scriptApiInit);
+    delegatesOk &= bindEntryPoint("Shutdown", &scriptApiShutdown);
+    delegatesOk &= bindEntryPoint("GetScriptTypeId", &scriptApiGetScriptTypeId);
+    delegatesOk &= bindEntryPoint("AddScriptById", &scriptApiAddScript);
+    delegatesOk &= bindEntryPoint("RunPendingStarts", &scriptApiRunPendingStarts);
+    delegatesOk &= bindEntryPoint("ExecutePhase", &scriptApiExecutePhase);
+    // Reload and JIT warmup only exist under CoreCLR
+    SetJitWarmupDelegate scriptApiSetJitWarmup = nullptr;
+    if (!useAot) {
+        delegatesOk &= bindEntryPoint("Reload", &scriptApiReload);
+        delegatesOk &= bindEntryPoint("SetJitWarmup", &scriptApiSetJitWarmup);
+    }
+    SetReplicationDelegate scriptApiSetReplication = nullptr;
+    GatherReplicatedDelegate scriptApiGatherReplicated = nullptr;
+    if (replicate) {
+        delegatesOk &= bindEntryPoint("SetReplication", &scriptApiSetReplication);
+        delegatesOk &= bindEntryPoint("GatherReplicated", &scriptApiGatherReplicated);
+    }
+    SetAllocationTrackingDelegate scriptApiSetAllocationTracking = nullptr;
+    if (allocTracking) delegatesOk &= bindEntryPoint("SetAllocationTracking", &scriptApiSetAllocationTracking);
+
+    LoadPrefabsDelegate scriptApiLoadPrefabs = nullptr;
+    GetPrefabIdDelegate scriptApiGetPrefabId = nullptr;
+    InstantiatePrefabDelegate scriptApiInstantiatePrefab = nullptr;
+    if (!prefabsPath.empty()) {
+        delegatesOk &= bindEntryPoint("LoadPrefabs", &scriptApiLoadPrefabs);
+        delegatesOk &= bindEntryPoint("GetPrefabId", &scriptApiGetPrefabId);
+        delegatesOk &= bindEntryPoint("InstantiatePrefab", &scriptApiInstantiatePrefab);
+    }
+
+    SleepEntityDelegate scriptApiSleepEntity = nullptr;
+    WakeEntityDelegate scriptApiWakeEntity = nullptr;
+    delegatesOk &= bindEntryPoint("SleepEntity", &scriptApiSleepEntity);
+    delegatesOk &= bindEntryPoint("WakeEntity", &scriptApiWakeEntity);
+
+    // World snapshot callbacks
+    Core::ScriptSnapshotCallbacks snapshotCallbacks;
+    delegatesOk &= bindEntryPoint("CaptureScriptSnapshot", &snapshotCallbacks.capture);
+    delegatesOk &= bindEntryPoint("SerializeSnapshotScript", &snapshotCallbacks.serialize);
+    delegatesOk &= bindEntryPoint("ReleaseScriptSnapshot", &snapshotCallbacks.release);
+    delegatesOk &= bindEntryPoint("RestoreScript", &snapshotCallbacks.restore);
+
+    if (!delegatesOk || !scriptApiInit || !scriptApiShutdown || !scriptApiGetScriptTypeId || !scriptApiAddScript || !scriptApiRunPendingStarts || !scriptApiExecutePhase) {
          std::cerr << "Failed to get one or more required delegates from ScriptAPI." << std::endl;
          runtime.shutdown(); return EXIT_FAILURE;
     }
      std::cout << "Delegates obtained successfully." << std::endl;
 
     // --- Initialize ScriptAPI Environment ---
+    if (scriptApiSetJitWarmup) scriptApiSetJitWarmup(jitWarmup ? 1 : 0);
+    if (scriptApiSetReplication) scriptApiSetReplication(1);
+    if (scriptApiSetAllocationTracking) scriptApiSetAllocationTracking(1);
     std::cout << "Calling ScriptAPI Init..." << std::endl;
-    bool scriptApiInitialized = false;
-    try { scriptApiInitialized = scriptApiInit(); }
-    catch (...) { std::cerr << "!!! Exception caught calling ScriptAPI Init delegate." << std::endl; }
-    if (!scriptApiInitialized) {
+    Core::ScriptCallResult initResult = Core::call_script(scriptApiInit);
+    if (!initResult) {
+        LogScriptError("Init", initResult);
         std::cerr << "ScriptAPI initialization failed." << std::endl;
         runtime.shutdown(); return EXIT_FAILURE;
     }
     std::cout << "ScriptAPI Init completed." << std::endl;
 
+    if (!prefabsPath.empty()) {
+        Core::ScriptCallResult prefabsResult = Core::call_script(scriptApiLoadPrefabs, prefabsPath.c_str());
+        if (!prefabsResult) LogScriptError("LoadPrefabs", prefabsResult); // 'spawn' reports unknown prefabs
+    }
+
     // --- Keep track of scripts to re-add after reload ---
     std::vector<ScriptInstanceInfo> activeScriptInstances;
-    activeScriptInstances.push_back({0, "MyFirstScript"}); // Add our initial script info
+
+    // --- World Snapshots ---
+    // Saves and loads run a slice per frame so neither stalls the loop.
+    Core::WorldSaveJob saveJob(Core::TransformHierarchy::instance(), snapshotCallbacks);
+    Core::WorldLoadJob loadJob(Core::TransformHierarchy::instance(), snapshotCallbacks);
+    loadJob.onScriptRestored = [&](int entityId, const std::string& typeName) {
+        activeScriptInstances.push_back({entityId, typeName});
+    };
 
     // --- Initial Script Loading ---
-    for(const auto& scriptInfo : activeScriptInstances) {
-         AddAndStartScript(scriptApiAddScript, scriptApiExecuteStart, scriptInfo);
+    if (!loadPath.empty()) {
+        std::cout << "Loading world snapshot '" << loadPath << "'..." << std::endl;
+        if (!loadJob.begin(loadPath)) {
+            std::cerr << "Failed to open world snapshot '" << loadPath << "'." << std::endl;
+            LogScriptError("Shutdown", Core::call_script(scriptApiShutdown));
+            runtime.shutdown(); return EXIT_FAILURE;
+        }
+    } else {
+        activeScriptInstances.push_back({0, "MyFirstScript"}); // Add our initial script info
+        Core::EntityIds::instance().reserve(0); // Keep runtime-spawned entities clear of it
+        ResolveScriptTypeIds(scriptApiGetScriptTypeId, activeScriptInstances);
+        for(const auto& scriptInfo : activeScriptInstances) {
+             AddScriptInstance(scriptApiAddScript, scriptInfo);
+        }
     }
 
     // --- Main Engine Loop ---
-    std::cout << "\nStarting main loop (Press SPACE to Reload, ESC to Exit)..." << std::endl;
+    if (headless) {
+        std::cout << "\nStarting headless main loop (SIGINT/SIGTERM to exit)..." << std::endl;
+    } else {
+        std::cout << "\nStarting main loop (Press SPACE to Reload, F5 to Save, ESC to Exit)..." << std::endl;
+    }
     bool running = true;
+    bool paused = false; // Paused frames still service snapshots and the control channel
     int frameCount = 0;
     bool spacePressedLastFrame = false; // To detect key press edge
+    bool f5PressedLastFrame = false;
+    Core::ScriptErrorSummary scriptErrors; // Script failures are reported once per frame
+
+    // --- Metrics ---
+    auto& metrics = Core::MetricsRegistry::instance();
+    Core::Counter& framesTotal = metrics.counter("engine_frames_total", "Frames simulated");
+    Core::Histogram& frameTime = metrics.histogram("engine_frame_time_seconds", "Frame time excluding the frame limiter sleep",
+                                                   Core::Histogram::exponential_bounds(0.0005, 2.0, 10));
+    Core::Gauge& entityCount = metrics.gauge("engine_entities", "Entities in the transform hierarchy");
+    // Published by the ScriptAPI as entities sleep and wake
+    Core::Gauge& dormantEntities = metrics.gauge("engine_dormant_entities", "Entities asleep, out of the script update lists");
+    // Published by the ScriptAPI when a reloaded script context fails to unload
+    Core::Gauge& leakedContexts = metrics.gauge("engine_script_contexts_leaked", "Unloaded script contexts still alive after the leak timeout");
+    // Host backend comparison (CoreCLR vs --aot): startup, memory and the frame time above
+    Core::Gauge& startupSeconds = metrics.gauge("engine_startup_seconds", "Process start until the first frame",
+                                                Core::MetricsRegistry::label("host", hostName));
+    Core::Gauge& residentBytes = metrics.gauge("engine_resident_bytes", "Process working set",
+                                               Core::MetricsRegistry::label("host", hostName));
+    Core::MetricsExporter metricsExporter;
+    if (!metricsTarget.empty() && metricsExporter.start(metricsTarget)) {
+        metrics.export_quantiles(frameTime, { 0.5, 0.9, 0.99 });
+        std::cout << "Exporting metrics to '" << metricsTarget << "'." << std::endl;
+    }
+
+    // --- Time to Steady State ---
+    // Frame times right after a load include JIT compilation and tier-up; this reports
+    // how long they take to settle (compare runs with and without --no-jit-warmup/--pgo-use).
+    Core::SteadyStateTracker steadyState;
+    steadyState.begin("startup");
+    Core::Gauge& startupSteadySeconds = metrics.gauge("engine_time_to_steady_state_seconds", "Frame time spent before frame times settled",
+                                                      Core::MetricsRegistry::label("trigger", "startup"));
+    Core::Gauge& reloadSteadySeconds = metrics.gauge("engine_time_to_steady_state_seconds", "Frame time spent before frame times settled",
+                                                     Core::MetricsRegistry::label("trigger", "reload"));
+
+    // --- Replication ---
+    // Objects changed this frame are encoded against each client's acknowledged baseline.
+    // The two gauges are the benchmark: wire size per tick, and encode time normalized to
+    // 10k replicated objects so runs with different entity counts compare.
+    auto& replicationServer = Core::ReplicationServer::instance();
+    std::optional<Core::ReplicatedTransforms> replicatedTransforms;
+    ReplicationLoopback replicationLoopback;
+    Core::Gauge& replicationBytes = metrics.gauge("engine_replication_bytes_per_tick", "Bytes sent to replication clients in the last tick");
+    Core::Gauge& replicationEncode = metrics.gauge("engine_replication_encode_seconds_per_10k",
+                                                   "Packet encode time of the last tick per 10k replicated objects");
+    size_t lastReplicationBytes = 0;
+    if (replicate) {
+        if (replicationLoopback.serverSocket.open() && replicationLoopback.clientSocket.open()) {
+            replicatedTransforms.emplace(replicationServer);
+            replicationLoopback.clientId = replicationServer.add_client();
+            std::cout << "Replicating to loopback client on UDP port " << replicationLoopback.clientSocket.port() << "." << std::endl;
+        } else {
+            std::cerr << "Failed to open loopback UDP sockets; replication disabled." << std::endl;
+            replicate = false;
+        }
+    }
+
+    // --- Frame Watchdog ---
+    // Stalled frames get a report with the running script and the main thread's stacks.
+    // Under NativeAOT the native stack already names script methods, so dotnet-stack is skipped.
+    Core::FrameWatchdog& watchdog = Core::FrameWatchdog::instance();
+    if (watchdogSettings.thresholdMs > 0) {
+        if (useAot) watchdogSettings.managedStackCommand.clear();
+        if (watchdog.start(watchdogSettings)) {
+            std::cout << "Frame watchdog reporting frames over " << watchdogSettings.thresholdMs << " ms to '"
+                      << watchdogSettings.reportDirectory << "'." << std::endl;
+        }
+    }
+
+    // --- Navigation ---
+    // Scripts may also replace the grid at runtime through Navigation.SetGrid().
+    if (!navGridPath.empty()) {
+        Core::NavGrid navGrid;
+        if (navCellSize > 0.0f && navGrid.load(navGridPath, navCellSize, { 0.0f, 0.0f, 0.0f })) {
+            std::cout << "Navigation grid " << navGrid.width() << "x" << navGrid.height() << " loaded from '" << navGridPath << "'." << std::endl;
+            Core::NavigationService::instance().set_grid(std::move(navGrid));
+        } else {
+            std::cerr << "Failed to load navigation grid; path requests will report NotFound." << std::endl;
+        }
+    }
+
+    // --- World Export ---
+    // External tools map the region and copy frames out on their own schedule; publishing
+    // is a memcpy per frame and never waits for them.
+    Core::WorldExporter worldExporter;
+    if (!exportName.empty()) {
+        if (worldExporter.open(exportName, exportCapacity)) {
+            std::cout << "Exporting world state to shared memory '" << exportName << "' (up to " << exportCapacity
+                      << " entities per frame)." << std::endl;
+        }
+    }
+
+    // --- Control Channel ---
+    // One command per line; answered between frames on the main thread.
+    const auto loopStart = std::chrono::steady_clock::now();
+    double lastFrameSeconds = 0.0;
+    auto handleControlCommand = [&](std::string_view command) -> std::string {
+        if (command == "reload") {
+            bool ok = ReloadScripts(scriptApiReload, scriptApiGetScriptTypeId, scriptApiAddScript, activeScriptInstances);
+            if (ok) steadyState.begin("reload");
+            return ok ? "ok" : "error: reload failed";
+        }
+        if (command == "stats") {
+            double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+            return "frames=" + std::to_string(frameCount) +
+                   " entities=" + std::to_string(Core::TransformHierarchy::instance().size()) +
+                   " scripts=" + std::to_string(activeScriptInstances.size()) +
+                   " paused=" + (paused ? "1" : "0") +
+                   " uptime_s=" + std::to_string(uptime) +
+                   " frame_ms=" + std::to_string(lastFrameSeconds * 1000.0) +
+                   " replicated=" + std::to_string(replicate ? replicationServer.object_count() : 0) +
+                   " replication_bytes=" + std::to_string(lastReplicationBytes) +
+                   " hitches=" + std::to_string(watchdog.hitch_count()) +
+                   " nav_pending=" + std::to_string(Core::NavigationService::instance().pending_count()) +
+                   " nav_cache_hits=" + std::to_string(Core::NavigationService::instance().cache_hits()) +
+                   " dormant=" + std::to_string(static_cast<long long>(dormantEntities.value())) +
+                   " leaked_contexts=" + std::to_string(static_cast<int>(leakedContexts.value()));
+        }
+        if (command.starts_with("spawn ")) {
+            // spawn <prefab> [count]: instantiates now and reports the time taken
+            if (!scriptApiInstantiatePrefab) return "error: no prefabs loaded (start with --prefabs <file>)";
+            std::string args(command.substr(6));
+            size_t space = args.find(' ');
+            std::string name = args.substr(0, space);
+            int count = space == std::string::npos ? 1 : std::atoi(args.c_str() + space + 1);
+            int prefabId = scriptApiGetPrefabId(name.c_str());
+            if (prefabId < 0) return "error: unknown prefab '" + name + "'";
+            if (count <= 0) return "error: count must be positive";
+
+            std::vector<int> entityIds(static_cast<size_t>(count));
+            const auto spawnStart = std::chrono::steady_clock::now();
+            Core::ScriptCallResult spawned = Core::call_script(scriptApiInstantiatePrefab, prefabId, count, entityIds.data());
+            double spawnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawnStart).count();
+            scriptErrors.record("InstantiatePrefab", spawned);
+            if (spawned.status == Core::ScriptStatus::Failed || spawned.status == Core::ScriptStatus::InternalError) {
+                return "error: " + std::string(spawned.error.message);
+            }
+            return "entities=" + std::to_string(count) + " first=" + std::to_string(entityIds.front()) +
+                   " ms=" + std::to_string(spawnMs);
+        }
+        if (command.starts_with("sleep ")) {
+            // sleep <entity> [seconds] [compact]
+            std::string args(command.substr(6));
+            char* end = nullptr;
+            int entityId = static_cast<int>(std::strtol(args.c_str(), &end, 10));
+            float seconds = std::strtof(end, &end);
+            bool compact = std::string_view(end).find("compact") != std::string_view::npos;
+            Core::ScriptCallResult slept = Core::call_script(scriptApiSleepEntity, entityId, seconds, compact ? 1 : 0);
+            return slept ? "ok" : "error: " + std::string(slept.error.message);
+        }
+        if (command.starts_with("wake ")) {
+            Core::ScriptCallResult woken = Core::call_script(scriptApiWakeEntity, std::atoi(std::string(command.substr(5)).c_str()));
+            scriptErrors.record("WakeEntity", woken);
+            return woken.status == Core::ScriptStatus::InternalError ? "error: " + std::string(woken.error.message) : "ok";
+        }
+        if (command.starts_with("region ")) {
+            // region <x> <y> <z> <extent> adds an activation region; 'region clear' removes them
+            if (command == "region clear") { Core::ActivationRegions::instance().clear(); return "ok"; }
+            std::string args(command.substr(7));
+            char* end = nullptr;
+            float x = std::strtof(args.c_str(), &end);
+            float y = std::strtof(end, &end);
+            float z = std::strtof(end, &end);
+            float extent = std::strtof(end, &end);
+            if (extent <= 0.0f) return "error: usage: region <x> <y> <z> <extent> | region clear";
+            Core::ActivationRegions::instance().add_around(x, y, z, extent);
+            return "ok";
+        }
+        if (command == "pause") { paused = true; return "ok"; }
+        if (command == "resume") { paused = false; return "ok"; }
+        if (command == "save") {
+            if (saveJob.active() || loadJob.active()) return "error: snapshot in progress";
+            std::cout << "\n--- Saving world to '" << kCheckpointPath << "' ---" << std::endl;
+            return saveJob.begin(kCheckpointPath) ? "ok" : "error: cannot open checkpoint";
+        }
+        if (command == "quit") { Core::ShutdownSignal::request(); return "ok"; }
+        if (command == "help") return "commands: reload stats pause resume save spawn sleep wake region quit";
+        return "error: unknown command '" + std::string(command) + "'";
+    };
+    Core::ControlChannel controlChannel;
+    if (!controlPath.empty() && controlChannel.start(controlPath)) {
+        std::cout << "Control channel listening on '" << controlPath << "'." << std::endl;
+    }
+
+    const double startupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - processStart).count();
+    startupSeconds.set(startupTime);
+    std::cout << "Startup (" << hostName << " host) took " << startupTime * 1000.0 << " ms." << std::endl;
 
     while(running)
     {
-        // --- Input Handling ---
-        bool escapePressed = GetAsyncKeyState(VK_ESCAPE) & 0x8000;
-        bool spacePressed = GetAsyncKeyState(VK_SPACE) & 0x8000;
+        auto frameStart = std::chrono::steady_clock::now();
+        watchdog.heartbeat();
 
-        if (escapePressed) {
+        // --- Exit Conditions ---
+        if (Core::ShutdownSignal::requested()) {
+            running = false;
+            std::cout << "\nShutdown requested, exiting loop." << std::endl;
+            continue;
+        }
+        if (maxFrames > 0 && frameCount >= maxFrames) {
+            running = false;
+            std::cout << "\nFrame limit reached, exiting loop." << std::endl;
+            continue;
+        }
+        if (maxSeconds > 0.0 && std::chrono::duration<double>(frameStart - loopStart).count() >= maxSeconds) {
             running = false;
-            std::cout << "\nESC pressed, exiting loop." << std::endl;
+            std::cout << "\nTime limit reached, exiting loop." << std::endl;
             continue;
         }
 
-        // Check for Space press *edge* (pressed now, but not last frame)
-        if (spacePressed && !spacePressedLastFrame) {
-            std::cout << "\n--- HOT RELOAD REQUESTED ---" << std::endl;
+        controlChannel.poll(handleControlCommand);
 
-            // 1. (Manual Step) Rebuild ManagedScripts.dll
-            // In a real engine, you might trigger this automatically or watch for changes.
-            // For now, you need to manually run `dotnet build` in ManagedScripts
-            // *before* pressing Space.
-            std::cout << ">>> Please ensure ManagedScripts.dll has been rebuilt <<<" << std::endl;
-            std::cout << ">>> Press SPACE again to confirm reload... <<<" << std::endl;
+        // --- Input Handling ---
+        // Headless runs never touch input devices.
+        if (!headless) {
+            bool escapePressed = GetAsyncKeyState(VK_ESCAPE) & 0x8000;
+            bool spacePressed = GetAsyncKeyState(VK_SPACE) & 0x8000;
+            bool f5Pressed = GetAsyncKeyState(VK_F5) & 0x8000;
 
-            // Simple confirmation mechanism - requires pressing space twice
-            // Wait for space release then press again
-            while (GetAsyncKeyState(VK_SPACE) & 0x8000) { Sleep(10); } // Wait for release
-            while (!(GetAsyncKeyState(VK_SPACE) & 0x8000)) { // Wait for press again
-                if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) { // Allow exit during wait
-                     running = false; break;
-                }
-                Sleep(10);
+            if (escapePressed) {
+                running = false;
+                std::cout << "\nESC pressed, exiting loop." << std::endl;
+                continue;
             }
-             while (GetAsyncKeyState(VK_SPACE) & 0x8000) { Sleep(10); } // Wait for release again
-            if (!running) continue; // Check if Escape was pressed during wait
-
-            std::cout << "--- Reloading .NET Scripts ---" << std::endl;
-            bool reloadOk = false;
-            try { reloadOk = scriptApiReload(); }
-            catch(...) { std::cerr << "!!! Exception caught calling ScriptAPI Reload delegate." << std::endl; }
-
-            if (reloadOk) {
-                std::cout << "--- Re-adding script instances ---" << std::endl;
-                // Re-add all previously active scripts
-                for(const auto& scriptInfo : activeScriptInstances) {
-                    AddAndStartScript(scriptApiAddScript, scriptApiExecuteStart, scriptInfo);
+
+            // Check for Space press *edge* (pressed now, but not last frame)
+            if (spacePressed && !spacePressedLastFrame) {
+                std::cout << "\n--- HOT RELOAD REQUESTED ---" << std::endl;
+
+                // 1. (Manual Step) Rebuild ManagedScripts.dll
+                // In a real engine, you might trigger this automatically or watch for changes.
+                // For now, you need to manually run `dotnet build` in ManagedScripts
+                // *before* pressing Space.
+                std::cout << ">>> Please ensure ManagedScripts.dll has been rebuilt <<<" << std::endl;
+                std::cout << ">>> Press SPACE again to confirm reload... <<<" << std::endl;
+
+                // Simple confirmation mechanism - requires pressing space twice
+                // Wait for space release then press again
+                while (GetAsyncKeyState(VK_SPACE) & 0x8000) { Sleep(10); } // Wait for release
+                while (!(GetAsyncKeyState(VK_SPACE) & 0x8000)) { // Wait for press again
+                    watchdog.heartbeat(); // Waiting on the user is not a hitch
+                    if ((GetAsyncKeyState(VK_ESCAPE) & 0x8000) || Core::ShutdownSignal::requested()) { // Allow exit during wait
+                         running = false; break;
+                    }
+                    Sleep(10);
                 }
-                std::cout << "--- Hot Reload Complete ---" << std::endl;
+                 while (GetAsyncKeyState(VK_SPACE) & 0x8000) { Sleep(10); } // Wait for release again
+                if (!running) continue; // Check if Escape was pressed during wait
+
+                if (ReloadScripts(scriptApiReload, scriptApiGetScriptTypeId, scriptApiAddScript, activeScriptInstances)) {
+                    steadyState.begin("reload");
+                }
+            }
+            spacePressedLastFrame = spacePressed; // Update state for next frame
+
+            if (f5Pressed && !f5PressedLastFrame && !saveJob.active() && !loadJob.active()) {
+                std::cout << "\n--- Saving world to '" << kCheckpointPath << "' ---" << std::endl;
+                saveJob.begin(kCheckpointPath);
+            }
+            f5PressedLastFrame = f5Pressed;
+        }
+
+        // --- World Snapshot Jobs ---
+        if (loadJob.active() && loadJob.step(kSnapshotBudgetPerFrame)) {
+            if (loadJob.succeeded()) {
+                std::cout << "--- World loaded: " << loadJob.entities_loaded() << " entities, "
+                          << loadJob.scripts_loaded() << " scripts ---" << std::endl;
+            } else {
+                std::cerr << "--- World load FAILED ---" << std::endl;
+            }
+        }
+        if (saveJob.active() && saveJob.step(kSnapshotBudgetPerFrame)) {
+            if (saveJob.succeeded()) {
+                std::cout << "--- World saved: " << saveJob.entities_written() << " entities, "
+                          << saveJob.scripts_written() << " scripts ---" << std::endl;
             } else {
-                 std::cerr << "--- Hot Reload FAILED ---" << std::endl;
-                 // Maybe stop the engine or prevent further updates?
-                 // For now, just log the error. Update loop will continue using old state if reload failed badly.
+                std::cerr << "--- World save FAILED ---" << std::endl;
             }
         }
-        spacePressedLastFrame = spacePressed; // Update state for next frame
+
+        if (paused) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            continue;
+        }
+
+        // --- Script Starts ---
+        // Queued Start() calls get a slice of the frame; finished StartAsync() tasks let
+        // their scripts join the update phases below. Finished Streaming reads and
+        // Navigation paths are also delivered here.
+        scriptErrors.record("Start", Core::call_script(scriptApiRunPendingStarts, static_cast<int>(kStartBudgetPerFrame.count())));
 
         // --- Execute Script Updates ---
-        try { scriptApiExecuteUpdate(); }
-        catch (...) { std::cerr << "!!! Exception caught calling ScriptAPI ExecuteUpdate delegate." << std::endl; }
+        for (Core::ScriptPhase phase : { Core::ScriptPhase::PreUpdate, Core::ScriptPhase::Update, Core::ScriptPhase::LateUpdate }) {
+            scriptErrors.record(Core::to_string(phase), Core::call_script(scriptApiExecutePhase, static_cast<int>(phase)));
+        }
+
+        // --- Native Systems ---
+        UpdateTransforms();
+
+        scriptErrors.record(Core::to_string(Core::ScriptPhase::PostPhysics),
+                            Core::call_script(scriptApiExecutePhase, static_cast<int>(Core::ScriptPhase::PostPhysics)));
+
+        // Paths requested this frame are searched on the workers while the frame finishes;
+        // they are delivered with the Start slice of a later frame
+        Core::NavigationService::instance().dispatch();
+
+        // --- Replication ---
+        if (replicate) {
+            scriptErrors.record("GatherReplicated", Core::call_script(scriptApiGatherReplicated));
+            replicatedTransforms->sync(Core::TransformHierarchy::instance());
+            double encodeSeconds = 0.0;
+            lastReplicationBytes = ReplicateTick(replicationServer, replicationLoopback, encodeSeconds);
+            replicationBytes.set(static_cast<double>(lastReplicationBytes));
+            if (replicationServer.object_count() > 0) {
+                replicationEncode.set(encodeSeconds * 10000.0 / static_cast<double>(replicationServer.object_count()));
+            }
+        }
+
+        scriptErrors.end_frame(frameCount, std::cerr);
+
+        lastFrameSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+        framesTotal.add();
+        entityCount.set(static_cast<double>(Core::TransformHierarchy::instance().size()));
+        frameTime.observe(lastFrameSeconds);
+        if (worldExporter.is_open()) {
+            Core::WorldExport::FrameStats exportStats{};
+            exportStats.frameIndex = static_cast<uint64_t>(frameCount);
+            exportStats.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loopStart).count();
+            exportStats.frameSeconds = lastFrameSeconds;
+            exportStats.scriptErrors = scriptErrors.total_errors();
+            exportStats.hitches = watchdog.hitch_count();
+            worldExporter.publish(Core::TransformHierarchy::instance(), exportStats);
+        }
+        if (frameCount % kMemorySampleInterval == 0) {
+            size_t resident = 0, peakResident = 0;
+            if (Core::HostUtils::get_process_memory(resident, peakResident)) residentBytes.set(static_cast<double>(resident));
+        }
+        if (steadyState.observe(lastFrameSeconds)) {
+            std::cout << "Frame time steady after " << steadyState.label() << ": " << steadyState.frames_to_steady() << " frames ("
+                      << steadyState.seconds_to_steady() * 1000.0 << " ms of frame time); first frame "
+                      << steadyState.first_frame_seconds() * 1000.0 << " ms, worst " << steadyState.worst_frame_seconds() * 1000.0
+                      << " ms, steady " << steadyState.steady_frame_seconds() * 1000.0 << " ms" << std::endl;
+            (steadyState.label() == "reload" ? reloadSteadySeconds : startupSteadySeconds).set(steadyState.seconds_to_steady());
+        }
 
         // Simulate frame delay
         std::this_thread::sleep_for(std::chrono::milliseconds(16));
         frameCount++;
     }
     std::cout << "Exited main loop after " << frameCount << " frames." << std::endl;
+    watchdog.stop();
+    worldExporter.close(); // Readers see the engine leave
+
+    // One line to compare host backends across runs (e.g. --headless --max-frames 3000
+    // with and without --aot)
+    size_t resident = 0, peakResident = 0;
+    Core::HostUtils::get_process_memory(resident, peakResident);
+    std::cout << "Host summary (" << hostName << "): startup " << startupTime * 1000.0 << " ms, resident "
+              << resident / (1024.0 * 1024.0) << " MiB (peak " << peakResident / (1024.0 * 1024.0) << " MiB), frame p50 "
+              << frameTime.quantile(0.5) * 1000.0 << " ms, p99 " << frameTime.quantile(0.99) * 1000.0 << " ms over "
+              << frameTime.count() << " frames" << std::endl;
+    controlChannel.stop();
+    metricsExporter.stop(); // Writes the final snapshot
 
     // --- Shutdown ScriptAPI ---
     std::cout << "Calling ScriptAPI Shutdown..." << std::endl;
-    try { scriptApiShutdown(); }
-    catch (...) { std::cerr << "!!! Exception caught calling ScriptAPI Shutdown delegate." << std::endl; }
+    LogScriptError("Shutdown", Core::call_script(scriptApiShutdown));
 
     // --- Shutdown CoreCLR ---
-    std::cout << "Shutting down CoreCLR..." << std::endl;
-    bool shutdownSuccess = runtime.shutdown();
-    if (!shutdownSuccess) { std::cerr << "CoreCLR shutdown reported an error." << std::endl; }
-    else { std::cout << "CoreCLR shutdown successful." << std::endl; }
+    // A NativeAOT library stays loaded until the process exits.
+    if (!useAot) {
+        std::cout << "Shutting down CoreCLR..." << std::endl;
+        bool shutdownSuccess = runtime.shutdown();
+        if (!shutdownSuccess) { std::cerr << "CoreCLR shutdown reported an error." << std::endl; }
+        else { std::cout << "CoreCLR shutdown successful." << std::endl; }
+    }
 
     std::cout << "Engine exiting." << std::endl;
     return EXIT_SUCCESS;
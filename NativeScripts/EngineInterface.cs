@@ -0,0 +1,365 @@
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace ScriptAPI
+{
+    // Layout of Core::ScriptErrorInfo (Core/script_call.h)
+    [StructLayout(LayoutKind.Sequential)]
+    internal unsafe struct ScriptErrorInfo
+    {
+        public int EntityId;
+        public int ExceptionCount;
+        public fixed byte ScriptType[128];
+        public fixed byte Message[1024];
+    }
+
+    // Values of Core::ScriptStatus
+    internal enum ScriptStatus
+    {
+        Ok = 0,
+        Failed = 1,
+        ScriptException = 2,
+        InternalError = 3
+    }
+
+    // The entry points Engine binds with --aot, exported under the names
+    // NativeScriptLibrary::export_name() looks up ('ScriptAPI_EngineInterface_<Method>').
+    // Signatures and the status/error convention match the CoreCLR ScriptAPI; strings
+    // arrive as UTF-8. This is the minimal set the host needs to run a world:
+    //   - scripts are created, started within the frame budget and updated in the Update
+    //     phase, in the order they were added;
+    //   - SleepEntity/WakeEntity take the entity's scripts out of the update list (timers
+    //     included), but never compact them;
+    //   - world saves record script types without fields, and restoring fields saved by
+    //     the CoreCLR backend reports ScriptException and keeps the defaults;
+    //   - prefabs, [Replicated] fields and allocation tracking are not supported.
+    internal static unsafe class EngineInterface
+    {
+        private const int UpdatePhase = 1; // ScriptPhase.Update
+        private const int PreUpdatePhase = 0;
+
+        private static bool initialized;
+        private static readonly Dictionary<int, List<Script>> activeScripts = new();
+        private static readonly List<Script> updating = new();
+        private static readonly Queue<Script> startQueue = new();
+        private static readonly Dictionary<int, double> dormant = new(); // Entity -> wake time, 0 if none
+        private static List<Script>? snapshotScripts;
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_Init")]
+        private static int Init(ScriptErrorInfo* error)
+        {
+            try
+            {
+                ClearScriptData();
+                initialized = true;
+                Console.WriteLine(string.Format("[ScriptAPI] NativeAOT script library initialized with {0} script type(s).", ScriptTypes.Names.Length));
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "Init", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_Shutdown")]
+        private static int Shutdown(ScriptErrorInfo* error)
+        {
+            try
+            {
+                ClearScriptData();
+                initialized = false;
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "Shutdown", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_GetScriptTypeId")]
+        private static int GetScriptTypeId(byte* scriptName)
+        {
+            try { return scriptName == null ? -1 : ScriptTypes.GetTypeId(Utf8(scriptName)); }
+            catch (Exception) { return -1; }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_AddScriptById")]
+        private static int AddScriptById(int entityId, int typeId, ScriptErrorInfo* error)
+        {
+            try
+            {
+                return CreateScript(entityId, typeId, error) == null ? (int)ScriptStatus.Failed : (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "AddScriptById", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_RunPendingStarts")]
+        private static int RunPendingStarts(int budgetMicroseconds, ScriptErrorInfo* error)
+        {
+            try
+            {
+                long deadline = Stopwatch.GetTimestamp() + budgetMicroseconds * Stopwatch.Frequency / 1000000;
+                int exceptions = 0;
+                while (startQueue.Count > 0)
+                {
+                    Script script = startQueue.Dequeue();
+                    if (script.TypeId < 0) continue; // Removed before its start
+                    try { script.Start(); }
+                    catch (Exception e)
+                    {
+                        RecordScriptException(error, script, e);
+                        ++exceptions;
+                    }
+                    script.Started = true;
+                    if (!dormant.ContainsKey(script.EntityId)) updating.Add(script);
+                    if (Stopwatch.GetTimestamp() >= deadline) break; // At least one start per frame
+                }
+                return exceptions > 0 ? (int)ScriptStatus.ScriptException : (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "RunPendingStarts", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_ExecutePhase")]
+        private static int ExecutePhase(int phase, ScriptErrorInfo* error)
+        {
+            try
+            {
+                if (!initialized) return (int)ScriptStatus.Ok;
+                if (phase == PreUpdatePhase && dormant.Count > 0) WakeDueEntities();
+                if (phase != UpdatePhase) return (int)ScriptStatus.Ok;
+
+                int exceptions = 0;
+                for (int i = 0; i < updating.Count; ++i)
+                {
+                    try { updating[i].Update(); }
+                    catch (Exception e)
+                    {
+                        RecordScriptException(error, updating[i], e);
+                        ++exceptions;
+                    }
+                }
+                return exceptions > 0 ? (int)ScriptStatus.ScriptException : (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "ExecutePhase", e); }
+        }
+
+        // --- Dormancy ---
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_SleepEntity")]
+        private static int SleepEntity(int entityId, float wakeAfterSeconds, int compact, ScriptErrorInfo* error)
+        {
+            try
+            {
+                if (!initialized) return Fail(error, "SleepEntity called before successful initialization.");
+                if (!activeScripts.ContainsKey(entityId)) return Fail(error, string.Format("Entity {0} has no scripts.", entityId));
+                dormant[entityId] = wakeAfterSeconds > 0.0f ? Now() + wakeAfterSeconds : 0.0;
+                updating.RemoveAll(script => script.EntityId == entityId);
+                return (int)ScriptStatus.Ok; // 'compact' is ignored; the scripts stay in memory
+            }
+            catch (Exception e) { return FailInternal(error, "SleepEntity", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_WakeEntity")]
+        private static int WakeEntity(int entityId, ScriptErrorInfo* error)
+        {
+            try
+            {
+                Wake(entityId);
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "WakeEntity", e); }
+        }
+
+        // --- World snapshot ---
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_CaptureScriptSnapshot")]
+        private static int CaptureScriptSnapshot(int* count, ScriptErrorInfo* error)
+        {
+            *count = 0;
+            try
+            {
+                snapshotScripts = new List<Script>();
+                foreach (List<Script> entityScripts in activeScripts.Values) snapshotScripts.AddRange(entityScripts);
+                *count = snapshotScripts.Count;
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "CaptureScriptSnapshot", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_SerializeSnapshotScript")]
+        private static int SerializeSnapshotScript(int index, int* entityId, byte* typeName, int typeNameCapacity,
+                                                   byte* fields, int fieldCapacity, int* length, ScriptErrorInfo* error)
+        {
+            *entityId = -1;
+            *length = 0;
+            try
+            {
+                if (snapshotScripts == null || index < 0 || index >= snapshotScripts.Count) return Fail(error, "SerializeSnapshotScript called without a capture.");
+
+                Script script = snapshotScripts[index];
+                if (script.TypeId < 0) return (int)ScriptStatus.Ok; // Removed since the capture
+
+                string name = ScriptTypes.Names[script.TypeId];
+                if (Encoding.UTF8.GetByteCount(name) >= typeNameCapacity) {
+                    return Fail(error, string.Format("Script type name too long to snapshot: {0}", name));
+                }
+                CopyUtf8(name, typeName, typeNameCapacity);
+                *entityId = script.EntityId; // No field serializer here: every record is empty
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "SerializeSnapshotScript", e); }
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_ReleaseScriptSnapshot")]
+        private static int ReleaseScriptSnapshot(ScriptErrorInfo* error)
+        {
+            snapshotScripts = null;
+            return (int)ScriptStatus.Ok;
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_RestoreScript")]
+        private static int RestoreScript(int entityId, byte* typeName, byte* fields, int fieldLength, ScriptErrorInfo* error)
+        {
+            try
+            {
+                string name = Utf8(typeName);
+                int typeId = ScriptTypes.GetTypeId(name);
+                if (typeId < 0) return Fail(error, string.Format("Script type '{0}' not found or not discovered.", name));
+                Script? script = CreateScript(entityId, typeId, error);
+                if (script == null) return (int)ScriptStatus.Failed;
+                if (fieldLength > 0) {
+                    RecordScriptException(error, script, new NotSupportedException("The NativeAOT script library doesn't restore script fields."));
+                    return (int)ScriptStatus.ScriptException;
+                }
+                return (int)ScriptStatus.Ok;
+            }
+            catch (Exception e) { return FailInternal(error, "RestoreScript", e); }
+        }
+
+        // --- Optional features the CoreCLR ScriptAPI has ---
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_SetReplication")]
+        private static void SetReplication(int enabled)
+        {
+            if (enabled != 0) Console.WriteLine("[ScriptAPI] Warning: [Replicated] script fields are not replicated by the NativeAOT script library.");
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_GatherReplicated")]
+        private static int GatherReplicated(ScriptErrorInfo* error) => (int)ScriptStatus.Ok;
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_SetAllocationTracking")]
+        private static void SetAllocationTracking(int enabled)
+        {
+            if (enabled != 0) Console.WriteLine("[ScriptAPI] Warning: Allocation tracking is not available in the NativeAOT script library.");
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_LoadPrefabs")]
+        private static int LoadPrefabs(byte* path, ScriptErrorInfo* error) => Fail(error, "Prefabs are not supported by the NativeAOT script library.");
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_GetPrefabId")]
+        private static int GetPrefabId(byte* name) => -1;
+
+        [UnmanagedCallersOnly(EntryPoint = "ScriptAPI_EngineInterface_InstantiatePrefab")]
+        private static int InstantiatePrefab(int prefabId, int count, int* entityIds, ScriptErrorInfo* error)
+        {
+            return Fail(error, "Prefabs are not supported by the NativeAOT script library.");
+        }
+
+        // --- Helpers ---
+
+        private static Script? CreateScript(int entityId, int typeId, ScriptErrorInfo* error)
+        {
+            if (!initialized) {
+                Fail(error, "AddScript called before successful initialization.");
+                return null;
+            }
+            if (typeId < 0 || typeId >= ScriptTypes.Names.Length) {
+                Fail(error, string.Format("Script type id {0} is out of range.", typeId));
+                return null;
+            }
+
+            Script script;
+            try { script = ScriptTypes.Factories[typeId](); }
+            catch (Exception e)
+            {
+                // The script's constructor threw
+                if (error != null) {
+                    error->EntityId = entityId;
+                    CopyUtf8(ScriptTypes.Names[typeId], error->ScriptType, 128);
+                }
+                Fail(error, e.ToString());
+                return null;
+            }
+            script.EntityId = entityId;
+            script.TypeId = typeId;
+            if (!activeScripts.TryGetValue(entityId, out List<Script>? entityScripts)) {
+                entityScripts = new List<Script>();
+                activeScripts.Add(entityId, entityScripts);
+            }
+            entityScripts.Add(script);
+            startQueue.Enqueue(script);
+            Console.WriteLine(string.Format("[ScriptAPI] Script '{0}' added successfully to Entity {1}.", ScriptTypes.Names[typeId], entityId));
+            return script;
+        }
+
+        private static void Wake(int entityId)
+        {
+            if (!dormant.Remove(entityId) || !activeScripts.TryGetValue(entityId, out List<Script>? entityScripts)) return;
+            foreach (Script script in entityScripts) {
+                if (script.Started) updating.Add(script);
+            }
+        }
+
+        private static void WakeDueEntities()
+        {
+            double now = Now();
+            List<int>? due = null;
+            foreach (KeyValuePair<int, double> entry in dormant) {
+                if (entry.Value > 0.0 && entry.Value <= now) (due ??= new List<int>()).Add(entry.Key);
+            }
+            if (due == null) return;
+            foreach (int entityId in due) Wake(entityId);
+        }
+
+        private static double Now() => (double)Stopwatch.GetTimestamp() / Stopwatch.Frequency;
+
+        private static void ClearScriptData()
+        {
+            foreach (List<Script> entityScripts in activeScripts.Values) {
+                foreach (Script script in entityScripts) script.TypeId = -1;
+            }
+            activeScripts.Clear();
+            updating.Clear();
+            startQueue.Clear();
+            dormant.Clear();
+            snapshotScripts = null;
+        }
+
+        private static string Utf8(byte* text) => Marshal.PtrToStringUTF8((IntPtr)text) ?? string.Empty;
+
+        private static void CopyUtf8(string text, byte* buffer, int capacity)
+        {
+            if (capacity <= 0) return;
+            int length = Encoding.UTF8.GetBytes(text, new Span<byte>(buffer, capacity - 1));
+            buffer[length] = 0;
+        }
+
+        private static int Fail(ScriptErrorInfo* error, string message)
+        {
+            if (error != null) CopyUtf8(message, error->Message, 1024);
+            return (int)ScriptStatus.Failed;
+        }
+
+        private static int FailInternal(ScriptErrorInfo* error, string call, Exception e)
+        {
+            if (error != null) CopyUtf8(string.Format("{0} failed inside the script library: {1}", call, e), error->Message, 1024);
+            return (int)ScriptStatus.InternalError;
+        }
+
+        private static void RecordScriptException(ScriptErrorInfo* error, Script script, Exception e)
+        {
+            if (error == null) return;
+            if (error->ExceptionCount++ > 0) return; // Only the first exception is described
+
+            error->EntityId = script.EntityId;
+            CopyUtf8(script.TypeId >= 0 ? ScriptTypes.Names[script.TypeId] : script.GetType().FullName ?? "?", error->ScriptType, 128);
+            CopyUtf8(e.ToString(), error->Message, 1024);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+namespace ScriptAPI
+{
+    // The part of ScriptAPI.Script the NativeAOT library supports: Start() and Update() on
+    // one entity. Scripts written against just these members compile unchanged for both
+    // backends; GetScript<T>(), StartAsync(), Commands and components are CoreCLR only.
+    public abstract class Script
+    {
+        public virtual void Update() { }
+        public virtual void Start() { }
+
+        protected internal int GetEntityId() => EntityId;
+
+        internal int EntityId = -1;
+        internal int TypeId = -1;
+        internal bool Started;
+    }
+
+    // Script types compiled into the library, by full name. NativeAOT can't load assemblies
+    // and trims reflection, so types are listed here rather than discovered; ScriptAPI's
+    // generated registry plays the same role under CoreCLR.
+    internal static class ScriptTypes
+    {
+        internal static readonly string[] Names =
+        {
+            "ManagedScripts.MyFirstScript",
+        };
+        internal static readonly Func<Script>[] Factories =
+        {
+            () => new ManagedScripts.MyFirstScript(),
+        };
+
+        internal static int GetTypeId(string name) => Array.IndexOf(Names, name.Trim());
+    }
+}
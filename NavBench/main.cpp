@@ -0,0 +1,137 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <algorithm> // std::max
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+
+// Include Core library headers
+#include "navigation.h"
+#include "thread_pool.h"
+
+// Pathfinding throughput against thread count:
+//
+//   NavBench [--size <cells>] [--paths <n>] [--seed <n>] [--map <file> [--cell <size>]]
+//
+// Builds a square grid with random walls (or loads a text map), picks random start/goal
+// pairs between open cells, and solves the same batch on 1, 2, 4... threads up to the
+// hardware thread count. Each run reports paths per second and the speedup over one thread.
+// Searches are independent, so the ideal is linear until memory bandwidth or the
+// per-thread search state stops fitting in cache.
+
+constexpr int kDefaultSize = 256;
+constexpr int kDefaultPaths = 4000;
+constexpr unsigned kDefaultSeed = 1234;
+
+namespace
+{
+    // Axis-aligned walls with random gaps, plus patches of slow terrain.
+    Core::NavGrid make_grid(int size, std::mt19937& rng)
+    {
+        Core::NavGrid grid(size, size, 1.0f, { 0.0f, 0.0f, 0.0f });
+        std::uniform_int_distribution<int> coord(0, size - 1);
+        std::uniform_int_distribution<int> length(size / 16 + 1, size / 4 + 1);
+        int walls = size / 4;
+        for (int i = 0; i < walls; ++i) {
+            int x = coord(rng), z = coord(rng), len = length(rng);
+            bool horizontal = (i & 1) == 0;
+            for (int j = 0; j < len; ++j) {
+                if (j % 24 == 23) continue; // Door
+                int cx = horizontal ? x + j : x;
+                int cz = horizontal ? z : z + j;
+                if (cx < size && cz < size) grid.set_cost(cx, cz, 0);
+            }
+        }
+        for (int i = 0; i < walls; ++i) {
+            int x = coord(rng), z = coord(rng), len = length(rng) / 2;
+            for (int dz = 0; dz < len && z + dz < size; ++dz) {
+                for (int dx = 0; dx < len && x + dx < size; ++dx) {
+                    if (grid.cost(x + dx, z + dz) != 0) grid.set_cost(x + dx, z + dz, 3);
+                }
+            }
+        }
+        return grid;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int size = kDefaultSize;
+    int pathCount = kDefaultPaths;
+    unsigned seed = kDefaultSeed;
+    std::string mapPath;
+    float cellSize = 1.0f;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) { size = std::atoi(argv[++i]); }
+        else if (arg == "--paths" && i + 1 < argc) { pathCount = std::atoi(argv[++i]); }
+        else if (arg == "--seed" && i + 1 < argc) { seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10)); }
+        else if (arg == "--map" && i + 1 < argc) { mapPath = argv[++i]; }
+        else if (arg == "--cell" && i + 1 < argc) { cellSize = static_cast<float>(std::atof(argv[++i])); }
+        else { std::cerr << "Warning: Ignoring unknown argument '" << arg << "'." << std::endl; }
+    }
+    if (size < 8 || pathCount <= 0) {
+        std::cerr << "Error: --size must be at least 8 and --paths positive." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 rng(seed);
+    Core::NavGrid grid;
+    if (mapPath.empty()) grid = make_grid(size, rng);
+    else if (!grid.load(mapPath, cellSize, { 0.0f, 0.0f, 0.0f })) return EXIT_FAILURE;
+
+    std::vector<int> open;
+    std::span<const uint8_t> costs = grid.costs();
+    for (size_t cell = 0; cell < costs.size(); ++cell) {
+        if (costs[cell] != 0) open.push_back(static_cast<int>(cell));
+    }
+    if (open.size() < 2) {
+        std::cerr << "Error: The grid has fewer than two open cells." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+    std::vector<std::pair<int, int>> queries(static_cast<size_t>(pathCount));
+    for (auto& query : queries) query = { open[pick(rng)], open[pick(rng)] };
+
+    std::cout << "Grid " << grid.width() << "x" << grid.height() << " (" << open.size() << " open cells), "
+              << pathCount << " paths per run." << std::endl;
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(hardwareThreads);
+
+    double baseline = 0.0;
+    for (unsigned threads : threadCounts) {
+        // The calling thread takes part, so N threads is N - 1 workers
+        std::unique_ptr<Core::ThreadPool> pool;
+        if (threads > 1) pool = std::make_unique<Core::ThreadPool>(threads - 1);
+
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> found{ 0 };
+        auto drain = [&](size_t, size_t) {
+            std::vector<Core::Math::float3> waypoints;
+            size_t localFound = 0;
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < queries.size();) {
+                if (grid.find_path(queries[i].first, queries[i].second, waypoints)) ++localFound;
+            }
+            found.fetch_add(localFound, std::memory_order_relaxed);
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        if (pool) pool->parallel_for(threads, 1, drain);
+        else drain(0, 1);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double pathsPerSecond = static_cast<double>(queries.size()) / seconds;
+        if (threads == 1) baseline = pathsPerSecond;
+        std::cout << "threads=" << threads << " paths_per_s=" << static_cast<long long>(pathsPerSecond)
+                  << " speedup=" << pathsPerSecond / baseline << " found=" << found.load() << "/" << queries.size()
+                  << " ms=" << seconds * 1000.0 << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
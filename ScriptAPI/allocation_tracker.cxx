@@ -0,0 +1,322 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Diagnostics.Tracing.dll>
+
+#include "allocation_tracker.hxx"
+#include "script_registry.hxx"
+
+#include "metrics.h" // Core
+#include <string>
+
+using namespace System::Collections::ObjectModel; // For ReadOnlyCollection
+using namespace System::Threading;                // For Monitor
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        std::string ToUtf8(String^ text)
+        {
+            array<Byte>^ bytes = Text::Encoding::UTF8->GetBytes(text);
+            if (bytes->Length == 0) return std::string();
+            pin_ptr<Byte> pinned = &bytes[0];
+            return std::string(reinterpret_cast<const char*>(pinned), bytes->Length);
+        }
+
+        std::string TypeLabel(int typeId)
+        {
+            return Core::MetricsRegistry::label("script_type", ToUtf8(ScriptTypes::GetTypeName(typeId)));
+        }
+
+        Object^ FindPayload(EventWrittenEventArgs^ e, String^ name)
+        {
+            ReadOnlyCollection<String^>^ names = e->PayloadNames;
+            if (names == nullptr) return nullptr;
+            int index = names->IndexOf(name);
+            return index >= 0 && index < e->Payload->Count ? e->Payload[index] : nullptr;
+        }
+
+        long long CurrentOsThreadId()
+        {
+            // The only OS thread id available without P/Invoke; EventWrittenEventArgs reports the same id.
+#pragma warning(suppress : 4947)
+            return AppDomain::GetCurrentThreadId();
+        }
+    }
+
+    // --- AllocationSampler ---
+
+    AllocationSampler::AllocationSampler(int typeCount)
+    {
+        // OnEventSourceCreated() runs from the base constructor for sources that already
+        // exist, so the runtime provider is enabled before these fields are assigned.
+        // OnEventWritten() ignores events until 'lock' is set.
+        windowStart = gcnew array<long long>(WindowCapacity);
+        windowEnd = gcnew array<long long>(WindowCapacity);
+        windowType = gcnew array<int>(WindowCapacity);
+        objects = gcnew array<double>(typeCount);
+        sampledTypes = gcnew array<String^>(typeCount);
+        openType = -1;
+        mainThreadId = CurrentOsThreadId();
+        lock = gcnew Object();
+    }
+
+    void AllocationSampler::OnEventSourceCreated(EventSource^ source)
+    {
+        if (source->Name == "Microsoft-Windows-DotNETRuntime")
+        {
+            // GCAllocationTick is only raised at Verbose level
+            EnableEvents(source, EventLevel::Verbose, static_cast<EventKeywords>(GcKeyword));
+        }
+    }
+
+    void AllocationSampler::BeginWindow(int typeId)
+    {
+        openStart = DateTime::UtcNow.Ticks;
+        openType = typeId;
+    }
+
+    void AllocationSampler::EndWindow()
+    {
+        long long end = DateTime::UtcNow.Ticks;
+        Monitor::Enter(lock);
+        try
+        {
+            int slot = static_cast<int>(windowCount % WindowCapacity);
+            windowStart[slot] = openStart;
+            windowEnd[slot] = end;
+            windowType[slot] = openType;
+            ++windowCount;
+        }
+        finally
+        {
+            Monitor::Exit(lock);
+        }
+        openType = -1;
+    }
+
+    int AllocationSampler::FindWindow(long long timestampTicks)
+    {
+        // Windows are recorded in time order; binary search the ring for the last window
+        // that started at or before the sample.
+        long long first = windowCount > WindowCapacity ? windowCount - WindowCapacity : 0;
+        long long lo = first;
+        long long hi = windowCount - 1;
+        long long found = -1;
+        while (lo <= hi)
+        {
+            long long mid = lo + (hi - lo) / 2;
+            if (windowStart[static_cast<int>(mid % WindowCapacity)] <= timestampTicks)
+            {
+                found = mid;
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        if (found < 0) return -1;
+        int slot = static_cast<int>(found % WindowCapacity);
+        return timestampTicks <= windowEnd[slot] ? windowType[slot] : -1;
+    }
+
+    void AllocationSampler::OnEventWritten(EventWrittenEventArgs^ e)
+    {
+        if (lock == nullptr || e->EventId != AllocationTickEventId || e->Payload == nullptr) return;
+        if (e->OSThreadId != mainThreadId) return; // Script batches only run on the main thread
+
+        Object^ amount = FindPayload(e, "AllocationAmount64");
+        if (amount == nullptr) amount = FindPayload(e, "AllocationAmount");
+        if (amount == nullptr) return;
+        Object^ size = FindPayload(e, "ObjectSize"); // Missing before runtime event version 4
+        String^ typeName = dynamic_cast<String^>(FindPayload(e, "TypeName"));
+
+        double bytes = Convert::ToDouble(amount);
+        double objectSize = size != nullptr ? Convert::ToDouble(size) : 0.0;
+        long long timestamp = e->TimeStamp.ToUniversalTime().Ticks;
+
+        Monitor::Enter(lock);
+        try
+        {
+            int typeId = FindWindow(timestamp);
+            if (typeId >= 0 && typeId < objects->Length)
+            {
+                objects[typeId] += objectSize > 0.0 ? bytes / objectSize : 1.0;
+                if (typeName != nullptr) sampledTypes[typeId] = typeName;
+            }
+        }
+        finally
+        {
+            Monitor::Exit(lock);
+        }
+    }
+
+    void AllocationSampler::Drain(array<double>^ objectsOut, array<String^>^ sampledTypesOut)
+    {
+        Monitor::Enter(lock);
+        try
+        {
+            int count = Math::Min(objects->Length, objectsOut->Length);
+            for (int id = 0; id < count; ++id)
+            {
+                objectsOut[id] = objects[id];
+                objects[id] = 0.0;
+                if (sampledTypes[id] != nullptr) sampledTypesOut[id] = sampledTypes[id];
+            }
+        }
+        finally
+        {
+            Monitor::Exit(lock);
+        }
+    }
+
+    void AllocationSampler::Reset(int typeCount)
+    {
+        Monitor::Enter(lock);
+        try
+        {
+            // Type ids are reassigned on reload; samples still in flight would be misattributed.
+            windowCount = 0;
+            objects = gcnew array<double>(typeCount);
+            sampledTypes = gcnew array<String^>(typeCount);
+        }
+        finally
+        {
+            Monitor::Exit(lock);
+        }
+    }
+
+    // --- AllocationTracker ---
+
+    void AllocationTracker::OnScriptTypesLoaded()
+    {
+        OnScriptTypesUnloaded();
+        if (!enabled) return;
+
+        Core::MetricsRegistry& registry = Core::MetricsRegistry::instance();
+        typeCount = ScriptTypes::Count;
+        frameBytes = gcnew array<long long>(typeCount);
+        averageBytes = gcnew array<double>(typeCount);
+        allocatingStreak = gcnew array<int>(typeCount);
+        sampledObjects = gcnew array<double>(typeCount);
+        sampledTypes = gcnew array<String^>(typeCount);
+        bytesTotal = new Core::Counter*[typeCount];
+        objectsTotal = new Core::Counter*[typeCount];
+        bytesPerFrame = new Core::Gauge*[typeCount];
+        everyFrame = new Core::Gauge*[typeCount];
+        for (int id = 0; id < typeCount; ++id)
+        {
+            std::string labels = TypeLabel(id);
+            bytesTotal[id] = &registry.counter("engine_script_allocated_bytes_total", "Managed bytes allocated by scripts, by type", labels);
+            objectsTotal[id] = &registry.counter("engine_script_allocated_objects_total", "Estimated managed objects allocated by scripts (sampled), by type", labels);
+            bytesPerFrame[id] = &registry.gauge("engine_script_allocated_bytes_per_frame", "Managed bytes allocated by scripts in the last frame, by type", labels);
+            everyFrame[id] = &registry.gauge("engine_script_allocates_every_frame", "1 if the script type allocated in each recent frame", labels);
+        }
+
+        if (sampler == nullptr)
+        {
+            sampler = gcnew AllocationSampler(typeCount);
+        }
+        else
+        {
+            sampler->Reset(typeCount);
+        }
+        lastPauseTicks = GC::GetTotalPauseDuration().Ticks;
+    }
+
+    void AllocationTracker::OnScriptTypesUnloaded()
+    {
+        for (int id = 0; id < typeCount; ++id)
+        {
+            bytesPerFrame[id]->set(0.0);
+            everyFrame[id]->set(0.0);
+        }
+        delete[] bytesTotal;
+        delete[] objectsTotal;
+        delete[] bytesPerFrame;
+        delete[] everyFrame;
+        bytesTotal = nullptr;
+        objectsTotal = nullptr;
+        bytesPerFrame = nullptr;
+        everyFrame = nullptr;
+        frameBytes = nullptr;
+        averageBytes = nullptr;
+        allocatingStreak = nullptr;
+        sampledObjects = nullptr;
+        sampledTypes = nullptr;
+        typeCount = 0;
+    }
+
+    long long AllocationTracker::BeginBatch(int typeId)
+    {
+        if (sampler != nullptr) sampler->BeginWindow(typeId);
+        return GC::GetAllocatedBytesForCurrentThread();
+    }
+
+    void AllocationTracker::EndBatch(int typeId, long long startBytes)
+    {
+        long long allocated = GC::GetAllocatedBytesForCurrentThread() - startBytes;
+        if (sampler != nullptr) sampler->EndWindow();
+        if (typeId >= 0 && typeId < typeCount) frameBytes[typeId] += allocated;
+    }
+
+    void AllocationTracker::EndFrame()
+    {
+        if (typeCount == 0) return;
+
+        sampler->Drain(sampledObjects, sampledTypes);
+        for (int id = 0; id < typeCount; ++id)
+        {
+            long long bytes = frameBytes[id];
+            frameBytes[id] = 0;
+            averageBytes[id] += (bytes - averageBytes[id]) * AverageWeight;
+
+            bytesTotal[id]->add(static_cast<double>(bytes));
+            objectsTotal[id]->add(sampledObjects[id]);
+            bytesPerFrame[id]->set(static_cast<double>(bytes));
+
+            if (bytes == 0)
+            {
+                if (allocatingStreak[id] >= EveryFrameThreshold) everyFrame[id]->set(0.0);
+                allocatingStreak[id] = 0;
+                continue;
+            }
+            if (++allocatingStreak[id] == EveryFrameThreshold)
+            {
+                everyFrame[id]->set(1.0);
+                String^ sample = sampledTypes[id] != nullptr ? String::Format(", e.g. {0}", sampledTypes[id]) : String::Empty;
+                Console::WriteLine(String::Format("[ScriptAPI] Warning: {0} has allocated every frame for {1} frames (~{2:N0} bytes/frame{3}).",
+                    ScriptTypes::GetTypeName(id), static_cast<int>(EveryFrameThreshold), averageBytes[id], sample));
+            }
+        }
+
+        long long pauseTicks = GC::GetTotalPauseDuration().Ticks;
+        double pauseMs = static_cast<double>(pauseTicks - lastPauseTicks) / TimeSpan::TicksPerMillisecond;
+        lastPauseTicks = pauseTicks;
+        if (pauseMs >= GcPauseReportMs) ReportGcPause(pauseMs);
+    }
+
+    void AllocationTracker::ReportGcPause(double pauseMs)
+    {
+        array<double>^ keys = gcnew array<double>(typeCount);
+        array<int>^ ids = gcnew array<int>(typeCount);
+        for (int id = 0; id < typeCount; ++id)
+        {
+            keys[id] = -averageBytes[id]; // Descending
+            ids[id] = id;
+        }
+        Array::Sort(keys, ids);
+
+        Text::StringBuilder^ top = gcnew Text::StringBuilder();
+        for (int i = 0; i < Math::Min(3, typeCount) && keys[i] < 0.0; ++i)
+        {
+            if (i > 0) top->Append(", ");
+            top->AppendFormat("{0} (~{1:N0} bytes/frame)", ScriptTypes::GetTypeName(ids[i]), -keys[i]);
+        }
+        if (top->Length == 0) return; // Not caused by scripts
+        Console::WriteLine(String::Format("[ScriptAPI] GC paused {0:F1} ms; top script allocators: {1}", pauseMs, top));
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,99 @@
+#pragma once
+
+using namespace System;
+using namespace System::Diagnostics::Tracing;
+
+namespace Core
+{
+    class Counter;
+    class Gauge;
+}
+
+namespace ScriptAPI
+{
+    // In-process listener for the runtime's GCAllocationTick events (one per ~100 KB
+    // allocated on a thread). Events arrive late on a dispatch thread, so the main thread
+    // records when each script type batch ran and samples are matched to those windows by
+    // timestamp. Each sample stands for AllocationAmount bytes of objects of the sampled
+    // object's size, which gives the object count estimate.
+    ref class AllocationSampler sealed : EventListener
+    {
+    internal:
+        AllocationSampler(int typeCount);
+
+        // Main thread, around each script type batch
+        void BeginWindow(int typeId);
+        void EndWindow();
+
+        // Moves the estimated object counts per type since the last call into 'objects'
+        // and the most recently sampled allocated type name into 'sampledTypes'.
+        void Drain(array<double>^ objects, array<String^>^ sampledTypes);
+        void Reset(int typeCount);
+
+    protected:
+        virtual void OnEventSourceCreated(EventSource^ source) override;
+        virtual void OnEventWritten(EventWrittenEventArgs^ e) override;
+
+    private:
+        int FindWindow(long long timestampTicks);
+
+        literal int WindowCapacity = 8192; // Several seconds of batches; samples lag behind
+        literal int AllocationTickEventId = 10;
+        literal long long GcKeyword = 0x1;
+
+        Object^ lock;
+        array<long long>^ windowStart;
+        array<long long>^ windowEnd;
+        array<int>^ windowType;
+        long long windowCount;
+        long long openStart;
+        int openType;
+        long long mainThreadId;
+
+        array<double>^ objects;
+        array<String^>^ sampledTypes;
+    };
+
+    // Optional per-script-type allocation accounting. The bytes each type's Update() batch
+    // allocates are measured exactly with GC.GetAllocatedBytesForCurrentThread(); object
+    // counts come from AllocationSampler. Types that allocate in every one of the last
+    // EveryFrameThreshold frames are flagged, and GC pauses above GcPauseReportMs are
+    // logged with the heaviest allocators.
+    ref class AllocationTracker abstract sealed
+    {
+    internal:
+        static property bool Enabled { bool get() { return enabled; } void set(bool value) { enabled = value; } }
+
+        static void OnScriptTypesLoaded();
+        static void OnScriptTypesUnloaded();
+
+        // Around each script type batch in ExecutePhase(); only call when Enabled.
+        static long long BeginBatch(int typeId);
+        static void EndBatch(int typeId, long long startBytes);
+
+        // Publishes the previous frame's numbers; called once per frame.
+        static void EndFrame();
+
+    private:
+        static void ReportGcPause(double pauseMs);
+
+        literal int EveryFrameThreshold = 120;
+        literal double GcPauseReportMs = 5.0;
+        literal double AverageWeight = 0.05; // Of the newest frame in the moving average
+
+        static bool enabled = false;
+        static int typeCount = 0;
+        static array<long long>^ frameBytes = nullptr;
+        static array<double>^ averageBytes = nullptr;
+        static array<int>^ allocatingStreak = nullptr;
+        static array<double>^ sampledObjects = nullptr;
+        static array<String^>^ sampledTypes = nullptr;
+        static AllocationSampler^ sampler = nullptr;
+        static long long lastPauseTicks = 0;
+
+        static Core::Counter** bytesTotal = nullptr;
+        static Core::Counter** objectsTotal = nullptr;
+        static Core::Gauge** bytesPerFrame = nullptr;
+        static Core::Gauge** everyFrame = nullptr;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,250 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+#using <System.Threading.dll>
+#using <System.Threading.Thread.dll>
+
+#include "commands.hxx"
+#include "script_registry.hxx"
+
+#include "entity_ids.h" // Core
+
+using namespace System::Runtime::CompilerServices; // For Unsafe
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        const int InitialPayloadCapacity = 256;
+    }
+
+    array<Byte>^ Commands::Buffer::ReservePayload(int size, int% offset)
+    {
+        if (Payload == nullptr || PayloadUsed + size > Payload->Length) {
+            int capacity = System::Math::Max(InitialPayloadCapacity, Payload != nullptr ? Payload->Length * 2 : 0);
+            Payload = gcnew array<Byte>(System::Math::Max(capacity, size));
+            PayloadUsed = 0; // Commands recorded earlier keep the old array
+        }
+        offset = PayloadUsed;
+        PayloadUsed += size;
+        return Payload;
+    }
+
+    Commands::Buffer^ Commands::GetThreadBuffer()
+    {
+        Buffer^ buffer = threadBuffer;
+        if (buffer == nullptr)
+        {
+            // Once per thread; recording itself never takes the lock
+            buffer = gcnew Buffer();
+            Monitor::Enter(registrationLock);
+            try { buffers->Add(buffer); }
+            finally { Monitor::Exit(registrationLock); }
+            threadBuffer = buffer;
+        }
+        return buffer;
+    }
+
+    void Commands::Record(Command command)
+    {
+        // Take the list while adding so Drain() can't read it mid-Add; it is only ever
+        // missing while one side is copying, so the spin is short
+        Buffer^ buffer = GetThreadBuffer();
+        Append(buffer, TakeRecorded(buffer), command);
+    }
+
+    void Commands::Append(Buffer^ buffer, List<Command>^ recorded, Command command)
+    {
+        command.Sequence = Interlocked::Increment(nextSequence);
+        recorded->Add(command);
+        Volatile::Write(buffer->Recorded, recorded);
+    }
+
+    List<Command>^ Commands::TakeRecorded(Buffer^ buffer)
+    {
+        List<Command>^ recorded = Interlocked::Exchange(buffer->Recorded, static_cast<List<Command>^>(nullptr));
+        if (recorded != nullptr) return recorded;
+
+        SpinWait spin;
+        while ((recorded = Interlocked::Exchange(buffer->Recorded, static_cast<List<Command>^>(nullptr))) == nullptr) {
+            spin.SpinOnce();
+        }
+        return recorded;
+    }
+
+    int Commands::Spawn()
+    {
+        Command command = Command();
+        command.Type = CommandType::Spawn;
+        command.EntityId = Core::EntityIds::instance().allocate();
+        Record(command);
+        return command.EntityId;
+    }
+
+    int Commands::Spawn(Float3 position)
+    {
+        Command command = Command();
+        command.Type = CommandType::Spawn;
+        command.EntityId = Core::EntityIds::instance().allocate();
+        command.Position = position;
+        command.HasPosition = true;
+        Record(command);
+        return command.EntityId;
+    }
+
+    generic <typename T>
+    void Commands::AddScript(int entityId)
+    {
+        AddScript(entityId, T::typeid);
+    }
+
+    void Commands::AddScript(int entityId, Type^ scriptType)
+    {
+        if (scriptType == nullptr) throw gcnew ArgumentNullException("scriptType");
+        int typeId = ScriptTypes::GetTypeId(scriptType);
+        if (typeId < 0) throw gcnew ArgumentException(String::Format("'{0}' is not a loaded script type.", scriptType->FullName), "scriptType");
+
+        Command command = Command();
+        command.Type = CommandType::AddScript;
+        command.EntityId = entityId;
+        command.TypeId = typeId;
+        Record(command);
+    }
+
+    void Commands::AddScript(int entityId, String^ scriptTypeName)
+    {
+        if (scriptTypeName == nullptr) throw gcnew ArgumentNullException("scriptTypeName");
+        int typeId = ScriptTypes::GetTypeId(scriptTypeName);
+        if (typeId < 0) throw gcnew ArgumentException(String::Format("'{0}' is not a loaded script type.", scriptTypeName), "scriptTypeName");
+
+        Command command = Command();
+        command.Type = CommandType::AddScript;
+        command.EntityId = entityId;
+        command.TypeId = typeId;
+        Record(command);
+    }
+
+    void Commands::RemoveScript(Script^ script)
+    {
+        if (script == nullptr) throw gcnew ArgumentNullException("script");
+
+        Command command = Command();
+        command.Type = CommandType::RemoveScript;
+        command.EntityId = script->GetEntityId();
+        command.Target = script;
+        Record(command);
+    }
+
+    generic <typename T>
+    void Commands::AddComponent(int entityId, T component)
+    {
+        Command command = Command();
+        command.Type = CommandType::AddComponent;
+        command.EntityId = entityId;
+        command.Store = Components::GetStore<T>(); // Checks that T holds no references
+
+        // The bytes go into the thread's payload array, which is owned along with its list
+        Buffer^ buffer = GetThreadBuffer();
+        List<Command>^ recorded = TakeRecorded(buffer);
+        int offset = 0;
+        command.Payload = buffer->ReservePayload(Unsafe::SizeOf<T>(), offset);
+        command.PayloadOffset = offset;
+        pin_ptr<Byte> destination = &command.Payload[offset];
+        Unsafe::WriteUnaligned<T>(static_cast<Byte*>(destination), component);
+        Append(buffer, recorded, command);
+    }
+
+    generic <typename T>
+    void Commands::RemoveComponent(int entityId)
+    {
+        Command command = Command();
+        command.Type = CommandType::RemoveComponent;
+        command.EntityId = entityId;
+        command.Store = Components::GetStore<T>();
+        Record(command);
+    }
+
+    void Commands::Destroy(int entityId)
+    {
+        Command command = Command();
+        command.Type = CommandType::Destroy;
+        command.EntityId = entityId;
+        Record(command);
+    }
+
+    void Commands::Sleep(int entityId)
+    {
+        Sleep(entityId, 0.0f, false);
+    }
+
+    void Commands::Sleep(int entityId, float wakeAfterSeconds, bool compact)
+    {
+        Command command = Command();
+        command.Type = CommandType::Sleep;
+        command.EntityId = entityId;
+        command.Seconds = wakeAfterSeconds;
+        command.Compact = compact;
+        Record(command);
+    }
+
+    void Commands::Wake(int entityId)
+    {
+        Command command = Command();
+        command.Type = CommandType::Wake;
+        command.EntityId = entityId;
+        Record(command);
+    }
+
+    void Commands::RecordInstantiate(int prefabId, array<int>^ entityIds)
+    {
+        Command command = Command();
+        command.Type = CommandType::Instantiate;
+        command.TypeId = prefabId;
+        command.EntityIds = entityIds;
+        Record(command);
+    }
+
+    void Commands::Drain(List<Command>^ out)
+    {
+        Monitor::Enter(registrationLock);
+        try
+        {
+            int start = out->Count;
+            for (int i = buffers->Count - 1; i >= 0; --i)
+            {
+                Buffer^ buffer = buffers[i];
+                List<Command>^ recorded = TakeRecorded(buffer);
+                out->AddRange(recorded);
+                recorded->Clear(); // Keeps capacity
+                if (buffer->PayloadUsed > 0) {
+                    // The drained commands still point into the payload array; start a new one
+                    buffer->Payload = nullptr;
+                    buffer->PayloadUsed = 0;
+                }
+                Volatile::Write(buffer->Recorded, recorded);
+
+                // Forget buffers of threads that have exited
+                if (!buffer->Owner->IsAlive) buffers->RemoveAt(i);
+            }
+
+            // Each buffer is already in order; one sort interleaves the threads
+            if (out->Count - start > 1) out->Sort(start, out->Count - start, bySequence);
+        }
+        finally
+        {
+            Monitor::Exit(registrationLock);
+        }
+    }
+
+    void Commands::Clear()
+    {
+        List<Command>^ discarded = gcnew List<Command>();
+        Drain(discarded);
+        if (discarded->Count > 0)
+        {
+            Console::WriteLine(String::Format("[ScriptAPI] Discarded {0} pending script command(s).", discarded->Count));
+        }
+    }
+
+} // namespace ScriptAPI
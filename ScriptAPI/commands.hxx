@@ -0,0 +1,119 @@
+#pragma once
+
+#include "script.hxx"
+#include "simd_math.hxx" // Float3
+#include "components.hxx"
+
+using namespace System;
+using namespace System::Threading;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    enum class CommandType
+    {
+        Spawn,
+        AddScript,
+        RemoveScript,
+        AddComponent,
+        RemoveComponent,
+        Destroy,
+        Instantiate,
+        Sleep,
+        Wake
+    };
+
+    value struct Command
+    {
+        long long Sequence; // Global recording order across threads
+        CommandType Type;
+        int EntityId;
+        int TypeId;         // AddScript; prefab id for Instantiate
+        Script^ Target;     // RemoveScript
+        Float3 Position;    // Spawn
+        bool HasPosition;
+        ComponentStoreBase^ Store; // AddComponent, RemoveComponent
+        array<Byte>^ Payload;      // AddComponent: the component's bytes, at PayloadOffset
+        int PayloadOffset;
+        array<int>^ EntityIds;     // Instantiate
+        float Seconds;             // Sleep: wake timer, 0 for none
+        bool Compact;              // Sleep
+    };
+
+    // Structural changes requested while scripts run.
+    // Each thread records into its own buffer without locking; the engine plays every
+    // buffer back in one flush, in recording order, at the end of each phase. A buffer's
+    // list is exchanged out by whichever side uses it, so a thread still recording when
+    // the phase ends lands its command in this flush or the next one.
+    public ref class Commands abstract sealed
+    {
+    public:
+        // Reserves an entity id now; the entity gets a transform when the commands are flushed.
+        static int Spawn();
+        static int Spawn(Float3 position);
+
+        // The new script is added during the flush; its Start() is then queued like any other.
+        generic <typename T> where T : Script
+        static void AddScript(int entityId);
+        static void AddScript(int entityId, Type^ scriptType);
+        static void AddScript(int entityId, String^ scriptTypeName);
+
+        static void RemoveScript(Script^ script);
+
+        // Adds (or replaces) the entity's T component during the flush.
+        generic <typename T> where T : value class
+        static void AddComponent(int entityId, T component);
+        generic <typename T> where T : value class
+        static void RemoveComponent(int entityId);
+
+        // Removes all scripts and components of the entity, then its transform and spatial entry.
+        static void Destroy(int entityId);
+
+        // Puts the entity to sleep during the flush: its scripts get no Update() until it
+        // wakes through Wake(), its timer or an activation region (see Dormancy).
+        static void Sleep(int entityId);
+        // 'wakeAfterSeconds' > 0 sets a timer. With 'compact', the scripts are serialized
+        // and released; on waking they are recreated with those fields and Start() again.
+        static void Sleep(int entityId, float wakeAfterSeconds, bool compact);
+        static void Wake(int entityId);
+
+    internal:
+        // Recorded by Prefabs::Instantiate(); the ids are already allocated.
+        static void RecordInstantiate(int prefabId, array<int>^ entityIds);
+        // Appends every recorded command to 'out' in recording order and empties the buffers.
+        static void Drain(List<Command>^ out);
+        // Drops pending commands (before a reload).
+        static void Clear();
+
+    private:
+        ref class Buffer sealed
+        {
+        public:
+            Buffer() : Recorded(gcnew List<Command>()), Owner(Thread::CurrentThread), Payload(nullptr), PayloadUsed(0) {}
+
+            // Copies of added components, so AddComponent<T>() doesn't box. Like Recorded,
+            // only touched by whichever side holds the list.
+            array<Byte>^ ReservePayload(int size, int% offset);
+
+            List<Command>^ Recorded;
+            Thread^ Owner;
+            array<Byte>^ Payload;
+            int PayloadUsed;
+        };
+
+        static Buffer^ GetThreadBuffer();
+        static void Record(Command command);
+        // Stamps the command, adds it to the taken list and hands the list back.
+        static void Append(Buffer^ buffer, List<Command>^ recorded, Command command);
+        // Exchanges the buffer's list out, waiting if the other side holds it; the caller
+        // puts it back with Volatile::Write.
+        static List<Command>^ TakeRecorded(Buffer^ buffer);
+        static int CompareSequence(Command a, Command b) { return a.Sequence.CompareTo(b.Sequence); }
+
+        [ThreadStatic] static Buffer^ threadBuffer;
+        static List<Buffer^>^ buffers = gcnew List<Buffer^>();
+        static Object^ registrationLock = gcnew Object();
+        static IComparer<Command>^ bySequence = Comparer<Command>::Create(gcnew Comparison<Command>(&Commands::CompareSequence));
+        static long long nextSequence = 0;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,271 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+#using <System.Reflection.dll>
+#using <System.Threading.dll>
+
+#include "components.hxx"
+#include "execution_plan.hxx" // ExecutionPlan::GetPhase
+#include "script_registry.hxx" // IComponentSystemRegistry
+
+using namespace System::Threading; // For Monitor
+using namespace System::Runtime::CompilerServices; // For RuntimeHelpers, Unsafe
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        const int InitialCapacity = 16;
+    }
+
+    // --- ComponentStoreBase ---
+
+    ComponentStoreBase::ComponentStoreBase()
+        : count(0)
+        , entities(gcnew array<int>(0))
+        , indexOf(gcnew Dictionary<int, int>())
+        , chunkVersions(gcnew array<UInt32>(0))
+        , lastChange(0)
+    {
+    }
+
+    int ComponentStoreBase::IndexOf(int entityId)
+    {
+        int index;
+        return indexOf->TryGetValue(entityId, index) ? index : -1;
+    }
+
+    int ComponentStoreBase::Acquire(int entityId)
+    {
+        int index;
+        if (indexOf->TryGetValue(entityId, index)) return index;
+
+        if (count == entities->Length) {
+            int capacity = System::Math::Max(InitialCapacity, entities->Length * 2);
+            Array::Resize(entities, capacity);
+            Array::Resize(chunkVersions, (capacity + ChunkSize - 1) >> ChunkShift);
+            Grow(capacity);
+        }
+        index = count++;
+        entities[index] = entityId;
+        indexOf[entityId] = index;
+        MarkChanged(index);
+        return index;
+    }
+
+    bool ComponentStoreBase::Remove(int entityId)
+    {
+        int index;
+        if (!indexOf->TryGetValue(entityId, index)) return false;
+        indexOf->Remove(entityId);
+
+        // Swap the last element into the hole so the live range stays dense
+        int last = --count;
+        if (index != last) {
+            Move(last, index);
+            entities[index] = entities[last];
+            indexOf[entities[index]] = index;
+            MarkChanged(index); // A different entity lives here now
+        }
+        Reset(last);
+        return true;
+    }
+
+    void ComponentStoreBase::MarkChanged(int index)
+    {
+        if (static_cast<unsigned int>(index) >= static_cast<unsigned int>(count)) throw gcnew ArgumentOutOfRangeException("index");
+        chunkVersions[index >> ChunkShift] = changeVersion;
+        lastChange = changeVersion;
+    }
+
+    void ComponentStoreBase::MarkAllChanged()
+    {
+        int chunks = (count + ChunkSize - 1) >> ChunkShift;
+        for (int chunk = 0; chunk < chunks; ++chunk) chunkVersions[chunk] = changeVersion;
+        if (chunks > 0) lastChange = changeVersion;
+    }
+
+    int ComponentStoreBase::CollectChanged(UInt32% lastVersion, List<int>^ entityIds)
+    {
+        if (entityIds == nullptr) throw gcnew ArgumentNullException("entityIds");
+
+        UInt32 since = lastVersion;
+        lastVersion = AdvanceVersion();
+        if (lastChange <= since) return 0;
+
+        int added = 0;
+        int chunks = (count + ChunkSize - 1) >> ChunkShift;
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            if (chunkVersions[chunk] <= since) continue;
+            int begin = chunk << ChunkShift;
+            int end = System::Math::Min(begin + ChunkSize, count);
+            for (int i = begin; i < end; ++i) entityIds->Add(entities[i]);
+            added += end - begin;
+        }
+        return added;
+    }
+
+    // --- ComponentStore<T> ---
+
+    generic <typename T>
+    ComponentStore<T>::ComponentStore()
+        : components(gcnew array<T>(0))
+    {
+    }
+
+    generic <typename T>
+    void ComponentStore<T>::Add(int entityId, T component)
+    {
+        components[Acquire(entityId)] = component;
+    }
+
+    generic <typename T>
+    void ComponentStore<T>::AddFrom(int entityId, array<Byte>^ payload, int offset)
+    {
+        pin_ptr<Byte> source = &payload[offset];
+        Add(entityId, Unsafe::ReadUnaligned<T>(static_cast<Byte*>(source)));
+    }
+
+    generic <typename T>
+    void ComponentStore<T>::Set(int index, T component)
+    {
+        MarkChanged(index); // Range-checks against Count
+        components[index] = component;
+    }
+
+    generic <typename T>
+    void ComponentStore<T>::Grow(int capacity)
+    {
+        array<T>^ grown = GC::AllocateArray<T>(capacity, true); // Pinned object heap
+        Array::Copy(components, grown, Count);
+        components = grown;
+    }
+
+    // --- ComponentSystem<T> ---
+
+    generic <typename T>
+    void ComponentSystem<T>::Run()
+    {
+        if (store == nullptr) store = Components::GetStore<T>();
+        if (store->Count > 0) Update(store);
+    }
+
+    // --- ChangedSystem<T> ---
+
+    generic <typename T>
+    ChangedSystem<T>::ChangedSystem()
+        : store(nullptr)
+        , lastVersion(0)
+        , changed(gcnew List<int>())
+    {
+    }
+
+    generic <typename T>
+    void ChangedSystem<T>::Run()
+    {
+        if (store == nullptr) store = Components::GetStore<T>();
+        changed->Clear();
+        if (store->CollectChanged(lastVersion, changed) == 0) return;
+
+        OnChanged(store, changed);
+        lastVersion = ComponentStoreBase::AdvanceVersion(); // Skip what OnChanged() wrote
+    }
+
+    // --- Components ---
+
+    generic <typename T>
+    ComponentStore<T>^ Components::GetStore()
+    {
+        Monitor::Enter(storesLock);
+        try {
+            ComponentStoreBase^ store;
+            if (!stores->TryGetValue(T::typeid, store)) {
+                if (RuntimeHelpers::IsReferenceOrContainsReferences<T>()) {
+                    throw gcnew ArgumentException(String::Format("Component type '{0}' must not contain reference fields.", T::typeid->FullName));
+                }
+                store = gcnew ComponentStore<T>();
+                stores->Add(T::typeid, store);
+            }
+            return safe_cast<ComponentStore<T>^>(store);
+        }
+        finally { Monitor::Exit(storesLock); }
+    }
+
+    void Components::RemoveEntity(int entityId)
+    {
+        Monitor::Enter(storesLock);
+        try {
+            for each (ComponentStoreBase^ store in stores->Values) store->Remove(entityId);
+        }
+        finally { Monitor::Exit(storesLock); }
+    }
+
+    void Components::Clear()
+    {
+        Monitor::Enter(storesLock);
+        try { stores->Clear(); }
+        finally { Monitor::Exit(storesLock); }
+    }
+
+    array<array<ComponentSystemBase^>^>^ Components::CreateSystems(Assembly^ assembly, int phaseCount)
+    {
+        array<List<ComponentSystemBase^>^>^ byPhase = gcnew array<List<ComponentSystemBase^>^>(phaseCount);
+        for (int phase = 0; phase < phaseCount; ++phase) byPhase[phase] = gcnew List<ComponentSystemBase^>();
+
+        IComponentSystemRegistry^ registry = dynamic_cast<IComponentSystemRegistry^>(ScriptTypes::Registry);
+        if (registry != nullptr) {
+            // Already sorted by type name; direct constructor calls, no reflection
+            array<String^>^ names = registry->SystemNames;
+            array<int>^ phases = registry->SystemPhases;
+            array<Func<ComponentSystemBase^>^>^ factories = registry->SystemFactories;
+            if (names->Length != phases->Length || names->Length != factories->Length) {
+                Console::Error->WriteLine("[ScriptAPI] Error: Generated component system registry is inconsistent.");
+            }
+            else {
+                for (int i = 0; i < factories->Length; ++i) {
+                    if (phases[i] < 0 || phases[i] >= phaseCount) continue;
+                    try { byPhase[phases[i]]->Add(factories[i]()); }
+                    catch (Exception^ e) {
+                        Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Could not create component system {0}: {1}", names[i], e->Message));
+                    }
+                }
+            }
+        }
+        else {
+            ScanSystemTypes(assembly, byPhase);
+        }
+
+        array<array<ComponentSystemBase^>^>^ systems = gcnew array<array<ComponentSystemBase^>^>(phaseCount);
+        for (int phase = 0; phase < phaseCount; ++phase) {
+            systems[phase] = byPhase[phase]->ToArray();
+            for each (ComponentSystemBase^ system in systems[phase]) {
+                Console::WriteLine(String::Format("[ScriptAPI]   {0}: system {1}", static_cast<ScriptPhase>(phase), system->GetType()->Name));
+            }
+        }
+        return systems;
+    }
+
+    void Components::ScanSystemTypes(Assembly^ assembly, array<List<ComponentSystemBase^>^>^ byPhase)
+    {
+        // Fallback for assemblies built without the generator, with the same filter
+        List<Type^>^ types = gcnew List<Type^>();
+        for each (Type^ type in assembly->GetExportedTypes()) {
+            if (type->IsAbstract || type->ContainsGenericParameters || !type->IsSubclassOf(ComponentSystemBase::typeid)) continue;
+            if (type->GetConstructor(Type::EmptyTypes) == nullptr) continue;
+            types->Add(type);
+        }
+        types->Sort(gcnew Comparison<Type^>(&Components::CompareByName));
+
+        for each (Type^ type in types) {
+            try {
+                ComponentSystemBase^ system = safe_cast<ComponentSystemBase^>(Activator::CreateInstance(type));
+                byPhase[static_cast<int>(ExecutionPlan::GetPhase(type))]->Add(system);
+            }
+            catch (Exception^ e) {
+                Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Could not create component system {0}: {1}", type->FullName, e->Message));
+            }
+        }
+    }
+
+} // namespace ScriptAPI
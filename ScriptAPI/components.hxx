@@ -0,0 +1,196 @@
+#pragma once
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Reflection;
+
+namespace ScriptAPI
+{
+    // Struct component model, alongside Script.
+    //
+    // Components are plain structs kept densely per type in a ComponentStore; stateless
+    // ComponentSystem classes update a whole store at once. A store is one pinned array per
+    // component type rather than one object per entity, so it adds nothing to GC mark
+    // time and iterates linearly. For example:
+    //
+    //   public struct Spinner { public float Angle, Speed; }
+    //
+    //   [ExecutionPhase(ScriptPhase.Update)]
+    //   public sealed class SpinnerSystem : ComponentSystem<Spinner>
+    //   {
+    //       public override void Update(ComponentStore<Spinner> store)
+    //       {
+    //           foreach (ref Spinner s in store.Components.AsSpan(0, store.Count)) s.Angle += s.Speed;
+    //       }
+    //   }
+    //
+    // Components are added and removed through Commands, like scripts.
+    //
+    // Stores track changes per chunk of ChunkSize consecutive elements, so readers can ask
+    // for what changed instead of scanning: CollectChanged() from scripts, or a
+    // ChangedSystem<T> that only runs when something did. For example:
+    //
+    //   uint seen;        // Per reader; starts at 0, so the first call reports everything
+    //   List<int> changed = new List<int>();
+    //   ...
+    //   changed.Clear();
+    //   store.CollectChanged(ref seen, changed);
+
+    // Type-erased part of a store: the entity of each element and the swap-remove logic.
+    public ref class ComponentStoreBase abstract
+    {
+    public:
+        property int Count { int get() { return count; } }
+        // Entity of each live element, in the same order as the component array.
+        property array<int>^ Entities { array<int>^ get() { return entities; } }
+        property Type^ ComponentType { virtual Type^ get() abstract; }
+
+        bool Contains(int entityId) { return indexOf->ContainsKey(entityId); }
+        // Dense index of the entity's component, -1 if it has none. Removing a component
+        // moves the last one into its slot, so indices are only stable between flushes.
+        int IndexOf(int entityId);
+
+        // --- Change tracking ---
+        // Adding a component, ComponentStore::Set() and MarkChanged() stamp the element's
+        // chunk with the current change version. Writes made directly through the
+        // Components array are only seen once MarkChanged() or MarkAllChanged() is called.
+        literal int ChunkSize = 64;
+        void MarkChanged(int index);
+        void MarkAllChanged();
+        // Appends the entities of every chunk changed since 'lastVersion' and advances
+        // 'lastVersion' past them, so the next call reports only later changes. Chunks are
+        // reported whole, so some of the entities may be unchanged; removed entities are not
+        // reported. Returns the number appended.
+        int CollectChanged(UInt32% lastVersion, List<int>^ entityIds);
+
+    internal:
+        ComponentStoreBase();
+
+        // Returns the current change version and starts a new one, so writes made after a
+        // reader's collection are newer than what it saw.
+        static UInt32 AdvanceVersion() { return changeVersion++; }
+
+        // Adds the component whose bytes Commands::AddComponent() copied to 'payload'.
+        virtual void AddFrom(int entityId, array<Byte>^ payload, int offset) abstract;
+        bool Remove(int entityId);
+
+        // Returns the slot for 'entityId', appending one if it has none.
+        int Acquire(int entityId);
+        virtual void Grow(int capacity) abstract;
+        virtual void Move(int from, int to) abstract;
+        virtual void Reset(int index) abstract;
+
+    private:
+        literal int ChunkShift = 6; // log2(ChunkSize)
+
+        int count;
+        array<int>^ entities;
+        Dictionary<int, int>^ indexOf;
+        array<UInt32>^ chunkVersions;
+        UInt32 lastChange; // Newest chunk version, to skip unchanged stores in O(1)
+
+        static UInt32 changeVersion = 1;
+    };
+
+    generic <typename T> where T : value class
+    public ref class ComponentStore sealed : ComponentStoreBase
+    {
+    public:
+        // The first Count elements are live. The array lives on the pinned object heap, so
+        // its address is stable and can be passed to native code; it is replaced when the
+        // store grows, so don't keep it across frames.
+        property array<T>^ Components { array<T>^ get() { return components; } }
+        property Type^ ComponentType { virtual Type^ get() override { return T::typeid; } }
+
+        // Writes the element at 'index' and marks its chunk changed.
+        void Set(int index, T component);
+
+    internal:
+        ComponentStore();
+
+        // Replaces the entity's component if it already has one.
+        void Add(int entityId, T component);
+        virtual void AddFrom(int entityId, array<Byte>^ payload, int offset) override;
+        virtual void Grow(int capacity) override;
+        virtual void Move(int from, int to) override { components[to] = components[from]; }
+        virtual void Reset(int index) override { components[index] = T(); }
+
+    private:
+        array<T>^ components;
+    };
+
+    // Stateless bulk update of one component type. One instance of each system type in the
+    // script assembly is created at load; it runs once per frame in its [ExecutionPhase]
+    // (default Update), after that phase's scripts, and only while the store is non-empty.
+    // Like scripts, system types must be public with a public parameterless constructor.
+    public ref class ComponentSystemBase abstract
+    {
+    internal:
+        virtual void Run() abstract;
+    };
+
+    generic <typename T> where T : value class
+    public ref class ComponentSystem abstract : ComponentSystemBase
+    {
+    public:
+        // Structural changes (adding/removing components, destroying entities) must go
+        // through Commands.
+        virtual void Update(ComponentStore<T>^ store) abstract;
+
+    internal:
+        virtual void Run() override;
+
+    private:
+        ComponentStore<T>^ store; // Stores live as long as the systems: both go on reload
+    };
+
+    // Component system that runs only when components of T were added or changed since its
+    // last run, with the entities of the changed chunks. Its own writes to the store during
+    // OnChanged() are not reported back to it.
+    generic <typename T> where T : value class
+    public ref class ChangedSystem abstract : ComponentSystemBase
+    {
+    public:
+        virtual void OnChanged(ComponentStore<T>^ store, List<int>^ entityIds) abstract;
+
+    protected:
+        ChangedSystem();
+
+    internal:
+        virtual void Run() override;
+
+    private:
+        ComponentStore<T>^ store;
+        UInt32 lastVersion;
+        List<int>^ changed;
+    };
+
+    public ref class Components abstract sealed
+    {
+    public:
+        // The store for T, created on first use. T must not contain references, so its
+        // array can be pinned.
+        generic <typename T> where T : value class
+        static ComponentStore<T>^ GetStore();
+
+    internal:
+        // Drops the entity's components from every store (Destroy).
+        static void RemoveEntity(int entityId);
+        // Drops every store (before a reload).
+        static void Clear();
+        // One instance of every concrete system type in 'assembly', per phase, ordered by
+        // type name. Uses the generated registry (see IComponentSystemRegistry) if the
+        // assembly has one, else scans its exported types.
+        static array<array<ComponentSystemBase^>^>^ CreateSystems(Assembly^ assembly, int phaseCount);
+
+    private:
+        static void ScanSystemTypes(Assembly^ assembly, array<List<ComponentSystemBase^>^>^ byPhase);
+        static int CompareByName(Type^ a, Type^ b) { return String::CompareOrdinal(a->FullName, b->FullName); }
+
+        static Dictionary<Type^, ComponentStoreBase^>^ stores = gcnew Dictionary<Type^, ComponentStoreBase^>();
+        static Object^ storesLock = gcnew Object();
+    };
+} // namespace ScriptAPI
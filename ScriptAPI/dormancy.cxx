@@ -0,0 +1,140 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+
+#include "dormancy.hxx"
+
+#include "activation_regions.h" // Core
+#include "metrics.h"            // Core
+#include "spatial_index.h"      // Core
+
+using namespace System::Diagnostics; // For Stopwatch
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        constexpr int kInitialRegionHits = 4096;
+    }
+
+    bool Dormancy::IsDormant(int entityId)
+    {
+        return entities != nullptr && entities->ContainsKey(entityId);
+    }
+
+    DormantEntity^ Dormancy::Find(int entityId)
+    {
+        DormantEntity^ entity;
+        if (entities == nullptr || !entities->TryGetValue(entityId, entity)) return nullptr;
+        return entity;
+    }
+
+    double Dormancy::Now()
+    {
+        return static_cast<double>(Stopwatch::GetTimestamp()) / Stopwatch::Frequency;
+    }
+
+    DormantEntity^ Dormancy::Sleep(int entityId, float wakeAfterSeconds)
+    {
+        if (entities == nullptr) {
+            entities = gcnew Dictionary<int, DormantEntity^>();
+            timers = gcnew PriorityQueue<int, double>();
+        }
+
+        DormantEntity^ entity = Find(entityId);
+        if (entity == nullptr) {
+            entity = gcnew DormantEntity();
+            entity->EntityId = entityId;
+            entities->Add(entityId, entity);
+            PublishCount();
+        }
+
+        entity->WakeAt = wakeAfterSeconds > 0.0f ? Now() + wakeAfterSeconds : 0.0;
+        if (entity->WakeAt > 0.0) timers->Enqueue(entityId, entity->WakeAt);
+        return entity;
+    }
+
+    void Dormancy::Remove(int entityId)
+    {
+        if (entities != nullptr && entities->Remove(entityId)) PublishCount();
+    }
+
+    List<DormantEntity^>^ Dormancy::GetCompacted()
+    {
+        List<DormantEntity^>^ compacted = gcnew List<DormantEntity^>();
+        if (entities == nullptr) return compacted;
+        for each (DormantEntity^ entity in entities->Values) {
+            if (entity->TypeIds != nullptr) compacted->Add(entity);
+        }
+        return compacted;
+    }
+
+    void Dormancy::CollectDue(List<int>^ out)
+    {
+        if (entities == nullptr || entities->Count == 0) return;
+
+        // Timers: an entry is stale if the entity woke or was put back to sleep since
+        double now = Now();
+        int entityId;
+        double wakeAt;
+        while (timers->TryPeek(entityId, wakeAt) && wakeAt <= now) {
+            timers->Dequeue();
+            DormantEntity^ entity = Find(entityId);
+            if (entity != nullptr && entity->WakeAt == wakeAt) out->Add(entityId);
+        }
+
+        // Regions: one batch query; hits include awake entities, which are skipped
+        std::span<const Core::AabbQuery> regions = Core::ActivationRegions::instance().regions();
+        if (regions.empty()) return;
+        if (regionHits == nullptr) regionHits = gcnew array<int>(kInitialRegionHits);
+        if (regionRanges == nullptr) regionRanges = new std::vector<Core::QueryRange>();
+        std::vector<Core::QueryRange>& ranges = *regionRanges;
+        ranges.resize(regions.size());
+
+        int hits;
+        for (;;) {
+            pin_ptr<int> pinned = &regionHits[0];
+            hits = Core::SpatialIndex::instance().query_aabb(
+                regions, std::span<int>(static_cast<int*>(pinned), regionHits->Length), ranges);
+            if (hits < regionHits->Length) break;
+            regionHits = gcnew array<int>(regionHits->Length * 2); // May have dropped matches
+        }
+        for (int i = 0; i < hits; ++i) {
+            DormantEntity^ entity = Find(regionHits[i]);
+            if (entity != nullptr && entity->WakeAt >= 0.0) {
+                entity->WakeAt = -1.0; // Overlapping regions report it more than once
+                out->Add(regionHits[i]);
+            }
+        }
+    }
+
+    void Dormancy::Clear()
+    {
+        entities = nullptr;
+        timers = nullptr;
+        PublishCount();
+    }
+
+    void Dormancy::Restore(DormantEntity^ entity)
+    {
+        if (entities == nullptr) {
+            entities = gcnew Dictionary<int, DormantEntity^>();
+            timers = gcnew PriorityQueue<int, double>();
+        }
+        entity->Reloaded = true;
+        if (entity->WakeAt < 0.0) entity->WakeAt = 0.0; // Its region wake was dropped; the next query finds it again
+        if (entity->WakeAt > 0.0) timers->Enqueue(entity->EntityId, entity->WakeAt);
+        entities[entity->EntityId] = entity;
+        PublishCount();
+    }
+
+    void Dormancy::PublishCount()
+    {
+        if (dormantGauge == nullptr) {
+            dormantGauge = &Core::MetricsRegistry::instance().gauge("engine_dormant_entities", "Entities asleep, out of the script update lists");
+        }
+        dormantGauge->set(Count);
+    }
+
+} // namespace ScriptAPI
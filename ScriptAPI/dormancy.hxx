@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Core
+{
+    class Gauge;
+    struct QueryRange;
+}
+
+namespace ScriptAPI
+{
+    // A sleeping entity. Its scripts either stay in EngineInterface's entity list in the
+    // Dormant state, or, once compacted, exist only as ScriptSerializer blobs here.
+    ref class DormantEntity sealed
+    {
+    internal:
+        int EntityId;
+        double WakeAt; // Dormancy::Now() seconds; 0 if only Wake() or a region wakes it
+        // Compacted scripts, in the entity's order; nullptr if none
+        List<int>^ TypeIds;
+        List<array<Byte>^>^ Fields;
+        // Carried over a reload: a script the host adds again takes its type's blob
+        bool Reloaded;
+    };
+
+    // Entities that are asleep: their scripts are out of the per-type update lists, so a
+    // dormant entity costs nothing per frame. Entities are put to sleep and woken through
+    // Commands (scripts) or the SleepEntity/WakeEntity entry points (native code); they also
+    // wake when their timer runs out or when they are inside one of the
+    // Core::ActivationRegions, checked once per frame against the spatial index.
+    // EngineInterface moves the scripts; this class keeps the records and decides who is due.
+    public ref class Dormancy abstract sealed
+    {
+    public:
+        // As of the last command flush. Main thread only.
+        static bool IsDormant(int entityId);
+        static property int Count { int get() { return entities == nullptr ? 0 : entities->Count; } }
+
+    internal:
+        static DormantEntity^ Find(int entityId);
+        // Returns the entity's record, creating it if needed, with its timer set to
+        // 'wakeAfterSeconds' from now (0 clears it).
+        static DormantEntity^ Sleep(int entityId, float wakeAfterSeconds);
+        static void Remove(int entityId);
+        // Entities whose scripts were compacted
+        static List<DormantEntity^>^ GetCompacted();
+        // Appends entities whose timer ran out or that are inside an activation region.
+        static void CollectDue(List<int>^ out);
+        // Drops every record (the types of compacted scripts are being unloaded).
+        static void Clear();
+        // Puts back a compacted record after a reload, with TypeIds already remapped.
+        static void Restore(DormantEntity^ entity);
+
+        static double Now();
+
+    private:
+        static void PublishCount();
+
+        static Dictionary<int, DormantEntity^>^ entities = nullptr;
+        // Entity ids by wake time; stale entries are skipped when popped
+        static PriorityQueue<int, double>^ timers = nullptr;
+        static array<int>^ regionHits = nullptr;
+        static std::vector<Core::QueryRange>* regionRanges = nullptr; // One per region, reused
+        static Core::Gauge* dormantGauge = nullptr;
+    };
+} // namespace ScriptAPI
@@ -8,33 +8,149 @@
 #using <System.Collections.dll>
 
 #include "engine_interface.hxx"
+#include "commands.hxx"
+#include "script_metrics.hxx"
+#include "streaming.hxx"
+#include "navigation.hxx"
+#include "components.hxx"
+#include "jit_warmup.hxx"
+#include "replication.hxx"
+#include "allocation_tracker.hxx"
+#include "unload_tracker.hxx"
+#include "entity_scripts.hxx"
+#include "script_registry.hxx"
+#include "script_serializer.hxx"
+#include "prefabs.hxx"
+#include "dormancy.hxx"
+
+#using <System.Runtime.InteropServices.dll> // For Marshal
 
 // Additional using directives needed
 using namespace System::Linq; // For Enumerable class
 using namespace System::Threading; // For Thread::Sleep
+using namespace System::Diagnostics; // For Stopwatch
+using namespace System::Runtime::InteropServices; // For Marshal
 
 #include <iostream> // For std::cerr if needed
+#include <string>
+#include <vector>
+
+#include "entity_ids.h"          // Core
+#include "frame_watchdog.h"      // Core
+#include "spatial_index.h"       // Core
+#include "transform_hierarchy.h" // Core
 
 namespace ScriptAPI
 {
+    namespace
+    {
+        int ToInt(Core::ScriptStatus status) { return static_cast<int>(status); }
+
+        std::string ToUtf8(String^ text)
+        {
+            array<Byte>^ bytes = Text::Encoding::UTF8->GetBytes(text);
+            if (bytes->Length == 0) return std::string();
+            pin_ptr<Byte> pinned = &bytes[0];
+            return std::string(reinterpret_cast<const char*>(pinned), bytes->Length);
+        }
+
+        // Where hitch reports should say we are; null while the frame watchdog is off.
+        Core::ScriptActivity* WatchdogActivity()
+        {
+            Core::FrameWatchdog& watchdog = Core::FrameWatchdog::instance();
+            return watchdog.running() ? &watchdog.script_activity() : nullptr;
+        }
+    }
+
     // Static members initialized in header
 
+    // --- Error reporting ---
+    // Nothing may propagate out of an entry point: failures are written to the caller's
+    // ScriptErrorInfo and signalled through the returned status.
+
+    void EngineInterface::CopyUtf8(String^ text, char* buffer, int capacity)
+    {
+        if (buffer == nullptr || capacity <= 0) return;
+        array<Byte>^ bytes = Text::Encoding::UTF8->GetBytes(text != nullptr ? text : String::Empty);
+        int length = System::Math::Min(bytes->Length, capacity - 1);
+        while (length > 0 && length < bytes->Length && (bytes[length] & 0xC0) == 0x80) --length; // Don't split a code point
+        if (length > 0) Marshal::Copy(bytes, 0, IntPtr(buffer), length);
+        buffer[length] = '\0';
+    }
+
+    int EngineInterface::Fail(Core::ScriptErrorInfo* error, String^ message)
+    {
+        if (error != nullptr && error->message[0] == '\0') CopyUtf8(message, error->message, sizeof(error->message));
+        return ToInt(Core::ScriptStatus::Failed);
+    }
+
+    int EngineInterface::FailInternal(Core::ScriptErrorInfo* error, String^ call, Exception^ e)
+    {
+        if (error != nullptr) CopyUtf8(String::Format("{0}: {1}", call, e), error->message, sizeof(error->message));
+        return ToInt(Core::ScriptStatus::InternalError);
+    }
+
+    void EngineInterface::RecordScriptException(Core::ScriptErrorInfo* error, Script^ script, int entityId, Exception^ e)
+    {
+        ScriptMetrics::AddException(script->GetTypeId());
+        if (error == nullptr) return;
+        if (error->exceptionCount++ > 0) return; // Only the first exception is described
+
+        error->entityId = entityId;
+        CopyUtf8(script->GetType()->FullName, error->scriptType, sizeof(error->scriptType));
+        CopyUtf8(e->ToString(), error->message, sizeof(error->message));
+    }
+
+    void EngineInterface::RecordSystemException(Core::ScriptErrorInfo* error, ComponentSystemBase^ system, Exception^ e)
+    {
+        if (error == nullptr) return;
+        if (error->exceptionCount++ > 0) return; // Only the first exception is described
+
+        error->entityId = -1;
+        CopyUtf8(system->GetType()->FullName, error->scriptType, sizeof(error->scriptType));
+        CopyUtf8(e->ToString(), error->message, sizeof(error->message));
+    }
+
     // Helper function to clear script-related data structures
     void EngineInterface::ClearScriptData()
     {
         Console::WriteLine("[ScriptAPI] Clearing script data...");
         isInitialized = false; // Mark as uninitialized during cleanup/reload
 
-        if (activeScripts != nullptr) activeScripts->Clear();
-        if (availableScriptTypes != nullptr) availableScriptTypes->Clear();
+        if (activeScripts != nullptr) {
+            for each (KeyValuePair<int, List<Script^>^> pair in activeScripts) {
+                for each (Script^ script in pair.Value) Replication::Untrack(script);
+            }
+            activeScripts->Clear();
+        }
+        entityIndices = nullptr;
+        snapshotScripts = nullptr;
+        snapshotCompacted = nullptr;
+        Dormancy::Clear(); // Reload() carries compacted records over; see KeepCompacted()
+        typeListsToPrune = nullptr;
+        pruneNeeded = false;
+        Commands::Clear();
+        Streaming::CancelAll();
+        Navigation::CancelAll();
+        Components::Clear(); // Component types belong to the unloading assembly
+        componentSystems = nullptr;
+        startQueue = nullptr;
+        awaitingStarts = nullptr; // Unfinished StartAsync() tasks are abandoned
+        scriptsByType = nullptr;
+        executionPlan = nullptr;
+        ScriptMetrics::OnScriptTypesUnloaded();
+        Replication::OnScriptTypesUnloaded();
+        AllocationTracker::OnScriptTypesUnloaded();
+        Prefabs::OnScriptTypesUnloaded();
+        ScriptTypes::Clear();
+        ScriptSerializer::ClearCache();
         activeScripts = nullptr;
-        availableScriptTypes = nullptr;
         scriptAssembly = nullptr; // Release reference to the assembly
     }
 
     // Helper function to load assembly and discover scripts
     // Used by Init and Reload
-    bool EngineInterface::LoadAndDiscoverScripts()
+    bool EngineInterface::LoadAndDiscoverScripts(Core::ScriptErrorInfo* error)
     {
         try
         {
@@ -48,7 +164,7 @@ namespace ScriptAPI
 
             if (!File::Exists(assemblyPath))
             {
-                Console::Error->WriteLine(String::Format("[ScriptAPI] Error: ManagedScripts.dll not found: {0}", assemblyPath));
+                Fail(error, String::Format("ManagedScripts.dll not found: {0}", assemblyPath));
                 // Don't nullify scriptLoadContext here, it might be needed for unload later
                 return false;
             }
@@ -60,21 +176,39 @@ namespace ScriptAPI
 
             if (scriptAssembly == nullptr)
             {
-                Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Failed to load assembly: {0}", assemblyPath));
+                Fail(error, String::Format("Failed to load assembly: {0}", assemblyPath));
                 return false; // Context remains for potential unload
             }
 
             Console::WriteLine(String::Format("[ScriptAPI] Successfully loaded assembly: {0}", scriptAssembly->FullName));
 
-            DiscoverScriptTypes(); // Discover types from the newly loaded assembly
+            if (!ScriptTypes::Load(scriptAssembly)) // Script type ids for the newly loaded assembly
+            {
+                Fail(error, "Failed to build the script type table.");
+                return false;
+            }
+            scriptsByType = gcnew array<List<Script^>^>(ScriptTypes::Count);
+            std::vector<std::string> typeNames;
+            for (int id = 0; id < ScriptTypes::Count; ++id) typeNames.push_back(ToUtf8(ScriptTypes::GetTypeName(id)));
+            Core::FrameWatchdog::instance().set_script_type_names(std::move(typeNames));
+            ScriptMetrics::OnScriptTypesLoaded();
+            Replication::OnScriptTypesLoaded();
+            AllocationTracker::OnScriptTypesLoaded();
+            Prefabs::OnScriptTypesLoaded();
+            executionPlan = ExecutionPlan::Build();
+            componentSystems = Components::CreateSystems(scriptAssembly, ExecutionPlan::PhaseCount);
+            Console::WriteLine("[ScriptAPI] Execution plan:");
+            executionPlan->Log();
             activeScripts = gcnew Dictionary<int, List<Script^>^>(); // Reset active scripts
 
+            // Compile script code now rather than inside the first frames
+            JitWarmup::Run(componentSystems);
+
             return true;
         }
         catch (Exception^ e)
         {
-            Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during LoadAndDiscoverScripts: {0}", e->Message));
-            Console::Error->WriteLine(e->StackTrace);
+            Fail(error, String::Format("Exception during LoadAndDiscoverScripts: {0}", e));
             scriptAssembly = nullptr; // Ensure assembly ref is null on error
             // Don't nullify context, allow unload attempt
             return false;
@@ -82,221 +216,1036 @@ namespace ScriptAPI
     }
 
 
-    bool EngineInterface::Init()
+    int EngineInterface::Init(Core::ScriptErrorInfo* error)
     {
-        if (isInitialized)
+        try
         {
-            Console::WriteLine("[ScriptAPI] Already initialized.");
-            return true;
+            if (isInitialized)
+            {
+                Console::WriteLine("[ScriptAPI] Already initialized.");
+                return ToInt(Core::ScriptStatus::Ok);
+            }
+            Console::WriteLine("[ScriptAPI] Initializing...");
+
+            // Perform initial load and discovery
+            if (LoadAndDiscoverScripts(error)) {
+                isInitialized = true; // Mark as initialized only on success
+                return ToInt(Core::ScriptStatus::Ok);
+            }
+            else {
+                // Cleanup potentially partially created context if loading failed
+                UnloadScripts();
+                return ToInt(Core::ScriptStatus::Failed);
+            }
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "Init", e);
         }
-        Console::WriteLine("[ScriptAPI] Initializing...");
+    }
 
-        // Perform initial load and discovery
-        if (LoadAndDiscoverScripts()) {
-            isInitialized = true; // Mark as initialized only on success
-            return true;
+    void EngineInterface::SetJitWarmup(int enabled)
+    {
+        JitWarmup::Enabled = enabled != 0;
+    }
+
+    void EngineInterface::SetReplication(int enabled)
+    {
+        Replication::Enabled = enabled != 0;
+    }
+
+    void EngineInterface::SetAllocationTracking(int enabled)
+    {
+        AllocationTracker::Enabled = enabled != 0;
+    }
+
+    int EngineInterface::GatherReplicated(Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            if (isInitialized) Replication::Gather(scriptsByType);
+            return ToInt(Core::ScriptStatus::Ok);
         }
-        else {
-            // Cleanup potentially partially created context if loading failed
-            Shutdown(); // Call full shutdown to ensure cleanup
-            return false;
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "GatherReplicated", e);
         }
     }
 
     // --- Implementation of Reload ---
-    bool EngineInterface::Reload()
+    int EngineInterface::Reload(Core::ScriptErrorInfo* error)
     {
-        Console::WriteLine("[ScriptAPI] Reload requested...");
+        try
+        {
+            Console::WriteLine("[ScriptAPI] Reload requested...");
+            long long reloadStart = Stopwatch::GetTimestamp();
 
-        // 1. Clear existing script instances and type lookups
-        ClearScriptData();
+            // 1. Clear existing script instances and type lookups
+            List<KeyValuePair<DormantEntity^, array<String^>^>>^ compacted = KeepCompacted();
+            ClearScriptData();
 
-        // 2. Unload the existing AssemblyLoadContext
-        if (scriptLoadContext != nullptr)
-        {
-            try
+            // 2. Unload the existing AssemblyLoadContext
+            if (scriptLoadContext != nullptr)
             {
-                Console::WriteLine("[ScriptAPI] Unloading previous AssemblyLoadContext...");
-                scriptLoadContext->Unload();
-                Console::WriteLine("[ScriptAPI] Unload initiated.");
+                try
+                {
+                    Console::WriteLine("[ScriptAPI] Unloading previous AssemblyLoadContext...");
+                    scriptLoadContext->Unload();
+                    Console::WriteLine("[ScriptAPI] Unload initiated.");
+
+                    // The context is collected over the next frames; UnloadTracker checks
+                    // that it actually goes away instead of blocking here on GCs and finalizers.
+                    UnloadTracker::Track(scriptLoadContext);
+                    scriptLoadContext = nullptr; // Release our reference
+                }
+                catch (Exception^ e)
+                {
+                    // Log error but continue - context might be partially unloaded or stuck
+                    Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during AssemblyLoadContext.Unload() or GC: {0}", e->Message));
+                    scriptLoadContext = nullptr; // Ensure reference is cleared anyway
+                }
+            }
+            else {
+                Console::WriteLine("[ScriptAPI] No previous AssemblyLoadContext to unload.");
+            }
 
-                // Give the unload and GC some time. This is not foolproof but helps.
-                // WaitForPendingFinalizers can block indefinitely if something holds on.
-                // A loop with GC.Collect() and Sleep might be safer in complex scenarios.
-                scriptLoadContext = nullptr; // Release our reference
-                GC::Collect();
-                GC::WaitForPendingFinalizers(); // Wait for finalizers to run
-                GC::Collect(); // Collect again after finalizers
-                Console::WriteLine("[ScriptAPI] GC finalized after unload attempt.");
 
+            // 3. Re-load the assembly and re-discover scripts
+            Console::WriteLine("[ScriptAPI] Reloading scripts...");
+            bool loaded = LoadAndDiscoverScripts(error);
+            ScriptMetrics::RecordReload(static_cast<double>(Stopwatch::GetTimestamp() - reloadStart) / Stopwatch::Frequency, loaded);
+            if (loaded) {
+                isInitialized = true; // Mark as initialized again
+                RestoreCompacted(compacted);
+                Console::WriteLine("[ScriptAPI] Reload complete.");
+                return ToInt(Core::ScriptStatus::Ok);
             }
-            catch (Exception^ e)
-            {
-                // Log error but continue - context might be partially unloaded or stuck
-                Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during AssemblyLoadContext.Unload() or GC: {0}", e->Message));
-                scriptLoadContext = nullptr; // Ensure reference is cleared anyway
+            else {
+                // Cleanup after failed reload attempt
+                UnloadScripts();
+                return ToInt(Core::ScriptStatus::Failed);
             }
         }
-        else {
-            Console::WriteLine("[ScriptAPI] No previous AssemblyLoadContext to unload.");
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "Reload", e);
         }
+    }
 
 
-        // 3. Re-load the assembly and re-discover scripts
-        Console::WriteLine("[ScriptAPI] Reloading scripts...");
-        if (LoadAndDiscoverScripts()) {
-            isInitialized = true; // Mark as initialized again
-            Console::WriteLine("[ScriptAPI] Reload complete.");
-            return true;
+    List<Script^>^ EngineInterface::GetOrCreateEntityScriptList(int entityId)
+    {
+        List<Script^>^ entityScripts;
+        if (activeScripts == nullptr) {
+            activeScripts = gcnew Dictionary<int, List<Script^>^>();
         }
-        else {
-            Console::Error->WriteLine("[ScriptAPI] Failed to reload scripts.");
-            // Cleanup after failed reload attempt
-            Shutdown(); // Call full shutdown
-            return false;
+        if (!activeScripts->TryGetValue(entityId, entityScripts))
+        {
+            entityScripts = gcnew List<Script^>();
+            activeScripts->Add(entityId, entityScripts);
         }
+        return entityScripts;
     }
 
+    int EngineInterface::GetScriptTypeId(String^ scriptName)
+    {
+        try { return ScriptTypes::GetTypeId(scriptName); }
+        catch (Exception^) { return -1; }
+    }
 
-    // --- Implementation of the static predicate ---
-    bool EngineInterface::IsConcreteScript(Type^ type)
+    int EngineInterface::AddScript(int entityId, String^ scriptName, Core::ScriptErrorInfo* error)
     {
-        return type != nullptr && type->IsSubclassOf(Script::typeid) && !type->IsAbstract;
+        try
+        {
+            return CreateScript(entityId, scriptName, error) != nullptr
+                ? ToInt(Core::ScriptStatus::Ok)
+                : ToInt(Core::ScriptStatus::Failed);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "AddScript", e);
+        }
     }
 
-    void EngineInterface::DiscoverScriptTypes()
+    int EngineInterface::AddScriptById(int entityId, int typeId, Core::ScriptErrorInfo* error)
     {
-        availableScriptTypes = gcnew Dictionary<String^, Type^>();
-        if (scriptAssembly == nullptr) return;
+        try
+        {
+            return CreateScript(entityId, typeId, error) != nullptr
+                ? ToInt(Core::ScriptStatus::Ok)
+                : ToInt(Core::ScriptStatus::Failed);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "AddScriptById", e);
+        }
+    }
 
-        Console::WriteLine("[ScriptAPI] Discovering script types...");
+    Script^ EngineInterface::CreateScript(int entityId, String^ scriptName, Core::ScriptErrorInfo* error)
+    {
+        int typeId = ScriptTypes::GetTypeId(scriptName);
+        if (typeId < 0 && isInitialized) {
+            Fail(error, String::Format("Script type '{0}' not found or not discovered.", scriptName));
+            return nullptr;
+        }
+        return CreateScript(entityId, typeId, error);
+    }
+
+    Script^ EngineInterface::CreateScript(int entityId, int typeId, Core::ScriptErrorInfo* error)
+    {
+        if (!isInitialized || scriptAssembly == nullptr) {
+            Fail(error, "AddScript called before successful initialization/reload.");
+            return nullptr;
+        }
+        if (!ScriptTypes::IsValid(typeId)) {
+            Fail(error, String::Format("Script type id {0} is out of range.", typeId));
+            return nullptr;
+        }
+
+        String^ typeName = ScriptTypes::GetTypeName(typeId);
+        try {
+            Script^ newScript = ScriptTypes::Create(typeId);
+            newScript->SetEntityId(entityId);
+            ClaimCompacted(newScript);
+            RegisterScript(newScript);
+            Console::WriteLine(String::Format("[ScriptAPI] Script '{0}' added successfully to Entity {1}.", typeName, entityId));
+            return newScript;
+        }
+        catch (Exception^ e) {
+            // The script's constructor threw
+            ScriptMetrics::AddException(typeId);
+            if (error != nullptr) {
+                error->entityId = entityId;
+                CopyUtf8(typeName, error->scriptType, sizeof(error->scriptType));
+            }
+            Fail(error, e->ToString());
+            return nullptr;
+        }
+    }
+
+    void EngineInterface::RegisterScript(Script^ script)
+    {
+        int entityId = script->GetEntityId();
+        List<Script^>^ entityScripts = GetOrCreateEntityScriptList(entityId);
+        entityScripts->Add(script);
+
+        EntityScriptIndex^ index;
+        if (entityIndices == nullptr) entityIndices = gcnew Dictionary<int, EntityScriptIndex^>();
+        if (!entityIndices->TryGetValue(entityId, index)) {
+            index = gcnew EntityScriptIndex(entityScripts, ScriptTypes::Count);
+            entityIndices->Add(entityId, index);
+        }
+        index->Add(script);
+        script->SetEntityIndex(index);
+        // Joins scriptsByType once started; see CompleteStart()
+        if (startQueue == nullptr) startQueue = gcnew Queue<Script^>();
+        startQueue->Enqueue(script);
+    }
+
+    int EngineInterface::ExecuteStartForEntity(int entityId, Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            if (!isInitialized || activeScripts == nullptr) return ToInt(Core::ScriptStatus::Ok);
+            int exceptions = 0;
+            List<Script^>^ entityScripts;
+            if (activeScripts->TryGetValue(entityId, entityScripts)) {
+                // Structural changes made by Start() are deferred to the flush below.
+                // The scripts stay in startQueue; RunPendingStarts() skips them once started.
+                for (int i = 0; i < entityScripts->Count; ++i) {
+                    exceptions += BeginStart(entityScripts[i], error);
+                }
+            }
+            exceptions += FlushCommands(error);
+            return ToInt(exceptions > 0 ? Core::ScriptStatus::ScriptException : Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "ExecuteStartForEntity", e);
+        }
+    }
+
+    int EngineInterface::RunPendingStarts(int budgetMicroseconds, Core::ScriptErrorInfo* error)
+    {
         try
         {
-            IEnumerable<Type^>^ typesInAssembly = safe_cast<IEnumerable<Type^>^>(scriptAssembly->GetExportedTypes());
-            IEnumerable<Type^>^ discoveredTypes = Enumerable::Where(
-                typesInAssembly,
-                gcnew Func<Type^, bool>(&EngineInterface::IsConcreteScript)
-            );
+            if (!isInitialized) return ToInt(Core::ScriptStatus::Ok);
+            int exceptions = 0;
+
+            // First in the frame, so StartAsync() tasks waiting on a read or a path can finish below
+            Streaming::DeliverCompletions();
+            Navigation::DeliverCompletions();
 
-            if (discoveredTypes == nullptr) {
-                Console::Error->WriteLine("[ScriptAPI] Error: Enumerable::Where returned null during script discovery.");
-                return;
+            if (awaitingStarts != nullptr) {
+                for (int i = awaitingStarts->Count - 1; i >= 0; --i) {
+                    Script^ script = awaitingStarts[i];
+                    Task^ task = script->GetStartTask();
+                    if (!task->IsCompleted) continue;
+
+                    awaitingStarts->RemoveAt(i);
+                    script->SetStartTask(nullptr);
+                    if (script->GetStartState() != ScriptStartState::Awaiting) continue; // Removed meanwhile
+                    if (task->IsFaulted) {
+                        RecordScriptException(error, script, script->GetEntityId(), task->Exception->GetBaseException());
+                        ++exceptions;
+                    }
+                    CompleteStart(script);
+                }
             }
 
-            for each (Type ^ type in discoveredTypes)
-            {
-                Console::WriteLine(String::Format("[ScriptAPI]   Found script: {0}", type->FullName));
-                if (!availableScriptTypes->ContainsKey(type->FullName))
-                {
-                    availableScriptTypes->Add(type->FullName, type);
+            if (startQueue != nullptr && startQueue->Count > 0) {
+                long long deadline = Stopwatch::GetTimestamp() + budgetMicroseconds * Stopwatch::Frequency / 1000000;
+                Core::ScriptActivity* activity = WatchdogActivity();
+                if (activity) activity->phase = Core::ScriptActivity::kStart;
+                int activityType = -1; // Queued scripts of a type tend to be adjacent
+                while (startQueue->Count > 0) {
+                    Script^ script = startQueue->Dequeue();
+                    if (script->GetStartState() != ScriptStartState::Queued) continue; // Started early or removed
+                    if (activity) {
+                        if (script->GetTypeId() != activityType) {
+                            activityType = script->GetTypeId();
+                            activity->typeId = activityType;
+                        }
+                        activity->entityId = script->GetEntityId();
+                    }
+                    exceptions += BeginStart(script, error);
+                    if (Stopwatch::GetTimestamp() >= deadline) break;
                 }
-                if (!availableScriptTypes->ContainsKey(type->Name) && type->Name != type->FullName)
-                {
-                    availableScriptTypes->Add(type->Name, type);
-                    Console::WriteLine(String::Format("[ScriptAPI]     (Also mapped by name: {0})", type->Name));
+                if (activity) {
+                    activity->phase = Core::ScriptActivity::kNone;
+                    activity->entityId = -1;
                 }
             }
-            Console::WriteLine(String::Format("[ScriptAPI] Discovered {0} unique script type mappings.", availableScriptTypes->Count));
+
+            exceptions += FlushCommands(error);
+            return ToInt(exceptions > 0 ? Core::ScriptStatus::ScriptException : Core::ScriptStatus::Ok);
         }
         catch (Exception^ e)
         {
-            Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during script discovery: {0}", e->Message));
-            availableScriptTypes->Clear();
+            return FailInternal(error, "RunPendingStarts", e);
         }
     }
 
-    List<Script^>^ EngineInterface::GetOrCreateEntityScriptList(int entityId)
+    int EngineInterface::BeginStart(Script^ script, Core::ScriptErrorInfo* error)
     {
-        List<Script^>^ entityScripts;
-        if (activeScripts == nullptr) {
-            activeScripts = gcnew Dictionary<int, List<Script^>^>();
+        if (script->GetStartState() != ScriptStartState::Queued) return 0;
+
+        // A throwing Start() still lets the script update, as before start was staged
+        Task^ task = nullptr;
+        try {
+            script->Start();
+            task = script->StartAsync();
         }
-        if (!activeScripts->TryGetValue(entityId, entityScripts))
+        catch (Exception^ e) {
+            RecordScriptException(error, script, script->GetEntityId(), e);
+            CompleteStart(script);
+            return 1;
+        }
+
+        if (task != nullptr && !task->IsCompleted) {
+            script->SetStartState(ScriptStartState::Awaiting);
+            script->SetStartTask(task);
+            if (awaitingStarts == nullptr) awaitingStarts = gcnew List<Script^>();
+            awaitingStarts->Add(script);
+            return 0;
+        }
+
+        CompleteStart(script);
+        if (task != nullptr && task->IsFaulted) {
+            RecordScriptException(error, script, script->GetEntityId(), task->Exception->GetBaseException());
+            return 1;
+        }
+        return 0;
+    }
+
+    void EngineInterface::CompleteStart(Script^ script)
+    {
+        Replication::Track(script);
+        if (Dormancy::IsDormant(script->GetEntityId())) {
+            script->SetStartState(ScriptStartState::Dormant); // Joins scriptsByType when the entity wakes
+            return;
+        }
+        script->SetStartState(ScriptStartState::Started);
+        int typeId = script->GetTypeId();
+        if (scriptsByType[typeId] == nullptr) scriptsByType[typeId] = gcnew List<Script^>();
+        scriptsByType[typeId]->Add(script);
+    }
+
+    void EngineInterface::MarkRemoved(Script^ script)
+    {
+        // Started scripts are also in their type's update list; like sleeping ones, they
+        // leave it in one PruneTypeLists() pass per list at the end of the flush
+        if (script->GetStartState() == ScriptStartState::Started) MarkTypeListForPrune(script->GetTypeId());
+        script->SetStartState(ScriptStartState::Removed);
+        script->SetEntityIndex(nullptr);
+        Replication::Untrack(script);
+    }
+
+    int EngineInterface::ExecutePhase(int phase, Core::ScriptErrorInfo* error)
+    {
+        try
         {
-            entityScripts = gcnew List<Script^>();
-            activeScripts->Add(entityId, entityScripts);
+            if (!isInitialized || executionPlan == nullptr) return ToInt(Core::ScriptStatus::Ok);
+            if (phase < 0 || phase >= ExecutionPlan::PhaseCount) {
+                return Fail(error, String::Format("Unknown script phase {0}.", phase));
+            }
+
+            bool trackAllocations = AllocationTracker::Enabled;
+            Core::ScriptActivity* activity = WatchdogActivity();
+            if (activity) activity->phase = phase;
+            if (phase == static_cast<int>(ScriptPhase::PreUpdate)) { // Once per frame
+                ScriptMetrics::SampleRuntime();
+                if (trackAllocations) AllocationTracker::EndFrame();
+                UnloadTracker::Poll(scriptLoadContext);
+            }
+
+            int exceptions = 0;
+            if (phase == static_cast<int>(ScriptPhase::PreUpdate) && Dormancy::Count > 0) {
+                exceptions += WakeDueEntities(error);
+            }
+
+            // Groups marked concurrent by the plan still run in order here; scripts are not
+            // yet required to be thread-safe.
+            for each (int typeId in executionPlan->GetOrder(static_cast<ScriptPhase>(phase))) {
+                List<Script^>^ scripts = scriptsByType[typeId];
+                if (scripts == nullptr) continue;
+                ScriptMetrics::SetScriptCount(typeId, scripts->Count);
+                long long typeStart = Stopwatch::GetTimestamp();
+                long long allocStart = trackAllocations ? AllocationTracker::BeginBatch(typeId) : 0;
+                if (activity) activity->typeId = typeId;
+
+                // Scripts can't change these lists mid-phase; see FlushCommands()
+                for (int i = 0; i < scripts->Count; ++i) {
+                    Script^ script = scripts[i];
+                    if (activity) activity->entityId = script->GetEntityId();
+                    try { script->Update(); }
+                    catch (Exception^ e) {
+                        RecordScriptException(error, script, script->GetEntityId(), e);
+                        ++exceptions;
+                    }
+                }
+                if (trackAllocations) AllocationTracker::EndBatch(typeId, allocStart);
+                ScriptMetrics::AddUpdateTime(typeId, Stopwatch::GetTimestamp() - typeStart);
+            }
+
+            if (activity) activity->entityId = -1;
+
+            // Struct component systems run after the phase's scripts
+            for each (ComponentSystemBase^ system in componentSystems[phase]) {
+                try { system->Run(); }
+                catch (Exception^ e) {
+                    RecordSystemException(error, system, e);
+                    ++exceptions;
+                }
+            }
+            if (activity) activity->phase = Core::ScriptActivity::kNone;
+            exceptions += FlushCommands(error);
+            return ToInt(exceptions > 0 ? Core::ScriptStatus::ScriptException : Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "ExecutePhase", e);
         }
-        return entityScripts;
     }
 
-    bool EngineInterface::AddScript(int entityId, String^ scriptName)
+    int EngineInterface::FlushCommands(Core::ScriptErrorInfo* error)
     {
-        if (!isInitialized || availableScriptTypes == nullptr || scriptAssembly == nullptr) {
-            Console::Error->WriteLine("[ScriptAPI] Error: AddScript called before successful initialization/reload.");
-            return false;
+        if (pendingCommands == nullptr) pendingCommands = gcnew List<Command>();
+
+        // Commands recorded while applying are applied in the next pass; anything left after
+        // the last pass waits for the next flush. Added scripts are only queued here; their
+        // Start() runs from RunPendingStarts().
+        int exceptions = 0;
+        for (int pass = 0; pass < MaxFlushPasses; ++pass) {
+            pendingCommands->Clear();
+            Commands::Drain(pendingCommands);
+            if (pendingCommands->Count == 0) break;
+
+            for (int i = 0; i < pendingCommands->Count; ++i) {
+                Command command = pendingCommands[i];
+                switch (command.Type) {
+                case CommandType::Spawn:
+                {
+                    Core::TransformHierarchy& transforms = Core::TransformHierarchy::instance();
+                    transforms.add(command.EntityId);
+                    if (command.HasPosition) {
+                        Core::Math::float3 position{ command.Position.X, command.Position.Y, command.Position.Z };
+                        transforms.set_local(command.EntityId, position, Core::Math::quat_identity(), Core::Math::float3{ 1.0f, 1.0f, 1.0f });
+                        Core::SpatialIndex::instance().update(command.EntityId, position.x, position.y, position.z);
+                    }
+                    break;
+                }
+                case CommandType::AddScript:
+                {
+                    Script^ script = CreateScript(command.EntityId, command.TypeId, error);
+                    if (script == nullptr) {
+                        if (error != nullptr) ++error->exceptionCount;
+                        ++exceptions;
+                    }
+                    break;
+                }
+                case CommandType::RemoveScript:
+                    RemoveScriptInstance(command.Target);
+                    break;
+                case CommandType::AddComponent:
+                    command.Store->AddFrom(command.EntityId, command.Payload, command.PayloadOffset);
+                    break;
+                case CommandType::RemoveComponent:
+                    command.Store->Remove(command.EntityId);
+                    break;
+                case CommandType::Instantiate:
+                {
+                    PrefabPlan^ plan = Prefabs::GetPlan(command.TypeId);
+                    if (plan == nullptr) {
+                        Fail(error, String::Format("Prefab {0} is unknown or failed to compile.", command.TypeId));
+                        if (error != nullptr) ++error->exceptionCount;
+                        ++exceptions;
+                        break;
+                    }
+                    exceptions += CreatePrefabInstances(plan, command.EntityIds, error);
+                    break;
+                }
+                case CommandType::Sleep:
+                    ApplySleep(command.EntityId, command.Seconds, command.Compact);
+                    break;
+                case CommandType::Wake:
+                    exceptions += ApplyWake(command.EntityId, error);
+                    break;
+                case CommandType::Destroy:
+                {
+                    Dormancy::Remove(command.EntityId); // Compacted scripts are dropped with it
+                    List<Script^>^ entityScripts;
+                    if (activeScripts != nullptr && activeScripts->TryGetValue(command.EntityId, entityScripts)) {
+                        for each (Script^ script in entityScripts) MarkRemoved(script);
+                        activeScripts->Remove(command.EntityId);
+                        entityIndices->Remove(command.EntityId);
+                    }
+                    Components::RemoveEntity(command.EntityId);
+                    Core::TransformHierarchy::instance().remove(command.EntityId);
+                    Core::SpatialIndex::instance().remove(command.EntityId);
+                    break;
+                }
+                }
+            }
         }
+        pendingCommands->Clear(); // Don't keep removed scripts alive
+        PruneTypeLists();
+        return exceptions;
+    }
 
-        scriptName = scriptName->Trim();
-        Type^ scriptTypeToCreate = nullptr;
-        if (!availableScriptTypes->TryGetValue(scriptName, scriptTypeToCreate)) {
-            Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Script type '{0}' not found or not discovered.", scriptName));
-            return false;
+    int EngineInterface::CreatePrefabInstances(PrefabPlan^ plan, array<int>^ entityIds, Core::ScriptErrorInfo* error)
+    {
+        int count = entityIds->Length;
+        int scriptCount = plan->TypeIds->Length;
+        Core::TransformHierarchy& transforms = Core::TransformHierarchy::instance();
+        if (activeScripts == nullptr) activeScripts = gcnew Dictionary<int, List<Script^>^>();
+        if (entityIndices == nullptr) entityIndices = gcnew Dictionary<int, EntityScriptIndex^>();
+        if (startQueue == nullptr) startQueue = gcnew Queue<Script^>();
+        activeScripts->EnsureCapacity(activeScripts->Count + count);
+        entityIndices->EnsureCapacity(entityIndices->Count + count);
+        startQueue->EnsureCapacity(startQueue->Count + count * scriptCount);
+
+        // Everything was resolved when the plan was compiled: per entity this is the script
+        // constructors, the generated field setters and a copy of the index bitmask.
+        int failures = 0;
+        for (int e = 0; e < count; ++e) {
+            int entityId = entityIds[e];
+            transforms.add(entityId);
+            if (scriptCount == 0) continue;
+
+            List<Script^>^ entityScripts = gcnew List<Script^>(scriptCount);
+            for (int i = 0; i < scriptCount; ++i) {
+                int typeId = plan->TypeIds[i];
+                try {
+                    Script^ script = ScriptTypes::Create(typeId);
+                    if (plan->Setters[i] != nullptr) plan->Setters[i](script);
+                    script->SetEntityId(entityId);
+                    entityScripts->Add(script);
+                }
+                catch (Exception^ ex) {
+                    // A constructor threw; the entity gets the rest of its scripts
+                    ScriptMetrics::AddException(typeId);
+                    if (error != nullptr && error->exceptionCount == 0) {
+                        error->entityId = entityId;
+                        CopyUtf8(ScriptTypes::GetTypeName(typeId), error->scriptType, sizeof(error->scriptType));
+                        CopyUtf8(ex->ToString(), error->message, sizeof(error->message));
+                    }
+                    if (error != nullptr) ++error->exceptionCount;
+                    ++failures;
+                }
+            }
+            if (entityScripts->Count == 0) continue;
+
+            EntityScriptIndex^ index = entityScripts->Count == scriptCount
+                ? gcnew EntityScriptIndex(entityScripts, plan->IndexLayout)
+                : gcnew EntityScriptIndex(entityScripts, ScriptTypes::Count);
+            if (entityScripts->Count != scriptCount) {
+                for each (Script^ script in entityScripts) index->Add(script);
+            }
+            activeScripts->Add(entityId, entityScripts);
+            entityIndices->Add(entityId, index);
+            for each (Script^ script in entityScripts) {
+                script->SetEntityIndex(index);
+                startQueue->Enqueue(script); // Joins scriptsByType once started; see CompleteStart()
+            }
+        }
+        return failures;
+    }
+
+    void EngineInterface::RemoveScriptInstance(Script^ script)
+    {
+        List<Script^>^ entityScripts;
+        if (activeScripts == nullptr || !activeScripts->TryGetValue(script->GetEntityId(), entityScripts)) return;
+        if (!entityScripts->Remove(script)) return; // Already removed
+
+        if (entityScripts->Count == 0) {
+            activeScripts->Remove(script->GetEntityId());
+            entityIndices->Remove(script->GetEntityId());
         }
+        else {
+            script->GetEntityIndex()->Remove(script);
+        }
+        MarkRemoved(script);
+    }
 
-        Console::WriteLine(String::Format("[ScriptAPI] Adding script '{0}' to Entity {1}", scriptTypeToCreate->FullName, entityId));
+    // --- Dormancy ---
 
-        try {
-            Object^ instance = Activator::CreateInstance(scriptTypeToCreate);
-            Script^ newScript = safe_cast<Script^>(instance);
+    bool EngineInterface::ApplySleep(int entityId, float wakeAfterSeconds, bool compact)
+    {
+        // Only entities with scripts are visited per frame
+        List<Script^>^ entityScripts;
+        if (activeScripts == nullptr || !activeScripts->TryGetValue(entityId, entityScripts)) {
+            if (!Dormancy::IsDormant(entityId)) return false;
+            Dormancy::Sleep(entityId, wakeAfterSeconds); // Compacted already; new timer
+            return true;
+        }
 
-            if (newScript != nullptr) {
-                newScript->SetEntityId(entityId);
-                List<Script^>^ entityScripts = GetOrCreateEntityScriptList(entityId);
-                entityScripts->Add(newScript);
-                Console::WriteLine(String::Format("[ScriptAPI] Script '{0}' added successfully to Entity {1}.", scriptTypeToCreate->FullName, entityId));
-                return true;
+        DormantEntity^ dormant = Dormancy::Sleep(entityId, wakeAfterSeconds);
+        bool canCompact = compact;
+        for each (Script^ script in entityScripts) {
+            if (script->GetStartState() == ScriptStartState::Started) {
+                script->SetStartState(ScriptStartState::Dormant);
+                MarkTypeListForPrune(script->GetTypeId());
             }
-            else {
-                Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Failed to cast created instance to Script^ for type '{0}'.", scriptTypeToCreate->FullName));
-                return false;
+            // Queued or Awaiting scripts turn Dormant in CompleteStart(). Compacting them
+            // would skip the rest of their start, so the entity stays uncompacted for now.
+            else if (script->GetStartState() != ScriptStartState::Dormant) {
+                canCompact = false;
             }
         }
-        catch (Exception^ e) {
-            Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during AddScript ('{0}'): {1}", scriptName, e->Message));
-            Console::Error->WriteLine(e->StackTrace);
-            return false;
+        if (!canCompact) return true;
+
+        // The blobs are world snapshot records; the Script objects are released
+        if (dormant->TypeIds == nullptr) {
+            dormant->TypeIds = gcnew List<int>(entityScripts->Count);
+            dormant->Fields = gcnew List<array<Byte>^>(entityScripts->Count);
+        }
+        for each (Script^ script in entityScripts) {
+            int length = 0;
+            array<Byte>^ blob = ScriptSerializer::Serialize(script, length);
+            array<Byte>^ fields = gcnew array<Byte>(length);
+            if (length > 0) System::Buffer::BlockCopy(blob, 0, fields, 0, length);
+            dormant->TypeIds->Add(script->GetTypeId());
+            dormant->Fields->Add(fields);
+
+            script->SetStartState(ScriptStartState::Removed); // Dropped from its type list by the prune
+            script->SetEntityIndex(nullptr);
+            Replication::Untrack(script);
         }
+        activeScripts->Remove(entityId);
+        entityIndices->Remove(entityId);
+        return true;
     }
 
-    void EngineInterface::ExecuteStartForEntity(int entityId)
+    int EngineInterface::ApplyWake(int entityId, Core::ScriptErrorInfo* error)
     {
-        if (!isInitialized || activeScripts == nullptr) return;
+        DormantEntity^ dormant = Dormancy::Find(entityId);
+        if (dormant == nullptr) return 0;
+        Dormancy::Remove(entityId);
+        PruneTypeLists(); // A script put to sleep in this flush may still be in its list
+
         List<Script^>^ entityScripts;
-        if (activeScripts->TryGetValue(entityId, entityScripts)) {
-            auto scriptsToStart = gcnew List<Script^>(entityScripts);
-            for each (Script ^ script in scriptsToStart) {
-                if (script == nullptr) continue;
-                try { script->Start(); }
+        if (activeScripts != nullptr && activeScripts->TryGetValue(entityId, entityScripts)) {
+            for each (Script^ script in entityScripts) {
+                if (script->GetStartState() != ScriptStartState::Dormant) continue; // Still starting
+                script->SetStartState(ScriptStartState::Started);
+                int typeId = script->GetTypeId();
+                if (scriptsByType[typeId] == nullptr) scriptsByType[typeId] = gcnew List<Script^>();
+                scriptsByType[typeId]->Add(script);
+            }
+        }
+        if (dormant->TypeIds == nullptr) return 0;
+
+        // Compacted scripts come back like restored ones: saved fields, then Start() again
+        int failures = 0;
+        for (int i = 0; i < dormant->TypeIds->Count; ++i) {
+            int typeId = dormant->TypeIds[i];
+            Script^ script;
+            try {
+                script = ScriptTypes::Create(typeId);
+            }
+            catch (Exception^ e) {
+                ScriptMetrics::AddException(typeId);
+                if (error != nullptr && error->exceptionCount == 0) {
+                    error->entityId = entityId;
+                    CopyUtf8(ScriptTypes::GetTypeName(typeId), error->scriptType, sizeof(error->scriptType));
+                    CopyUtf8(e->ToString(), error->message, sizeof(error->message));
+                }
+                if (error != nullptr) ++error->exceptionCount;
+                ++failures;
+                continue;
+            }
+
+            script->SetEntityId(entityId);
+            array<Byte>^ fields = dormant->Fields[i];
+            if (fields->Length > 0) {
+                pin_ptr<Byte> pinned = &fields[0];
+                try { ScriptSerializer::Deserialize(script, pinned, fields->Length); }
                 catch (Exception^ e) {
-                    String^ scriptTypeName = (script->GetType() != nullptr) ? script->GetType()->Name : "Unknown Script";
-                    Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during {0}->Start() for Entity {1}: {2}", scriptTypeName, entityId, e->Message));
-                    Console::Error->WriteLine(e->StackTrace);
+                    // Keep the script with its default field values, as RestoreScript() does
+                    Console::Error->WriteLine(String::Format("[ScriptAPI] Exception restoring fields of {0} on Entity {1}: {2}", script->GetType()->Name, entityId, e->Message));
                 }
             }
+            RegisterScript(script);
         }
+        return failures;
     }
 
-    void EngineInterface::ExecuteUpdate()
+    int EngineInterface::WakeDueEntities(Core::ScriptErrorInfo* error)
     {
-        if (!isInitialized || activeScripts == nullptr) return;
-        auto entitiesWithScripts = gcnew List<KeyValuePair<int, List<Script^>^>>(activeScripts);
-        for each (KeyValuePair<int, List<Script^>^> pair in entitiesWithScripts) {
-            int entityId = pair.Key;
-            List<Script^>^ entityScripts = pair.Value;
-            auto scriptsToUpdate = gcnew List<Script^>(entityScripts);
-            for each (Script ^ script in scriptsToUpdate) {
-                if (script == nullptr) continue;
-                try { script->Update(); }
-                catch (Exception^ e) {
-                    String^ scriptTypeName = (script->GetType() != nullptr) ? script->GetType()->Name : "Unknown Script";
-                    Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during {0}->Update() for Entity {1}: {2}", scriptTypeName, entityId, e->Message));
-                    Console::Error->WriteLine(e->StackTrace);
+        if (dueEntities == nullptr) dueEntities = gcnew List<int>();
+        dueEntities->Clear();
+        Dormancy::CollectDue(dueEntities);
+
+        int exceptions = 0;
+        for (int i = 0; i < dueEntities->Count; ++i) exceptions += ApplyWake(dueEntities[i], error);
+        return exceptions;
+    }
+
+    List<KeyValuePair<DormantEntity^, array<String^>^>>^ EngineInterface::KeepCompacted()
+    {
+        List<KeyValuePair<DormantEntity^, array<String^>^>>^ compacted = gcnew List<KeyValuePair<DormantEntity^, array<String^>^>>();
+        for each (DormantEntity^ dormant in Dormancy::GetCompacted()) {
+            array<String^>^ typeNames = gcnew array<String^>(dormant->TypeIds->Count);
+            for (int i = 0; i < typeNames->Length; ++i) typeNames[i] = ScriptTypes::GetTypeName(dormant->TypeIds[i]);
+            compacted->Add(KeyValuePair<DormantEntity^, array<String^>^>(dormant, typeNames));
+        }
+        return compacted;
+    }
+
+    void EngineInterface::RestoreCompacted(List<KeyValuePair<DormantEntity^, array<String^>^>>^ compacted)
+    {
+        int restored = 0;
+        for each (KeyValuePair<DormantEntity^, array<String^>^> entry in compacted) {
+            DormantEntity^ dormant = entry.Key;
+            List<int>^ typeIds = gcnew List<int>(entry.Value->Length);
+            List<array<Byte>^>^ fields = gcnew List<array<Byte>^>(entry.Value->Length);
+            for (int i = 0; i < entry.Value->Length; ++i) {
+                int typeId = ScriptTypes::GetTypeId(entry.Value[i]);
+                if (typeId < 0) {
+                    Console::Error->WriteLine(String::Format("[ScriptAPI] Warning: Script type '{0}' is gone; dropped its compacted script on dormant Entity {1}.", entry.Value[i], dormant->EntityId));
+                    continue;
                 }
+                typeIds->Add(typeId);
+                fields->Add(dormant->Fields[i]);
             }
+            if (typeIds->Count == 0) continue;
+
+            dormant->TypeIds = typeIds;
+            dormant->Fields = fields;
+            Dormancy::Restore(dormant);
+            ++restored;
+        }
+        if (restored > 0) Console::WriteLine(String::Format("[ScriptAPI] Kept {0} compacted dormant entities across the reload.", restored));
+    }
+
+    void EngineInterface::ClaimCompacted(Script^ script)
+    {
+        DormantEntity^ dormant = Dormancy::Find(script->GetEntityId());
+        if (dormant == nullptr || !dormant->Reloaded || dormant->TypeIds == nullptr) return;
+        int i = dormant->TypeIds->IndexOf(script->GetTypeId());
+        if (i < 0) return;
+
+        array<Byte>^ fields = dormant->Fields[i];
+        dormant->TypeIds->RemoveAt(i);
+        dormant->Fields->RemoveAt(i);
+        if (dormant->TypeIds->Count == 0) {
+            dormant->TypeIds = nullptr;
+            dormant->Fields = nullptr;
+        }
+        if (fields->Length == 0) return;
+
+        pin_ptr<Byte> pinned = &fields[0];
+        try { ScriptSerializer::Deserialize(script, pinned, fields->Length); }
+        catch (Exception^ e) {
+            Console::Error->WriteLine(String::Format("[ScriptAPI] Exception restoring fields of {0} on Entity {1}: {2}", script->GetType()->Name, script->GetEntityId(), e->Message));
+        }
+    }
+
+    void EngineInterface::MarkTypeListForPrune(int typeId)
+    {
+        if (typeListsToPrune == nullptr) typeListsToPrune = gcnew array<bool>(ScriptTypes::Count);
+        typeListsToPrune[typeId] = true;
+        pruneNeeded = true;
+    }
+
+    void EngineInterface::PruneTypeLists()
+    {
+        if (!pruneNeeded) return;
+        pruneNeeded = false;
+
+        // One compaction per touched list, instead of a List::Remove() per sleeping script
+        for (int typeId = 0; typeId < typeListsToPrune->Length; ++typeId) {
+            if (!typeListsToPrune[typeId]) continue;
+            typeListsToPrune[typeId] = false;
+
+            List<Script^>^ scripts = scriptsByType[typeId];
+            if (scripts == nullptr) continue;
+            int kept = 0;
+            for (int i = 0; i < scripts->Count; ++i) {
+                if (scripts[i]->GetStartState() == ScriptStartState::Started) scripts[kept++] = scripts[i];
+            }
+            scripts->RemoveRange(kept, scripts->Count - kept);
+        }
+    }
+
+    int EngineInterface::SleepEntity(int entityId, float wakeAfterSeconds, int compact, Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            if (!isInitialized) return Fail(error, "SleepEntity called before successful initialization/reload.");
+            if (!ApplySleep(entityId, wakeAfterSeconds, compact != 0)) {
+                return Fail(error, String::Format("Entity {0} has no scripts.", entityId));
+            }
+            PruneTypeLists();
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "SleepEntity", e);
+        }
+    }
+
+    int EngineInterface::WakeEntity(int entityId, Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            if (!isInitialized) return ToInt(Core::ScriptStatus::Ok);
+            int exceptions = ApplyWake(entityId, error);
+            return ToInt(exceptions > 0 ? Core::ScriptStatus::ScriptException : Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "WakeEntity", e);
+        }
+    }
+
+    int EngineInterface::CaptureScriptSnapshot(int* count, Core::ScriptErrorInfo* error)
+    {
+        *count = 0;
+        try
+        {
+            snapshotScripts = gcnew List<Script^>();
+            snapshotCompacted = gcnew List<KeyValuePair<DormantEntity^, int>>();
+            if (!isInitialized || activeScripts == nullptr) return ToInt(Core::ScriptStatus::Ok);
+
+            for each (KeyValuePair<int, List<Script^>^> pair in activeScripts) {
+                snapshotScripts->AddRange(pair.Value);
+            }
+            // Compacted dormant entities are saved from their blobs, after the live scripts
+            for each (DormantEntity^ dormant in Dormancy::GetCompacted()) {
+                for (int i = 0; i < dormant->TypeIds->Count; ++i) {
+                    snapshotCompacted->Add(KeyValuePair<DormantEntity^, int>(dormant, i));
+                }
+            }
+            *count = snapshotScripts->Count + snapshotCompacted->Count;
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            snapshotScripts = nullptr;
+            snapshotCompacted = nullptr;
+            return FailInternal(error, "CaptureScriptSnapshot", e);
+        }
+    }
+
+    int EngineInterface::SerializeSnapshotScript(int index, int* entityId, char* typeName, int typeNameCapacity,
+                                                 unsigned char* fields, int fieldCapacity, int* length, Core::ScriptErrorInfo* error)
+    {
+        *entityId = -1;
+        *length = 0;
+        try
+        {
+            if (snapshotScripts == nullptr || index < 0) return Fail(error, "SerializeSnapshotScript called without a capture.");
+            if (index >= snapshotScripts->Count) {
+                return SerializeCompactedSnapshotScript(index - snapshotScripts->Count, entityId, typeName, typeNameCapacity,
+                                                        fields, fieldCapacity, length, error);
+            }
+
+            Script^ script = snapshotScripts[index];
+            List<Script^>^ entityScripts;
+            if (script == nullptr || activeScripts == nullptr ||
+                !activeScripts->TryGetValue(script->GetEntityId(), entityScripts) || !entityScripts->Contains(script)) {
+                return ToInt(Core::ScriptStatus::Ok); // Removed since the capture
+            }
+
+            String^ name = script->GetType()->FullName;
+            if (Text::Encoding::UTF8->GetByteCount(name) >= typeNameCapacity) {
+                return Fail(error, String::Format("Script type name too long to snapshot: {0}", name));
+            }
+
+            int blobLength = 0;
+            array<Byte>^ blob;
+            try { blob = ScriptSerializer::Serialize(script, blobLength); }
+            catch (Exception^ e) {
+                RecordScriptException(error, script, script->GetEntityId(), e);
+                return ToInt(Core::ScriptStatus::ScriptException);
+            }
+            if (blobLength > fieldCapacity) {
+                *length = -blobLength;
+                return ToInt(Core::ScriptStatus::Ok);
+            }
+
+            CopyUtf8(name, typeName, typeNameCapacity);
+            if (blobLength > 0) Marshal::Copy(blob, 0, IntPtr(fields), blobLength);
+            *entityId = script->GetEntityId();
+            *length = blobLength;
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            *entityId = -1;
+            return FailInternal(error, "SerializeSnapshotScript", e);
+        }
+    }
+
+    int EngineInterface::SerializeCompactedSnapshotScript(int index, int* entityId, char* typeName, int typeNameCapacity,
+                                                          unsigned char* fields, int fieldCapacity, int* length, Core::ScriptErrorInfo* error)
+    {
+        if (snapshotCompacted == nullptr || index >= snapshotCompacted->Count) {
+            return Fail(error, String::Format("Snapshot script index {0} is out of range.", index));
+        }
+
+        DormantEntity^ dormant = snapshotCompacted[index].Key;
+        int script = snapshotCompacted[index].Value;
+        if (Dormancy::Find(dormant->EntityId) != dormant || script >= dormant->TypeIds->Count) {
+            return ToInt(Core::ScriptStatus::Ok); // Woken since the capture
+        }
+
+        String^ name = ScriptTypes::GetScriptType(dormant->TypeIds[script])->FullName;
+        if (Text::Encoding::UTF8->GetByteCount(name) >= typeNameCapacity) {
+            return Fail(error, String::Format("Script type name too long to snapshot: {0}", name));
+        }
+        array<Byte>^ blob = dormant->Fields[script];
+        if (blob->Length > fieldCapacity) {
+            *length = -blob->Length;
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+
+        CopyUtf8(name, typeName, typeNameCapacity);
+        if (blob->Length > 0) Marshal::Copy(blob, 0, IntPtr(fields), blob->Length);
+        *entityId = dormant->EntityId;
+        *length = blob->Length;
+        return ToInt(Core::ScriptStatus::Ok);
+    }
+
+    int EngineInterface::ReleaseScriptSnapshot(Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            snapshotScripts = nullptr;
+            snapshotCompacted = nullptr;
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "ReleaseScriptSnapshot", e);
+        }
+    }
+
+    int EngineInterface::RestoreScript(int entityId, String^ typeName, const unsigned char* fields, int fieldLength,
+                                       Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            Script^ script = CreateScript(entityId, typeName, error);
+            if (script == nullptr) return ToInt(Core::ScriptStatus::Failed);
+
+            try { ScriptSerializer::Deserialize(script, fields, fieldLength); }
+            catch (Exception^ e) {
+                // Keep the script with its default field values rather than dropping it
+                RecordScriptException(error, script, entityId, e);
+                return ToInt(Core::ScriptStatus::ScriptException);
+            }
+            return ToInt(Core::ScriptStatus::Ok); // Start() runs from RunPendingStarts()
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "RestoreScript", e);
+        }
+    }
+
+    int EngineInterface::Shutdown(Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            UnloadScripts();
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "Shutdown", e);
+        }
+    }
+
+    int EngineInterface::LoadPrefabs(String^ path, Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            String^ message = nullptr;
+            int loaded = Prefabs::LoadFile(path, message);
+            if (loaded < 0) return Fail(error, message);
+            Console::WriteLine(String::Format("[ScriptAPI] Loaded {0} prefab(s) from {1}.", loaded, path));
+            return ToInt(Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "LoadPrefabs", e);
+        }
+    }
+
+    int EngineInterface::GetPrefabId(String^ name)
+    {
+        try { return Prefabs::GetId(name); }
+        catch (Exception^) { return -1; }
+    }
+
+    int EngineInterface::InstantiatePrefab(int prefabId, int count, int* entityIds, Core::ScriptErrorInfo* error)
+    {
+        try
+        {
+            if (!isInitialized) return Fail(error, "InstantiatePrefab called before successful initialization/reload.");
+            PrefabPlan^ plan = Prefabs::GetPlan(prefabId);
+            if (plan == nullptr || count < 0) {
+                return Fail(error, String::Format("Prefab {0} is unknown or failed to compile.", prefabId));
+            }
+
+            array<int>^ ids = gcnew array<int>(count);
+            int first = Core::EntityIds::instance().allocate(count);
+            for (int i = 0; i < count; ++i) {
+                ids[i] = first + i;
+                entityIds[i] = ids[i];
+            }
+            int exceptions = CreatePrefabInstances(plan, ids, error);
+            return ToInt(exceptions > 0 ? Core::ScriptStatus::ScriptException : Core::ScriptStatus::Ok);
+        }
+        catch (Exception^ e)
+        {
+            return FailInternal(error, "InstantiatePrefab", e);
         }
     }
 
-    void EngineInterface::Shutdown()
+    void EngineInterface::UnloadScripts()
     {
         Console::WriteLine("[ScriptAPI] Shutting down...");
         // Clear script data first
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "script.hxx" // Include the base script class definition
+#include "commands.hxx"
+#include "execution_plan.hxx"
+#include "components.hxx"
+#include "prefabs.hxx"
+#include "dormancy.hxx"
+
+#include "script_call.h" // Core: ScriptStatus, ScriptErrorInfo
 
 // Use Managed C++ namespaces
 using namespace System;
@@ -11,35 +18,155 @@ using namespace System::Collections::Generic; // For List<>, Dictionary<>
 
 namespace ScriptAPI
 {
+    // Entry points called by the engine. None of them throw: each returns a
+    // Core::ScriptStatus and describes failures in the caller's ScriptErrorInfo.
     public ref class EngineInterface
     {
     public:
-        static bool Init();
-        static bool AddScript(int entityId, String^ scriptName);
-        static void ExecuteStartForEntity(int entityId);
-        static void ExecuteUpdate();
-        // --- New Method ---
+        static int Init(Core::ScriptErrorInfo* error);
+        // Pre-JIT script code after every load (on by default). Call before Init().
+        static void SetJitWarmup(int enabled);
+        // Track scripts with [Replicated] fields in Core::ReplicationServer (off by
+        // default). Call before Init().
+        static void SetReplication(int enabled);
+        // Per-script-type allocation tracking (off by default); see AllocationTracker.
+        // Call before Init().
+        static void SetAllocationTracking(int enabled);
+        // Resolves a script type name (full or short) to its dense id, -1 if unknown.
+        // Ids are only valid until the next Reload().
+        static int GetScriptTypeId(String^ scriptName);
+        static int AddScript(int entityId, String^ scriptName, Core::ScriptErrorInfo* error);
+        // Added scripts are queued; their Start() runs from RunPendingStarts() (or
+        // ExecuteStartForEntity()) and they receive no Update() until it completes.
+        static int AddScriptById(int entityId, int typeId, Core::ScriptErrorInfo* error);
+        // Starts the entity's queued scripts now, ignoring the frame budget.
+        static int ExecuteStartForEntity(int entityId, Core::ScriptErrorInfo* error);
+        // Delivers finished Streaming reads and Navigation paths, completes finished
+        // StartAsync() tasks, then runs queued Start() calls until 'budgetMicroseconds' is
+        // used up (at least one per call, so the queue drains).
+        static int RunPendingStarts(int budgetMicroseconds, Core::ScriptErrorInfo* error);
+        // Updates every script whose type runs in 'phase' (a Core::ScriptPhase), following
+        // the execution plan built at load, then runs the phase's component systems.
+        static int ExecutePhase(int phase, Core::ScriptErrorInfo* error);
+        // Copies [Replicated] field values into Core::ReplicationServer. Call once per
+        // network tick, before the server writes its packets.
+        static int GatherReplicated(Core::ScriptErrorInfo* error);
         // Reloads the script assembly and re-initializes script types.
-        static bool Reload();
-        // --- End New Method ---
-        static void Shutdown();
+        static int Reload(Core::ScriptErrorInfo* error);
+        static int Shutdown(Core::ScriptErrorInfo* error);
+
+        // --- Prefabs (see Prefabs) ---
+        // Loads prefab definitions from a text file. Prefabs are compiled against the script
+        // types on every load, so this may be called before or after Init().
+        static int LoadPrefabs(String^ path, Core::ScriptErrorInfo* error);
+        static int GetPrefabId(String^ name);
+        // Creates 'count' entities from the prefab now and writes their ids to 'entityIds'
+        // (room for 'count'). Their Start() runs from RunPendingStarts().
+        static int InstantiatePrefab(int prefabId, int count, int* entityIds, Core::ScriptErrorInfo* error);
+
+        // --- Dormancy (see Dormancy) ---
+        // Takes the entity's scripts out of the update lists now. 'wakeAfterSeconds' > 0
+        // sets a wake timer; 'compact' != 0 serializes and releases the scripts. Fails if
+        // the entity has no scripts.
+        static int SleepEntity(int entityId, float wakeAfterSeconds, int compact, Core::ScriptErrorInfo* error);
+        // No-op if the entity is awake. Compacted scripts are recreated and Start() again.
+        static int WakeEntity(int entityId, Core::ScriptErrorInfo* error);
+
+        // --- World snapshot entry points (see Core/world_snapshot.h) ---
+        // Captures the current script instances; the native save job then serializes them
+        // one at a time across frames and releases the capture when done.
+        static int CaptureScriptSnapshot(int* count, Core::ScriptErrorInfo* error);
+        // Writes the entity id, type name and field blob of captured script 'index'; *length is
+        // the blob length, or -(required capacity) if 'fields' is too small. *entityId stays -1
+        // if the script was removed since the capture or could not be serialized.
+        static int SerializeSnapshotScript(int index, int* entityId, char* typeName, int typeNameCapacity,
+                                           unsigned char* fields, int fieldCapacity, int* length, Core::ScriptErrorInfo* error);
+        static int ReleaseScriptSnapshot(Core::ScriptErrorInfo* error);
+        // Creates the script, applies the saved fields and queues its Start(). Returns
+        // ScriptException if the fields could not be applied; the script keeps its defaults.
+        static int RestoreScript(int entityId, String^ typeName, const unsigned char* fields, int fieldLength,
+                                 Core::ScriptErrorInfo* error);
 
     private:
-        static void DiscoverScriptTypes();
         static List<Script^>^ GetOrCreateEntityScriptList(int entityId);
-        static bool IsConcreteScript(Type^ type);
+        // Instantiates and registers a script; nullptr on failure (described in 'error').
+        static Script^ CreateScript(int entityId, String^ scriptName, Core::ScriptErrorInfo* error);
+        static Script^ CreateScript(int entityId, int typeId, Core::ScriptErrorInfo* error);
+        // Adds a new script (entity id set) to its entity's list and index and queues its Start().
+        static void RegisterScript(Script^ script);
+
+        // --- Error reporting ---
+        static int Fail(Core::ScriptErrorInfo* error, String^ message);
+        static int FailInternal(Core::ScriptErrorInfo* error, String^ call, Exception^ e);
+        // Counts the exception; only the first one of a call is described.
+        static void RecordScriptException(Core::ScriptErrorInfo* error, Script^ script, int entityId, Exception^ e);
+        static void RecordSystemException(Core::ScriptErrorInfo* error, ComponentSystemBase^ system, Exception^ e);
+        static void CopyUtf8(String^ text, char* buffer, int capacity);
+
+        // Applies structural changes recorded through Commands. Returns the number of
+        // failures (script constructors or Start() throwing), described in 'error'.
+        static int FlushCommands(Core::ScriptErrorInfo* error);
+        static void RemoveScriptInstance(Script^ script);
+        // Creates the prefab's scripts on each of 'entityIds' (all new). Returns the number
+        // of failed constructors, described in 'error'.
+        static int CreatePrefabInstances(PrefabPlan^ plan, array<int>^ entityIds, Core::ScriptErrorInfo* error);
+
+        // --- Dormancy ---
+        // Returns false if the entity has no scripts and isn't dormant.
+        static bool ApplySleep(int entityId, float wakeAfterSeconds, bool compact);
+        // Returns the number of compacted scripts whose constructor threw.
+        static int ApplyWake(int entityId, Core::ScriptErrorInfo* error);
+        // Wakes entities whose timer ran out or that are in an activation region; once per frame.
+        static int WakeDueEntities(Core::ScriptErrorInfo* error);
+        // Sleeping and removed scripts leave their type lists in one pass per list, at the end of the flush.
+        static void MarkTypeListForPrune(int typeId);
+        static void PruneTypeLists();
+        static int SerializeCompactedSnapshotScript(int index, int* entityId, char* typeName, int typeNameCapacity,
+                                                    unsigned char* fields, int fieldCapacity, int* length, Core::ScriptErrorInfo* error);
+        // Compacted scripts only exist as blobs, which outlive their types: Reload() keeps
+        // them by type name and puts them back once the new types are loaded.
+        static List<KeyValuePair<DormantEntity^, array<String^>^>>^ KeepCompacted();
+        static void RestoreCompacted(List<KeyValuePair<DormantEntity^, array<String^>^>>^ compacted);
+        // A script the host adds again to a reloaded dormant entity takes over the blob of
+        // its type, so the entity doesn't end up with both.
+        static void ClaimCompacted(Script^ script);
+
+        // --- Start lifecycle ---
+        // Runs Start() and StartAsync(). Returns 1 if either threw, else 0.
+        static int BeginStart(Script^ script, Core::ScriptErrorInfo* error);
+        // Makes the script visible to ExecutePhase().
+        static void CompleteStart(Script^ script);
+        static void MarkRemoved(Script^ script);
 
         // --- Helper for cleanup ---
         static void ClearScriptData();
+        // Clears script data and unloads the load context (Shutdown, failed Init/Reload)
+        static void UnloadScripts();
         // --- Helper for assembly loading/discovery ---
-        static bool LoadAndDiscoverScripts();
+        static bool LoadAndDiscoverScripts(Core::ScriptErrorInfo* error);
 
 
         // --- Static Members ---
         static AssemblyLoadContext^ scriptLoadContext = nullptr;
         static Assembly^ scriptAssembly = nullptr;
         static bool isInitialized = false;
-        static Dictionary<String^, Type^>^ availableScriptTypes = nullptr;
         static Dictionary<int, List<Script^>^>^ activeScripts = nullptr;
+        // Per-entity type index behind Script::GetScript<T>(), same keys as activeScripts
+        static Dictionary<int, EntityScriptIndex^>^ entityIndices = nullptr;
+        static List<Script^>^ snapshotScripts = nullptr;
+        // Compacted scripts of the capture: record and index into its lists
+        static List<KeyValuePair<DormantEntity^, int>>^ snapshotCompacted = nullptr;
+        // Scripts bucketed by type id, walked in execution plan order
+        static array<List<Script^>^>^ scriptsByType = nullptr;
+        static ExecutionPlan^ executionPlan = nullptr;
+        // Struct component systems per phase
+        static array<array<ComponentSystemBase^>^>^ componentSystems = nullptr;
+        static List<Command>^ pendingCommands = nullptr;
+        static Queue<Script^>^ startQueue = nullptr;
+        static List<Script^>^ awaitingStarts = nullptr;
+        static array<bool>^ typeListsToPrune = nullptr;
+        static bool pruneNeeded = false;
+        static List<int>^ dueEntities = nullptr;
+        literal int MaxFlushPasses = 8;
     };
 } // namespace ScriptAPI
\ No newline at end of file
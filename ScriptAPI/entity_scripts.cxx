@@ -0,0 +1,119 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+#using <System.Runtime.Intrinsics.dll> // For BitOperations
+
+#include "entity_scripts.hxx"
+
+using namespace System::Numerics; // For BitOperations
+
+namespace ScriptAPI
+{
+    EntityScriptIndex::EntityScriptIndex(List<Script^>^ scripts, int typeCount)
+        : scripts(scripts)
+        , mask(gcnew array<UInt64>((typeCount + 63) / 64))
+        , wordStarts(gcnew array<int>((typeCount + 63) / 64))
+        , dense(gcnew array<Script^>(2))
+        , denseCount(0)
+    {
+    }
+
+    EntityScriptIndex::EntityScriptIndex(List<Script^>^ scripts, EntityScriptIndex^ layout)
+        : scripts(scripts)
+        , mask(safe_cast<array<UInt64>^>(layout->mask->Clone()))
+        , wordStarts(safe_cast<array<int>^>(layout->wordStarts->Clone()))
+        , dense(gcnew array<Script^>(layout->dense->Length))
+        , denseCount(layout->denseCount)
+    {
+        for (int i = 0; i < scripts->Count; ++i) {
+            int slot = Rank(scripts[i]->GetTypeId());
+            if (dense[slot] == nullptr) dense[slot] = scripts[i]; // First of each type, as in Add()
+        }
+    }
+
+    EntityScriptIndex^ EntityScriptIndex::CreateLayout(array<int>^ typeIds, int typeCount)
+    {
+        EntityScriptIndex^ layout = gcnew EntityScriptIndex(gcnew List<Script^>(), typeCount);
+        for each (int typeId in typeIds) {
+            int word = typeId >> 6;
+            UInt64 bit = UInt64(1) << (typeId & 63);
+            if ((layout->mask[word] & bit) != 0) continue;
+            layout->mask[word] |= bit;
+            ++layout->denseCount;
+        }
+        for (int w = 1; w < layout->wordStarts->Length; ++w) {
+            layout->wordStarts[w] = layout->wordStarts[w - 1] + BitOperations::PopCount(layout->mask[w - 1]);
+        }
+        layout->dense = gcnew array<Script^>(Math::Max(2, layout->denseCount));
+        return layout;
+    }
+
+    int EntityScriptIndex::Rank(int typeId)
+    {
+        int word = typeId >> 6;
+        UInt64 below = (UInt64(1) << (typeId & 63)) - 1;
+        return wordStarts[word] + BitOperations::PopCount(mask[word] & below);
+    }
+
+    Script^ EntityScriptIndex::Find(int typeId)
+    {
+        int word = typeId >> 6;
+        if (typeId < 0 || word >= mask->Length) return nullptr;
+        if ((mask[word] & (UInt64(1) << (typeId & 63))) == 0) return nullptr;
+        return dense[Rank(typeId)];
+    }
+
+    Script^ EntityScriptIndex::FindAssignable(Type^ type)
+    {
+        for (int i = 0; i < scripts->Count; ++i) {
+            if (type->IsInstanceOfType(scripts[i])) return scripts[i];
+        }
+        return nullptr;
+    }
+
+    void EntityScriptIndex::Add(Script^ script)
+    {
+        if (Find(script->GetTypeId()) == nullptr) Insert(script->GetTypeId(), script);
+    }
+
+    void EntityScriptIndex::Remove(Script^ script)
+    {
+        int typeId = script->GetTypeId();
+        if (Find(typeId) != script) return; // Not the indexed one of its type
+
+        // Another script of the same type on the entity takes its place
+        for (int i = 0; i < scripts->Count; ++i) {
+            if (scripts[i]->GetTypeId() == typeId) {
+                dense[Rank(typeId)] = scripts[i];
+                return;
+            }
+        }
+        Erase(typeId);
+    }
+
+    void EntityScriptIndex::Insert(int typeId, Script^ script)
+    {
+        int index = Rank(typeId);
+        if (denseCount == dense->Length) Array::Resize(dense, dense->Length * 2);
+        Array::Copy(dense, index, dense, index + 1, denseCount - index);
+        dense[index] = script;
+        ++denseCount;
+
+        int word = typeId >> 6;
+        mask[word] |= UInt64(1) << (typeId & 63);
+        for (int w = word + 1; w < wordStarts->Length; ++w) ++wordStarts[w];
+    }
+
+    void EntityScriptIndex::Erase(int typeId)
+    {
+        int index = Rank(typeId);
+        Array::Copy(dense, index + 1, dense, index, denseCount - index - 1);
+        dense[--denseCount] = nullptr;
+
+        int word = typeId >> 6;
+        mask[word] &= ~(UInt64(1) << (typeId & 63));
+        for (int w = word + 1; w < wordStarts->Length; ++w) --wordStarts[w];
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "script.hxx"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // Scripts of one entity, indexed by script type id for GetScript<T>().
+    // Which types are present is a bitmask over type ids; the scripts themselves are
+    // stored densely in type id order, so a lookup is a bit test plus a popcount and
+    // never allocates. The first script added of each type is the one found.
+    ref class EntityScriptIndex sealed
+    {
+    internal:
+        // 'scripts' is the entity's list in EngineInterface::activeScripts; the index
+        // reads it to find a replacement when a script is removed.
+        EntityScriptIndex(List<Script^>^ scripts, int typeCount);
+        // Index over a freshly created entity whose scripts have the types 'layout' was
+        // made for (see CreateLayout()); copies its bitmask instead of inserting each type.
+        EntityScriptIndex(List<Script^>^ scripts, EntityScriptIndex^ layout);
+
+        // Template with the bits of 'typeIds' set and no scripts, for the constructor above.
+        static EntityScriptIndex^ CreateLayout(array<int>^ typeIds, int typeCount);
+
+        Script^ Find(int typeId);
+        // First script assignable to 'type' (for abstract bases, which have no type id).
+        Script^ FindAssignable(Type^ type);
+
+        void Add(Script^ script);
+        // Call after removing 'script' from the entity's list.
+        void Remove(Script^ script);
+
+    private:
+        int Rank(int typeId);
+        void Insert(int typeId, Script^ script);
+        void Erase(int typeId);
+
+        List<Script^>^ scripts;
+        array<UInt64>^ mask;
+        array<int>^ wordStarts; // Number of set bits in the words before each word
+        array<Script^>^ dense;
+        int denseCount;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,203 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+
+#include "execution_plan.hxx"
+#include "script_registry.hxx"
+
+namespace ScriptAPI
+{
+    ExecutionPlan::ExecutionPlan()
+    {
+        order = gcnew array<array<int>^>(PhaseCount);
+        groupStarts = gcnew array<array<int>^>(PhaseCount);
+    }
+
+    ScriptPhase ExecutionPlan::GetPhase(Type^ type)
+    {
+        ExecutionPhaseAttribute^ attribute = safe_cast<ExecutionPhaseAttribute^>(
+            Attribute::GetCustomAttribute(type, ExecutionPhaseAttribute::typeid, true));
+        return attribute != nullptr ? attribute->Phase : ScriptPhase::Update;
+    }
+
+    ExecutionPlan^ ExecutionPlan::Build()
+    {
+        int typeCount = ScriptTypes::Count;
+        array<ScriptPhase>^ phaseOf = gcnew array<ScriptPhase>(typeCount);
+        Dictionary<Type^, int>^ idOf = gcnew Dictionary<Type^, int>(typeCount);
+        for (int id = 0; id < typeCount; ++id)
+        {
+            Type^ type = ScriptTypes::GetScriptType(id);
+            phaseOf[id] = GetPhase(type);
+            idOf[type] = id;
+        }
+
+        // Edges 'before -> after' between types of the same phase
+        Dictionary<int, List<int>^>^ successors = gcnew Dictionary<int, List<int>^>();
+        for (int id = 0; id < typeCount; ++id)
+        {
+            Type^ type = ScriptTypes::GetScriptType(id);
+            for each (Attribute^ attribute in Attribute::GetCustomAttributes(type, false))
+            {
+                ExecuteBeforeAttribute^ before = dynamic_cast<ExecuteBeforeAttribute^>(attribute);
+                ExecuteAfterAttribute^ after = dynamic_cast<ExecuteAfterAttribute^>(attribute);
+                Type^ otherType = before != nullptr ? before->Other : after != nullptr ? after->Other : nullptr;
+                if (otherType == nullptr) continue;
+
+                int other;
+                if (!idOf->TryGetValue(otherType, other))
+                {
+                    Console::Error->WriteLine(String::Format("[ScriptAPI] Warning: {0} orders itself against {1}, which is not a script type.", type->FullName, otherType->FullName));
+                    continue;
+                }
+
+                int first = before != nullptr ? id : other;
+                int second = before != nullptr ? other : id;
+                if (phaseOf[first] != phaseOf[second])
+                {
+                    // Satisfied by phase order, or impossible
+                    if (static_cast<int>(phaseOf[first]) > static_cast<int>(phaseOf[second]))
+                    {
+                        Console::Error->WriteLine(String::Format("[ScriptAPI] Warning: {0} ({1}) cannot run before {2} ({3}); constraint ignored.",
+                            ScriptTypes::GetTypeName(first), phaseOf[first], ScriptTypes::GetTypeName(second), phaseOf[second]));
+                    }
+                    continue;
+                }
+
+                List<int>^ next;
+                if (!successors->TryGetValue(first, next))
+                {
+                    next = gcnew List<int>();
+                    successors->Add(first, next);
+                }
+                if (!next->Contains(second)) next->Add(second);
+            }
+        }
+
+        ExecutionPlan^ plan = gcnew ExecutionPlan();
+        for (int phase = 0; phase < PhaseCount; ++phase)
+        {
+            List<int>^ typeIds = gcnew List<int>();
+            for (int id = 0; id < typeCount; ++id)
+            {
+                if (static_cast<int>(phaseOf[id]) == phase) typeIds->Add(id);
+            }
+
+            List<int>^ sorted = gcnew List<int>(typeIds->Count);
+            List<int>^ starts = gcnew List<int>();
+            SortPhase(typeIds, successors, sorted, starts);
+            plan->order[phase] = sorted->ToArray();
+            plan->groupStarts[phase] = starts->ToArray();
+        }
+        return plan;
+    }
+
+    void ExecutionPlan::SortPhase(List<int>^ typeIds, Dictionary<int, List<int>^>^ successors,
+                                  List<int>^ outOrder, List<int>^ outGroupStarts)
+    {
+        Dictionary<int, int>^ inDegree = gcnew Dictionary<int, int>();
+        for each (int id in typeIds) inDegree[id] = 0;
+        for each (int id in typeIds)
+        {
+            List<int>^ next;
+            if (!successors->TryGetValue(id, next)) continue;
+            for each (int s in next) inDegree[s] = inDegree[s] + 1;
+        }
+
+        // typeIds is ascending, so every layer comes out in type id order
+        List<int>^ layer = gcnew List<int>();
+        for each (int id in typeIds)
+        {
+            if (inDegree[id] == 0) layer->Add(id);
+        }
+
+        while (layer->Count > 0)
+        {
+            outGroupStarts->Add(outOrder->Count);
+            outOrder->AddRange(layer);
+
+            List<int>^ nextLayer = gcnew List<int>();
+            for each (int id in layer)
+            {
+                List<int>^ next;
+                if (!successors->TryGetValue(id, next)) continue;
+                for each (int s in next)
+                {
+                    int degree = inDegree[s] - 1;
+                    inDegree[s] = degree;
+                    if (degree == 0) nextLayer->Add(s);
+                }
+            }
+            nextLayer->Sort();
+            layer = nextLayer;
+        }
+
+        if (outOrder->Count < typeIds->Count)
+        {
+            // Cycle: run the remaining types one at a time in id order. Types left over are
+            // either on a cycle or ordered after one.
+            for each (int id in typeIds)
+            {
+                if (inDegree[id] <= 0) continue;
+                String^ reason = ReachesItself(id, inDegree, successors) ? "is part of" : "is blocked by";
+                Console::Error->WriteLine(String::Format("[ScriptAPI] Warning: {0} {1} an ordering cycle; its constraints are ignored.",
+                    ScriptTypes::GetTypeName(id), reason));
+                outGroupStarts->Add(outOrder->Count);
+                outOrder->Add(id);
+            }
+        }
+        outGroupStarts->Add(outOrder->Count); // Terminator
+    }
+
+    bool ExecutionPlan::ReachesItself(int id, Dictionary<int, int>^ inDegree, Dictionary<int, List<int>^>^ successors)
+    {
+        // Only types the sort could not place (inDegree > 0) can be on a cycle
+        HashSet<int>^ visited = gcnew HashSet<int>();
+        Stack<int>^ stack = gcnew Stack<int>();
+        stack->Push(id);
+        while (stack->Count > 0)
+        {
+            List<int>^ next;
+            if (!successors->TryGetValue(stack->Pop(), next)) continue;
+            for each (int s in next)
+            {
+                if (s == id) return true;
+                int degree;
+                if (inDegree->TryGetValue(s, degree) && degree > 0 && visited->Add(s)) stack->Push(s);
+            }
+        }
+        return false;
+    }
+
+    bool ExecutionPlan::IsConcurrent(ScriptPhase phase, int group)
+    {
+        array<int>^ starts = GetGroupStarts(phase);
+        return starts[group + 1] - starts[group] > 1;
+    }
+
+    void ExecutionPlan::Log()
+    {
+        for (int phase = 0; phase < PhaseCount; ++phase)
+        {
+            array<int>^ ids = order[phase];
+            array<int>^ starts = groupStarts[phase];
+            if (ids->Length == 0) continue;
+
+            Text::StringBuilder^ line = gcnew Text::StringBuilder();
+            for (int g = 0; g + 1 < starts->Length; ++g)
+            {
+                if (g > 0) line->Append(" -> ");
+                line->Append(starts[g + 1] - starts[g] > 1 ? "[" : "");
+                for (int i = starts[g]; i < starts[g + 1]; ++i)
+                {
+                    if (i > starts[g]) line->Append(", ");
+                    line->Append(ScriptTypes::GetTypeName(ids[i]));
+                }
+                line->Append(starts[g + 1] - starts[g] > 1 ? "]" : "");
+            }
+            Console::WriteLine(String::Format("[ScriptAPI]   {0}: {1}", static_cast<ScriptPhase>(phase), line));
+        }
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "script.hxx"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // Frame phases, in execution order. Values match Core::ScriptPhase.
+    public enum class ScriptPhase
+    {
+        PreUpdate = 0,
+        Update = 1,
+        LateUpdate = 2,
+        PostPhysics = 3 // After the native transform/spatial update
+    };
+
+    // Selects the phase in which a script's Update() runs. Scripts without it run in Update.
+    [AttributeUsage(AttributeTargets::Class, Inherited = true)]
+    public ref class ExecutionPhaseAttribute sealed : Attribute
+    {
+    public:
+        ExecutionPhaseAttribute(ScriptPhase phase) : phase(phase) {}
+        property ScriptPhase Phase { ScriptPhase get() { return phase; } }
+
+    private:
+        ScriptPhase phase;
+    };
+
+    // The annotated script type updates before 'other' within their phase.
+    [AttributeUsage(AttributeTargets::Class, AllowMultiple = true, Inherited = false)]
+    public ref class ExecuteBeforeAttribute sealed : Attribute
+    {
+    public:
+        ExecuteBeforeAttribute(Type^ other) : other(other) {}
+        property Type^ Other { Type^ get() { return other; } }
+
+    private:
+        Type^ other;
+    };
+
+    // The annotated script type updates after 'other' within their phase.
+    [AttributeUsage(AttributeTargets::Class, AllowMultiple = true, Inherited = false)]
+    public ref class ExecuteAfterAttribute sealed : Attribute
+    {
+    public:
+        ExecuteAfterAttribute(Type^ other) : other(other) {}
+        property Type^ Other { Type^ get() { return other; } }
+
+    private:
+        Type^ other;
+    };
+
+    // Per-phase script type order, resolved once from the attributes above when the script
+    // assembly is loaded. Each phase is a sequence of groups; the types inside a group have
+    // no ordering constraints between them, so a group of more than one type may be
+    // updated concurrently.
+    ref class ExecutionPlan sealed
+    {
+    internal:
+        literal int PhaseCount = 4;
+
+        // Builds the plan for the types currently in ScriptTypes.
+        static ExecutionPlan^ Build();
+
+        // Type ids of 'phase' in execution order
+        array<int>^ GetOrder(ScriptPhase phase) { return order[static_cast<int>(phase)]; }
+        // groupStarts[g] .. groupStarts[g + 1] is the slice of GetOrder() forming group g
+        array<int>^ GetGroupStarts(ScriptPhase phase) { return groupStarts[static_cast<int>(phase)]; }
+        bool IsConcurrent(ScriptPhase phase, int group);
+
+        void Log();
+
+        // The type's [ExecutionPhase], or Update if it has none.
+        static ScriptPhase GetPhase(Type^ type);
+
+    private:
+        ExecutionPlan();
+
+        // Kahn's algorithm, emitting one group per dependency layer
+        static void SortPhase(List<int>^ typeIds, Dictionary<int, List<int>^>^ successors,
+                              List<int>^ outOrder, List<int>^ outGroupStarts);
+        // True if 'id' reaches itself through types the sort left unplaced
+        static bool ReachesItself(int id, Dictionary<int, int>^ inDegree, Dictionary<int, List<int>^>^ successors);
+
+        array<array<int>^>^ order;
+        array<array<int>^>^ groupStarts;
+    };
+} // namespace ScriptAPI
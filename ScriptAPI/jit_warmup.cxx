@@ -0,0 +1,81 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Reflection.dll>
+
+#include "jit_warmup.hxx"
+#include "script_registry.hxx"
+
+using namespace System::Diagnostics; // For Stopwatch
+using namespace System::Reflection;
+using namespace System::Runtime::CompilerServices; // For RuntimeHelpers
+
+namespace ScriptAPI
+{
+    int JitWarmup::PrepareDeclaredMethods(Type^ type)
+    {
+        const BindingFlags declared = BindingFlags::DeclaredOnly | BindingFlags::Public | BindingFlags::NonPublic |
+                                      BindingFlags::Instance | BindingFlags::Static;
+        int prepared = 0;
+        for each (MethodInfo^ method in type->GetMethods(declared)) {
+            // Open generic methods need an instantiation we can't guess
+            if (method->IsAbstract || method->ContainsGenericParameters) continue;
+            try {
+                RuntimeHelpers::PrepareMethod(method->MethodHandle);
+                ++prepared;
+            }
+            catch (Exception^ e) {
+                Console::Error->WriteLine(String::Format("[ScriptAPI] Warning: Could not prepare {0}.{1}: {2}", type->Name, method->Name, e->Message));
+            }
+        }
+        for each (ConstructorInfo^ constructor in type->GetConstructors(BindingFlags::Public | BindingFlags::NonPublic | BindingFlags::Instance)) {
+            try {
+                RuntimeHelpers::PrepareMethod(constructor->MethodHandle);
+                ++prepared;
+            }
+            catch (Exception^) {} // Not worth a warning; constructors run once
+        }
+        return prepared;
+    }
+
+    void JitWarmup::Run(array<array<ComponentSystemBase^>^>^ systems)
+    {
+        if (!enabled) return;
+
+        long long start = Stopwatch::GetTimestamp();
+        int prepared = 0;
+        for (int typeId = 0; typeId < ScriptTypes::Count; ++typeId) {
+            Type^ type = ScriptTypes::GetScriptType(typeId);
+            // Script subclasses may themselves derive from other script classes
+            for (; type != nullptr && type != Script::typeid; type = type->BaseType) {
+                prepared += PrepareDeclaredMethods(type);
+            }
+        }
+
+        if (systems != nullptr) {
+            Type^ systemDefinition = ComponentSystem<int>::typeid->GetGenericTypeDefinition();
+            Type^ changedDefinition = ChangedSystem<int>::typeid->GetGenericTypeDefinition();
+            Type^ storeDefinition = ComponentStore<int>::typeid->GetGenericTypeDefinition();
+            for each (array<ComponentSystemBase^>^ phase in systems) {
+                for each (ComponentSystemBase^ system in phase) {
+                    Type^ type = system->GetType();
+                    prepared += PrepareDeclaredMethods(type);
+
+                    // ComponentSystem<T>.Run() (or ChangedSystem<T>.Run()) and the store it reads, closed over T
+                    Type^ closedSystem = type->BaseType;
+                    while (closedSystem != nullptr && !(closedSystem->IsGenericType &&
+                           (closedSystem->GetGenericTypeDefinition() == systemDefinition || closedSystem->GetGenericTypeDefinition() == changedDefinition))) {
+                        closedSystem = closedSystem->BaseType;
+                    }
+                    if (closedSystem == nullptr) continue;
+                    prepared += PrepareDeclaredMethods(closedSystem);
+                    prepared += PrepareDeclaredMethods(storeDefinition->MakeGenericType(closedSystem->GetGenericArguments()));
+                }
+            }
+        }
+
+        double milliseconds = static_cast<double>(Stopwatch::GetTimestamp() - start) * 1000.0 / Stopwatch::Frequency;
+        Console::WriteLine(String::Format("[ScriptAPI] JIT warm-up: prepared {0} methods in {1:F1} ms.", prepared, milliseconds));
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "components.hxx"
+
+using namespace System;
+
+namespace ScriptAPI
+{
+    // Compiles script code ahead of the first frame after a load.
+    // Without it, the first call of every script method pays for its JIT compilation
+    // inside the frame. Warm-up prepares every method declared by the script and component
+    // system types, plus the generic system plumbing instantiated over each component
+    // type. By default the code prepared here is Tier-0 and tiers up as usual; with
+    // --pgo-use the engine turns quick JIT off, so it is the final optimized code.
+    ref class JitWarmup abstract sealed
+    {
+    internal:
+        static property bool Enabled { bool get() { return enabled; } void set(bool value) { enabled = value; } }
+
+        // Prepares the types in ScriptTypes and the given systems. Logs the method count
+        // and time taken.
+        static void Run(array<array<ComponentSystemBase^>^>^ systems);
+
+    private:
+        // Returns the number of methods prepared.
+        static int PrepareDeclaredMethods(Type^ type);
+
+        static bool enabled = true;
+    };
+} // namespace ScriptAPI
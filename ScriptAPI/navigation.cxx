@@ -0,0 +1,100 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+
+#include "navigation.hxx"
+
+#include "navigation.h" // Core
+#include <cstring>
+#include <vector>
+
+using namespace System::Threading; // For Monitor
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        Core::Math::float3 ToNative(Float3 value)
+        {
+            return { value.X, value.Y, value.Z };
+        }
+    }
+
+    Task<NavPath>^ Navigation::FindPathAsync(Float3 start, Float3 goal)
+    {
+        TaskCompletionSource<NavPath>^ completion = gcnew TaskCompletionSource<NavPath>();
+        Monitor::Enter(pendingLock);
+        try {
+            Core::PathRequestId id = Core::NavigationService::instance().request(ToNative(start), ToNative(goal));
+            pending[id] = completion;
+        }
+        finally { Monitor::Exit(pendingLock); }
+        return completion->Task;
+    }
+
+    void Navigation::SetGrid(int width, int height, float cellSize, Float3 origin, array<Byte>^ costs)
+    {
+        if (costs == nullptr) throw gcnew ArgumentNullException("costs");
+        if (width <= 0 || height <= 0) throw gcnew ArgumentOutOfRangeException("width/height must be positive.");
+        if (!(cellSize > 0.0f)) throw gcnew ArgumentOutOfRangeException("cellSize");
+        if (static_cast<long long>(width) * height != costs->Length) {
+            throw gcnew ArgumentException("costs must hold width * height cells.", "costs");
+        }
+
+        Core::NavGrid grid(width, height, cellSize, ToNative(origin));
+        pin_ptr<Byte> pinned = &costs[0];
+        std::memcpy(grid.costs().data(), static_cast<Byte*>(pinned), static_cast<size_t>(costs->Length));
+        Core::NavigationService::instance().set_grid(std::move(grid));
+    }
+
+    bool Navigation::HasGrid::get()
+    {
+        return Core::NavigationService::instance().has_grid();
+    }
+
+    void Navigation::DeliverCompletions()
+    {
+        std::vector<Core::PathCompletion> completions;
+        std::vector<Core::Math::float3> waypoints;
+        if (Core::NavigationService::instance().poll(completions, waypoints) == 0) return;
+
+        // One array per frame for every path; the tasks' memory slices keep it alive
+        array<Float3>^ frameWaypoints = gcnew array<Float3>(static_cast<int>(waypoints.size()));
+        if (!waypoints.empty()) {
+            pin_ptr<Float3> pinned = &frameWaypoints[0];
+            std::memcpy(static_cast<Float3*>(pinned), waypoints.data(), waypoints.size() * sizeof(Core::Math::float3));
+        }
+
+        for (const Core::PathCompletion& result : completions) {
+            TaskCompletionSource<NavPath>^ completion = nullptr;
+            Monitor::Enter(pendingLock);
+            try {
+                if (pending->TryGetValue(result.id, completion)) pending->Remove(result.id);
+            }
+            finally { Monitor::Exit(pendingLock); }
+            if (completion == nullptr) continue; // Dropped by CancelAll()
+
+            PathStatus status = result.status == Core::PathStatus::Found ? PathStatus::Found : PathStatus::NotFound;
+            ReadOnlyMemory<Float3> slice(frameWaypoints, static_cast<int>(result.offset), static_cast<int>(result.count));
+            completion->TrySetResult(NavPath(status, slice));
+        }
+    }
+
+    void Navigation::CancelAll()
+    {
+        array<TaskCompletionSource<NavPath>^>^ completions;
+        Monitor::Enter(pendingLock);
+        try {
+            completions = gcnew array<TaskCompletionSource<NavPath>^>(pending->Count);
+            pending->Values->CopyTo(completions, 0);
+            pending->Clear();
+        }
+        finally { Monitor::Exit(pendingLock); }
+
+        // Outside the lock: cancelling runs continuations inline. The searches still finish
+        // and are ignored when polled.
+        for each (TaskCompletionSource<NavPath>^ completion in completions) completion->TrySetCanceled();
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "simd_math.hxx" // Float3
+
+using namespace System;
+using namespace System::Threading::Tasks;
+
+namespace ScriptAPI
+{
+    // Mirrors Core::PathStatus (without Pending, which never reaches scripts)
+    public enum class PathStatus
+    {
+        Found = 1,
+        NotFound // Unreachable, outside the grid, or no grid is set
+    };
+
+    // Result of FindPathAsync(). Waypoints are the centres of the start cell, each cell where
+    // the path turns, and the goal cell; use Waypoints.Span to walk them without copying.
+    public value struct NavPath
+    {
+    public:
+        property PathStatus Status { PathStatus get() { return status; } }
+        property ReadOnlyMemory<Float3> Waypoints { ReadOnlyMemory<Float3> get() { return waypoints; } }
+
+    internal:
+        NavPath(PathStatus status, ReadOnlyMemory<Float3> waypoints) : status(status), waypoints(waypoints) {}
+
+    private:
+        PathStatus status;
+        ReadOnlyMemory<Float3> waypoints;
+    };
+
+    // Pathfinding on the engine's navigation grid, run by Core::NavigationService on the
+    // worker threads instead of inside Update(). Requests made during a frame are searched
+    // after its scripts ran; the tasks complete on the engine thread at the start of a later
+    // frame (usually the next), so awaiting code resumes there (see Script::StartAsync).
+    // Agents asking for the same start and goal cells share one search. For example:
+    //
+    //   NavPath path = await Navigation.FindPathAsync(position, target);
+    //   if (path.Status == PathStatus.Found) route = path.Waypoints;
+    public ref class Navigation abstract sealed
+    {
+    public:
+        static Task<NavPath>^ FindPathAsync(Float3 start, Float3 goal);
+
+        // Replaces the grid: 'costs' holds width * height cells row by row (x fastest), 0 for
+        // blocked, 1 for open ground and higher for slower terrain. 'origin' is the corner of
+        // the first cell; waypoints use its Y.
+        static void SetGrid(int width, int height, float cellSize, Float3 origin, array<Byte>^ costs);
+        static property bool HasGrid { bool get(); }
+
+    internal:
+        // Completes the tasks of finished requests. Called by the engine once per frame.
+        static void DeliverCompletions();
+        // Cancels every outstanding request (before a reload).
+        static void CancelAll();
+
+    private:
+        // Requests may be made from any thread; submitting and registering happen under the
+        // lock so a completion can't be polled before its entry exists.
+        static Object^ pendingLock = gcnew Object();
+        static Collections::Generic::Dictionary<UInt64, TaskCompletionSource<NavPath>^>^ pending =
+            gcnew Collections::Generic::Dictionary<UInt64, TaskCompletionSource<NavPath>^>();
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,222 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+#using <System.Linq.Expressions.dll>
+
+#include "prefabs.hxx"
+#include "commands.hxx"
+#include "script_registry.hxx"
+#include "script_serializer.hxx"
+#include "simd_math.hxx" // Float3, Quat
+
+#include "entity_ids.h" // Core
+
+using namespace System::Globalization; // For CultureInfo
+using namespace System::IO;
+using namespace System::Linq::Expressions;
+
+namespace ScriptAPI
+{
+    int Prefabs::GetId(String^ name)
+    {
+        int id;
+        if (name == nullptr || idsByName == nullptr || !idsByName->TryGetValue(name, id)) return -1;
+        return id;
+    }
+
+    array<int>^ Prefabs::Instantiate(int prefabId, int count)
+    {
+        if (prefabId < 0 || prefabId >= Count) throw gcnew ArgumentOutOfRangeException("prefabId");
+        if (count < 0) throw gcnew ArgumentOutOfRangeException("count");
+
+        array<int>^ entityIds = gcnew array<int>(count);
+        int first = Core::EntityIds::instance().allocate(count);
+        for (int i = 0; i < count; ++i) entityIds[i] = first + i;
+        Commands::RecordInstantiate(prefabId, entityIds);
+        return entityIds;
+    }
+
+    PrefabPlan^ Prefabs::GetPlan(int prefabId)
+    {
+        if (plans == nullptr || prefabId < 0 || prefabId >= plans->Length) return nullptr;
+        return plans[prefabId];
+    }
+
+    int Prefabs::LoadFile(String^ path, String^% error)
+    {
+        List<Definition^>^ parsed = gcnew List<Definition^>();
+        if (!Parse(path, parsed, error)) return -1;
+
+        if (definitions == nullptr) {
+            definitions = gcnew List<Definition^>();
+            idsByName = gcnew Dictionary<String^, int>();
+        }
+        for each (Definition^ definition in parsed) {
+            int id;
+            if (idsByName->TryGetValue(definition->Name, id)) {
+                definitions[id] = definition;
+            }
+            else {
+                idsByName->Add(definition->Name, definitions->Count);
+                definitions->Add(definition);
+            }
+        }
+
+        if (plans != nullptr) CompileAll(); // Script types are loaded
+        return parsed->Count;
+    }
+
+    bool Prefabs::Parse(String^ path, List<Definition^>^ parsed, String^% error)
+    {
+        array<String^>^ lines;
+        try {
+            lines = File::ReadAllLines(path);
+        }
+        catch (Exception^ e) {
+            error = String::Format("Cannot read prefab file '{0}': {1}", path, e->Message);
+            return false;
+        }
+
+        Definition^ prefab = nullptr;
+        ScriptDefinition^ script = nullptr;
+        for (int i = 0; i < lines->Length; ++i) {
+            String^ line = lines[i]->Trim();
+            if (line->Length == 0 || line[0] == '#') continue;
+
+            if (line->StartsWith("prefab ")) {
+                prefab = gcnew Definition();
+                prefab->Name = line->Substring(7)->Trim();
+                prefab->Source = String::Format("{0}:{1}", path, i + 1);
+                prefab->Scripts = gcnew List<ScriptDefinition^>();
+                script = nullptr;
+                parsed->Add(prefab);
+                continue;
+            }
+            if (line->StartsWith("script ")) {
+                if (prefab == nullptr) {
+                    error = String::Format("{0}:{1}: 'script' outside of a prefab", path, i + 1);
+                    return false;
+                }
+                script = gcnew ScriptDefinition();
+                script->TypeName = line->Substring(7)->Trim();
+                script->Fields = gcnew List<KeyValuePair<String^, String^>>();
+                prefab->Scripts->Add(script);
+                continue;
+            }
+
+            int equals = line->IndexOf('=');
+            if (equals <= 0 || script == nullptr) {
+                error = String::Format("{0}:{1}: expected 'prefab <name>', 'script <type>' or '<field> = <value>'", path, i + 1);
+                return false;
+            }
+            script->Fields->Add(KeyValuePair<String^, String^>(line->Substring(0, equals)->Trim(), line->Substring(equals + 1)->Trim()));
+        }
+        return true;
+    }
+
+    Object^ Prefabs::ParseValue(Type^ fieldType, String^ text)
+    {
+        CultureInfo^ invariant = CultureInfo::InvariantCulture;
+        if (fieldType == Boolean::typeid) return Boolean::Parse(text);
+        if (fieldType == Int32::typeid) return Int32::Parse(text, invariant);
+        if (fieldType == Int64::typeid) return Int64::Parse(text, invariant);
+        if (fieldType == Single::typeid) return Single::Parse(text, invariant);
+        if (fieldType == Double::typeid) return Double::Parse(text, invariant);
+        if (fieldType == String::typeid) {
+            if (text->Length < 2 || text[0] != '"' || text[text->Length - 1] != '"') return text;
+            return text->Substring(1, text->Length - 2)->Replace("\\\"", "\"")->Replace("\\\\", "\\");
+        }
+
+        array<String^>^ parts = text->Split(',');
+        if (fieldType == Float3::typeid && parts->Length == 3) {
+            return Float3(Single::Parse(parts[0], invariant), Single::Parse(parts[1], invariant), Single::Parse(parts[2], invariant));
+        }
+        if (fieldType == Quat::typeid && parts->Length == 4) {
+            return Quat(Single::Parse(parts[0], invariant), Single::Parse(parts[1], invariant),
+                        Single::Parse(parts[2], invariant), Single::Parse(parts[3], invariant));
+        }
+        throw gcnew FormatException(String::Format("'{0}' is not a valid {1}", text, fieldType->Name));
+    }
+
+    Action<Script^>^ Prefabs::CompileSetter(Type^ type, ScriptDefinition^ script, String^ source)
+    {
+        if (script->Fields->Count == 0) return nullptr;
+
+        // script => { var typed = (T)script; typed.a = <constant>; typed.b = <constant>; ... }
+        ParameterExpression^ parameter = Expression::Parameter(Script::typeid, "script");
+        ParameterExpression^ typed = Expression::Variable(type, "typed");
+        List<Expression^>^ body = gcnew List<Expression^>();
+        body->Add(Expression::Assign(typed, Expression::Convert(parameter, type)));
+
+        array<FieldInfo^>^ fields = ScriptSerializer::GetFields(type);
+        for each (KeyValuePair<String^, String^> entry in script->Fields) {
+            FieldInfo^ field = nullptr;
+            for each (FieldInfo^ candidate in fields) {
+                if (candidate->Name == entry.Key) { field = candidate; break; }
+            }
+            if (field == nullptr) {
+                Console::WriteLine(String::Format("[ScriptAPI] Warning: {0}: {1} has no settable field '{2}'; ignored.", source, type->FullName, entry.Key));
+                continue;
+            }
+
+            Object^ value;
+            try { value = ParseValue(field->FieldType, entry.Value); }
+            catch (Exception^ e) {
+                Console::WriteLine(String::Format("[ScriptAPI] Warning: {0}: {1}.{2}: {3}; ignored.", source, type->FullName, entry.Key, e->Message));
+                continue;
+            }
+            body->Add(Expression::Assign(Expression::Field(typed, field), Expression::Constant(value, field->FieldType)));
+        }
+        if (body->Count == 1) return nullptr;
+
+        Expression^ block = Expression::Block(gcnew array<ParameterExpression^>{ typed }, body);
+        return Expression::Lambda<Action<Script^>^>(block, gcnew array<ParameterExpression^>{ parameter })->Compile();
+    }
+
+    PrefabPlan^ Prefabs::Compile(Definition^ definition)
+    {
+        int scriptCount = definition->Scripts->Count;
+        PrefabPlan^ plan = gcnew PrefabPlan();
+        plan->Name = definition->Name;
+        plan->TypeIds = gcnew array<int>(scriptCount);
+        plan->Setters = gcnew array<Action<Script^>^>(scriptCount);
+
+        for (int i = 0; i < scriptCount; ++i) {
+            ScriptDefinition^ script = definition->Scripts[i];
+            int typeId = ScriptTypes::GetTypeId(script->TypeName);
+            if (typeId < 0) {
+                Console::WriteLine(String::Format("[ScriptAPI] Warning: Prefab '{0}' ({1}) uses unknown script type '{2}' and can't be instantiated.",
+                    definition->Name, definition->Source, script->TypeName));
+                return nullptr;
+            }
+            plan->TypeIds[i] = typeId;
+            plan->Setters[i] = CompileSetter(ScriptTypes::GetScriptType(typeId), script, definition->Source);
+        }
+        plan->IndexLayout = EntityScriptIndex::CreateLayout(plan->TypeIds, ScriptTypes::Count);
+        return plan;
+    }
+
+    void Prefabs::CompileAll()
+    {
+        int count = Count;
+        plans = gcnew array<PrefabPlan^>(count);
+        int compiled = 0;
+        for (int id = 0; id < count; ++id) {
+            plans[id] = Compile(definitions[id]);
+            if (plans[id] != nullptr) ++compiled;
+        }
+        if (count > 0) Console::WriteLine(String::Format("[ScriptAPI] Compiled {0} of {1} prefab(s).", compiled, count));
+    }
+
+    void Prefabs::OnScriptTypesLoaded()
+    {
+        CompileAll();
+    }
+
+    void Prefabs::OnScriptTypesUnloaded()
+    {
+        plans = nullptr; // Setters and layouts belong to the unloading types
+    }
+
+} // namespace ScriptAPI
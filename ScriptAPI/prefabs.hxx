@@ -0,0 +1,87 @@
+#pragma once
+
+#include "script.hxx"
+#include "entity_scripts.hxx"
+
+using namespace System;
+using namespace System::Reflection;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // A prefab compiled against the loaded script types: what Instantiate() needs to clone
+    // it without looking anything up. Rebuilt on every script load.
+    ref class PrefabPlan sealed
+    {
+    internal:
+        String^ Name;
+        array<int>^ TypeIds;               // Scripts in file order
+        array<Action<Script^>^>^ Setters;  // Generated per script; nullptr if no fields are set
+        EntityScriptIndex^ IndexLayout;    // Copied into each instance's EntityScriptIndex
+    };
+
+    // Pre-configured entities: a set of scripts plus initial field values, loaded from a text
+    // file and instantiated many at a time.
+    //
+    //   # comment
+    //   prefab Guard
+    //     script Game.Health
+    //       max = 100
+    //     script Game.Patrol
+    //       speed = 2.5
+    //       start = 1, 0, -3        (Float3; Quat takes four values)
+    //       title = "Night watch"
+    //
+    // Settable fields are the ones world snapshots save (see ScriptSerializer). Definitions
+    // are kept as text; each script load compiles them into PrefabPlans with one generated
+    // setter per script, so instantiating runs constructors and plain field stores only.
+    public ref class Prefabs abstract sealed
+    {
+    public:
+        // Prefab id by name, -1 if unknown. Ids stay valid while the process runs.
+        static int GetId(String^ name);
+
+        // Reserves 'count' entity ids now; the entities are created with all of the
+        // prefab's scripts when commands are flushed, and start like any added script.
+        static array<int>^ Instantiate(int prefabId, int count);
+
+        static property int Count { int get() { return definitions == nullptr ? 0 : definitions->Count; } }
+
+    internal:
+        // Adds the file's prefabs, replacing any of the same name. Returns the number
+        // loaded, or -1 with 'error' set if the file can't be read or parsed.
+        static int LoadFile(String^ path, String^% error);
+
+        static void OnScriptTypesLoaded();
+        static void OnScriptTypesUnloaded();
+
+        // nullptr if the id is unknown or the prefab failed to compile.
+        static PrefabPlan^ GetPlan(int prefabId);
+
+    private:
+        ref class ScriptDefinition sealed
+        {
+        internal:
+            String^ TypeName;
+            List<KeyValuePair<String^, String^>>^ Fields; // Name, value text
+        };
+
+        ref class Definition sealed
+        {
+        internal:
+            String^ Name;
+            String^ Source; // "file:line" for messages
+            List<ScriptDefinition^>^ Scripts;
+        };
+
+        static bool Parse(String^ path, List<Definition^>^ parsed, String^% error);
+        static PrefabPlan^ Compile(Definition^ definition);
+        static Action<Script^>^ CompileSetter(Type^ type, ScriptDefinition^ script, String^ source);
+        static Object^ ParseValue(Type^ fieldType, String^ text);
+        static void CompileAll();
+
+        static List<Definition^>^ definitions = nullptr;
+        static Dictionary<String^, int>^ idsByName = nullptr;
+        static array<PrefabPlan^>^ plans = nullptr;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,151 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Reflection.dll>
+#using <System.Linq.Expressions.dll>
+
+#include "replication.hxx"
+#include "script_registry.hxx"
+
+#include "replication.h" // Core
+
+#include <string>
+#include <vector>
+
+using namespace System::Linq::Expressions;
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        std::string ToUtf8(String^ text)
+        {
+            array<Byte>^ bytes = Text::Encoding::UTF8->GetBytes(text);
+            if (bytes->Length == 0) return std::string();
+            pin_ptr<Byte> pinned = &bytes[0];
+            return std::string(reinterpret_cast<const char*>(pinned), bytes->Length);
+        }
+
+        bool TryGetKind(Type^ fieldType, Core::ReplicatedFieldKind& kind)
+        {
+            if (fieldType == Single::typeid || fieldType == UInt32::typeid) kind = Core::ReplicatedFieldKind::Bits;
+            else if (fieldType == Int32::typeid) kind = Core::ReplicatedFieldKind::Int;
+            else if (fieldType == Boolean::typeid) kind = Core::ReplicatedFieldKind::Bool;
+            else return false;
+            return true;
+        }
+    }
+
+    Func<Script^, UInt32>^ Replication::CompileGetter(FieldInfo^ field)
+    {
+        // (Script script) => bits of ((DeclaringType)script).field
+        ParameterExpression^ script = Expression::Parameter(Script::typeid, "script");
+        Expression^ value = Expression::Field(Expression::Convert(script, field->DeclaringType), field);
+        Expression^ bits;
+        if (field->FieldType == Single::typeid) {
+            MethodInfo^ toBits = BitConverter::typeid->GetMethod("SingleToUInt32Bits", gcnew array<Type^>{ Single::typeid });
+            bits = Expression::Call(toBits, value);
+        }
+        else if (field->FieldType == Boolean::typeid) {
+            bits = Expression::Condition(value, Expression::Constant(UInt32(1)), Expression::Constant(UInt32(0)));
+        }
+        else {
+            bits = Expression::Convert(value, UInt32::typeid); // Unchecked, so negative ints keep their bits
+        }
+        return Expression::Lambda<Func<Script^, UInt32>^>(bits, gcnew array<ParameterExpression^>{ script })->Compile();
+    }
+
+    void Replication::OnScriptTypesLoaded()
+    {
+        schemaIds = nullptr;
+        getters = nullptr;
+        if (!enabled) return;
+
+        const BindingFlags declared = BindingFlags::DeclaredOnly | BindingFlags::Instance | BindingFlags::Public | BindingFlags::NonPublic;
+        int typeCount = ScriptTypes::Count;
+        schemaIds = gcnew array<int>(typeCount);
+        getters = gcnew array<array<Func<Script^, UInt32>^>^>(typeCount);
+        int replicatedTypes = 0;
+
+        for (int typeId = 0; typeId < typeCount; ++typeId) {
+            schemaIds[typeId] = -1;
+            Type^ type = ScriptTypes::GetScriptType(typeId);
+
+            // Base class fields first, so a schema stays stable when a subclass adds fields
+            List<Type^>^ chain = gcnew List<Type^>();
+            for (Type^ t = type; t != nullptr && t != Script::typeid; t = t->BaseType) chain->Insert(0, t);
+
+            std::vector<Core::ReplicatedFieldKind> kinds;
+            List<Func<Script^, UInt32>^>^ typeGetters = gcnew List<Func<Script^, UInt32>^>();
+            for each (Type^ t in chain) {
+                // Declaration order; GetFields() doesn't promise any
+                array<FieldInfo^>^ fields = t->GetFields(declared);
+                array<int>^ tokens = gcnew array<int>(fields->Length);
+                for (int i = 0; i < fields->Length; ++i) tokens[i] = fields[i]->MetadataToken;
+                Array::Sort(tokens, fields);
+                for each (FieldInfo^ field in fields) {
+                    if (!field->IsDefined(ReplicatedAttribute::typeid, true)) continue;
+                    Core::ReplicatedFieldKind kind;
+                    if (!TryGetKind(field->FieldType, kind)) {
+                        Console::WriteLine(String::Format("[ScriptAPI] Warning: [Replicated] field {0}.{1} has unsupported type {2}; skipped.",
+                            type->FullName, field->Name, field->FieldType->Name));
+                        continue;
+                    }
+                    kinds.push_back(kind);
+                    typeGetters->Add(CompileGetter(field));
+                }
+            }
+            if (kinds.empty()) continue;
+
+            schemaIds[typeId] = Core::ReplicationServer::instance().register_schema(ToUtf8(type->FullName), kinds);
+            if (schemaIds[typeId] < 0) {
+                Console::WriteLine(String::Format("[ScriptAPI] Warning: {0} has too many [Replicated] fields ({1}) to fit a packet; not replicated.",
+                    type->FullName, static_cast<int>(kinds.size())));
+                continue;
+            }
+            getters[typeId] = typeGetters->ToArray();
+            ++replicatedTypes;
+        }
+        Console::WriteLine(String::Format("[ScriptAPI] Replicating {0} script type(s).", replicatedTypes));
+    }
+
+    void Replication::OnScriptTypesUnloaded()
+    {
+        schemaIds = nullptr;
+        getters = nullptr;
+    }
+
+    void Replication::Track(Script^ script)
+    {
+        if (schemaIds == nullptr || schemaIds[script->GetTypeId()] < 0) return;
+        script->SetReplicationId(Core::ReplicationServer::instance().add_object(script->GetEntityId(), schemaIds[script->GetTypeId()]));
+    }
+
+    void Replication::Untrack(Script^ script)
+    {
+        if (script->GetReplicationId() < 0) return;
+        Core::ReplicationServer::instance().remove_object(script->GetReplicationId());
+        script->SetReplicationId(-1);
+    }
+
+    void Replication::Gather(array<List<Script^>^>^ scriptsByType)
+    {
+        if (getters == nullptr || scriptsByType == nullptr) return;
+
+        Core::ReplicationServer& server = Core::ReplicationServer::instance();
+        for (int typeId = 0; typeId < getters->Length; ++typeId) {
+            array<Func<Script^, UInt32>^>^ fields = getters[typeId];
+            List<Script^>^ scripts = scriptsByType[typeId];
+            if (fields == nullptr || scripts == nullptr) continue;
+
+            for (int i = 0; i < scripts->Count; ++i) {
+                Script^ script = scripts[i];
+                int objectId = script->GetReplicationId();
+                for (int field = 0; field < fields->Length; ++field) {
+                    server.write(objectId, field, fields[field](script));
+                }
+            }
+        }
+    }
+
+} // namespace ScriptAPI
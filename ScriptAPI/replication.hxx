@@ -0,0 +1,44 @@
+#pragma once
+
+#include "script.hxx"
+
+using namespace System;
+using namespace System::Reflection;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // Marks a script field for replication to network clients. Supported field types are
+    // bool, int, uint and float. Values are read once per frame, after PostPhysics.
+    [AttributeUsage(AttributeTargets::Field)]
+    public ref class ReplicatedAttribute sealed : Attribute
+    {
+    };
+
+    // Connects script types with [Replicated] fields to Core::ReplicationServer.
+    // Each started script of such a type is one replicated object; Gather() copies its
+    // field values into the server, which stamps only the ones that actually changed.
+    ref class Replication abstract sealed
+    {
+    internal:
+        static property bool Enabled { bool get() { return enabled; } void set(bool value) { enabled = value; } }
+
+        // Registers a schema per script type that has replicated fields.
+        static void OnScriptTypesLoaded();
+        static void OnScriptTypesUnloaded();
+
+        // Called when a script starts and when it is removed.
+        static void Track(Script^ script);
+        static void Untrack(Script^ script);
+
+        static void Gather(array<List<Script^>^>^ scriptsByType);
+
+    private:
+        static Func<Script^, UInt32>^ CompileGetter(FieldInfo^ field);
+
+        static bool enabled = false;
+        // Indexed by script type id; -1 / nullptr for types without replicated fields
+        static array<int>^ schemaIds = nullptr;
+        static array<array<Func<Script^, UInt32>^>^>^ getters = nullptr;
+    };
+} // namespace ScriptAPI
@@ -1,8 +1,39 @@
 #include "pch.h" // Include precompiled header first
 #include "script.hxx"
+#include "entity_scripts.hxx"
+#include "script_registry.hxx"
 
 namespace ScriptAPI
 {
+    // Script type id of T, resolved once per load of the script assembly, and whether any
+    // other loaded script type derives from T.
+    generic <typename T> where T : Script
+    ref class ScriptTypeId abstract sealed
+    {
+    internal:
+        static int Get()
+        {
+            int current = ScriptTypes::Generation;
+            if (generation != current) {
+                id = ScriptTypes::GetTypeId(T::typeid); // -1 for abstract bases
+                hasSubtypes = false;
+                for (int other = 0; other < ScriptTypes::Count && !hasSubtypes; ++other) {
+                    hasSubtypes = other != id && T::typeid->IsAssignableFrom(ScriptTypes::GetScriptType(other));
+                }
+                generation = current;
+            }
+            return id;
+        }
+
+        // Valid after Get()
+        static bool HasSubtypes() { return hasSubtypes; }
+
+    private:
+        static int id = -1;
+        static bool hasSubtypes = false;
+        static int generation = -1;
+    };
+
     void Script::SetEntityId(int id)
     {
         this->entityId = id;
@@ -13,4 +44,44 @@ namespace ScriptAPI
         return this->entityId;
     }
 
-} // namespace ScriptAPI
\ No newline at end of file
+    generic <typename T> where T : Script
+    T Script::GetScript()
+    {
+        if (entityIndex == nullptr) return safe_cast<T>(nullptr);
+
+        int typeId = ScriptTypeId<T>::Get();
+        if (typeId < 0) return safe_cast<T>(entityIndex->FindAssignable(T::typeid));
+
+        // A concrete T can still be subclassed by other scripts (Boss : Enemy)
+        Script^ found = entityIndex->Find(typeId);
+        if (found == nullptr && ScriptTypeId<T>::HasSubtypes()) found = entityIndex->FindAssignable(T::typeid);
+        return safe_cast<T>(found);
+    }
+
+    generic <typename T> where T : Script
+    bool Script::TryGetScript(T% script)
+    {
+        script = GetScript<T>();
+        return script != nullptr;
+    }
+
+    // --- ScriptRef ---
+
+    generic <typename T> where T : Script
+    ScriptRef<T>::ScriptRef(T target)
+        : target(target)
+        , generation(ScriptTypes::Generation)
+    {
+    }
+
+    generic <typename T> where T : Script
+    T ScriptRef<T>::Target::get()
+    {
+        if (target == nullptr || generation != ScriptTypes::Generation ||
+            target->GetStartState() == ScriptStartState::Removed) {
+            return safe_cast<T>(nullptr);
+        }
+        return target;
+    }
+
+} // namespace ScriptAPI
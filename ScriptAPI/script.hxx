@@ -1,15 +1,51 @@
 #pragma once
 
+#using <System.Runtime.dll> // For Task
+
+using namespace System::Runtime::InteropServices; // For OutAttribute
+using namespace System::Threading::Tasks;
+
 namespace ScriptAPI
 {
+    ref class EntityScriptIndex;
+
+    // Where a script is in its start lifecycle; scripts only receive Update() once Started.
+    enum class ScriptStartState
+    {
+        Queued = 0, // Waiting for its Start() slot in the per-frame start budget
+        Awaiting,   // Start() ran; the task returned by StartAsync() is still running
+        Started,
+        Removed,    // Removed or destroyed before its start completed
+        Dormant     // Started, but its entity is asleep; see Dormancy
+    };
+
     public ref class Script abstract
     {
     public:
         virtual void Update() {};
         virtual void Start() {};
+        // Called right after Start(). Return a task to finish initialization in the
+        // background (loading data, building caches); the script receives no Update()
+        // until it completes. The engine installs no synchronization context: code after an
+        // await resumes on the thread that completed the awaited task. Streaming and
+        // Navigation tasks complete on the engine thread, so awaiting them resumes there;
+        // other tasks (Task.Run, .NET I/O) resume on the thread pool, where structural
+        // changes must go through Commands.
+        virtual Task^ StartAsync() { return nullptr; }
 
-        // Changed to protected: Accessible by derived classes (like MyFirstScript)
-    protected:
+        // Script of type T (or derived from it) on the same entity, including scripts
+        // still waiting for Start(); nullptr if there is none. An exact match is a bitmask
+        // test and an array read, so this is cheap enough to call every frame; base types
+        // and script types with subclasses fall back to a scan when that misses.
+        // To keep the result across frames, hold it in a ScriptRef<T>.
+        generic <typename T> where T : Script
+        T GetScript();
+        generic <typename T> where T : Script
+        bool TryGetScript([Out] T% script);
+
+        // Protected for derived classes (like MyFirstScript); public within this assembly
+        // so EngineInterface can read it when snapshotting
+    public protected:
         // Returns the entity ID associated with this script instance
         int GetEntityId();
 
@@ -17,8 +53,44 @@ namespace ScriptAPI
         // (EngineInterface will call this)
     internal:
         void SetEntityId(int id);
+        // Dense id from ScriptTypes, valid until the next reload
+        int GetTypeId() { return typeId; }
+        void SetTypeId(int id) { typeId = id; }
+
+        ScriptStartState GetStartState() { return startState; }
+        void SetStartState(ScriptStartState state) { startState = state; }
+        // Set while Awaiting
+        Task^ GetStartTask() { return startTask; }
+        void SetStartTask(Task^ task) { startTask = task; }
+        // Index of the entity's scripts; nullptr once removed
+        EntityScriptIndex^ GetEntityIndex() { return entityIndex; }
+        void SetEntityIndex(EntityScriptIndex^ index) { entityIndex = index; }
+        // Object id in Core::ReplicationServer; -1 if not replicated
+        int GetReplicationId() { return replicationId; }
+        void SetReplicationId(int id) { replicationId = id; }
 
     private:
         int entityId = -1;
+        int typeId = -1;
+        int replicationId = -1;
+        ScriptStartState startState;
+        Task^ startTask;
+        EntityScriptIndex^ entityIndex;
+    };
+
+    // Reference to another script that goes null when that script is removed, its entity
+    // is destroyed or the scripts are reloaded, instead of keeping a dead script alive.
+    generic <typename T> where T : Script
+    public value struct ScriptRef
+    {
+    public:
+        ScriptRef(T target);
+
+        property T Target { T get(); }
+        property bool IsValid { bool get() { return Target != nullptr; } }
+
+    private:
+        T target;
+        int generation; // ScriptTypes::Generation when the reference was taken
     };
-} // namespace ScriptAPI
\ No newline at end of file
+} // namespace ScriptAPI
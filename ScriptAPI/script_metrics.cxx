@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+
+#include "script_metrics.hxx"
+#include "script_registry.hxx"
+
+#include "metrics.h" // Core
+#include <string>
+
+using namespace System::Diagnostics; // For Stopwatch
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        std::string ToUtf8(String^ text)
+        {
+            array<Byte>^ bytes = Text::Encoding::UTF8->GetBytes(text);
+            if (bytes->Length == 0) return std::string();
+            pin_ptr<Byte> pinned = &bytes[0];
+            return std::string(reinterpret_cast<const char*>(pinned), bytes->Length);
+        }
+
+        std::string TypeLabel(int typeId)
+        {
+            return Core::MetricsRegistry::label("script_type", ToUtf8(ScriptTypes::GetTypeName(typeId)));
+        }
+    }
+
+    void ScriptMetrics::OnScriptTypesLoaded()
+    {
+        OnScriptTypesUnloaded();
+
+        Core::MetricsRegistry& registry = Core::MetricsRegistry::instance();
+        typeCount = ScriptTypes::Count;
+        scriptCounts = new Core::Gauge*[typeCount];
+        updateSeconds = new Core::Counter*[typeCount];
+        exceptions = new Core::Counter*[typeCount];
+        for (int id = 0; id < typeCount; ++id)
+        {
+            std::string labels = TypeLabel(id);
+            scriptCounts[id] = &registry.gauge("engine_scripts", "Live script instances by type", labels);
+            updateSeconds[id] = &registry.counter("engine_script_update_seconds_total", "Time spent in Update() by script type", labels);
+            exceptions[id] = &registry.counter("engine_script_exceptions_total", "Exceptions thrown by scripts, by type", labels);
+            scriptCounts[id]->set(0.0);
+        }
+    }
+
+    void ScriptMetrics::OnScriptTypesUnloaded()
+    {
+        for (int id = 0; id < typeCount; ++id) scriptCounts[id]->set(0.0);
+        delete[] scriptCounts;
+        delete[] updateSeconds;
+        delete[] exceptions;
+        scriptCounts = nullptr;
+        updateSeconds = nullptr;
+        exceptions = nullptr;
+        typeCount = 0;
+    }
+
+    void ScriptMetrics::SetScriptCount(int typeId, int count)
+    {
+        if (typeId >= 0 && typeId < typeCount) scriptCounts[typeId]->set(count);
+    }
+
+    void ScriptMetrics::AddUpdateTime(int typeId, long long stopwatchTicks)
+    {
+        if (typeId >= 0 && typeId < typeCount) updateSeconds[typeId]->add(static_cast<double>(stopwatchTicks) / Stopwatch::Frequency);
+    }
+
+    void ScriptMetrics::AddException(int typeId)
+    {
+        if (typeId >= 0 && typeId < typeCount) exceptions[typeId]->add();
+    }
+
+    void ScriptMetrics::SampleRuntime()
+    {
+        static Core::Counter* gcPauseSeconds = &Core::MetricsRegistry::instance().counter(
+            "dotnet_gc_pause_seconds_total", "Time the runtime was paused for garbage collection");
+
+        long long pauseTicks = GC::GetTotalPauseDuration().Ticks;
+        gcPauseSeconds->add(static_cast<double>(pauseTicks - lastGcPauseTicks) / TimeSpan::TicksPerSecond);
+        lastGcPauseTicks = pauseTicks;
+
+        for (int gen = 0; gen < lastCollections->Length; ++gen)
+        {
+            static Core::Counter* collections[3] = {};
+            if (collections[gen] == nullptr)
+            {
+                collections[gen] = &Core::MetricsRegistry::instance().counter(
+                    "dotnet_gc_collections_total", "Garbage collections by generation",
+                    Core::MetricsRegistry::label("generation", std::to_string(gen)));
+            }
+            int count = GC::CollectionCount(gen);
+            collections[gen]->add(count - lastCollections[gen]);
+            lastCollections[gen] = count;
+        }
+    }
+
+    void ScriptMetrics::RecordReload(double seconds, bool succeeded)
+    {
+        static Core::Counter* reloads = &Core::MetricsRegistry::instance().counter(
+            "engine_script_reloads_total", "Script assembly reloads", "result=\"ok\"");
+        static Core::Counter* failedReloads = &Core::MetricsRegistry::instance().counter(
+            "engine_script_reloads_total", "Script assembly reloads", "result=\"failed\"");
+        static Core::Histogram* duration = &Core::MetricsRegistry::instance().histogram(
+            "engine_script_reload_seconds", "Script assembly reload duration",
+            Core::Histogram::exponential_bounds(0.01, 2.0, 10));
+
+        (succeeded ? reloads : failedReloads)->add();
+        duration->observe(seconds);
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,41 @@
+#pragma once
+
+using namespace System;
+
+namespace Core
+{
+    class Counter;
+    class Gauge;
+    class Histogram;
+}
+
+namespace ScriptAPI
+{
+    // Script-side metrics published to Core::MetricsRegistry: script count, update time and
+    // exceptions per script type, GC pauses and reloads. Per-type metrics are resolved
+    // once per load into arrays indexed by type id, so recording is a pointer lookup and
+    // a relaxed atomic update.
+    ref class ScriptMetrics abstract sealed
+    {
+    internal:
+        static void OnScriptTypesLoaded();
+        // Zeroes the script counts of the outgoing types and drops the per-type arrays.
+        static void OnScriptTypesUnloaded();
+
+        static void SetScriptCount(int typeId, int count);
+        static void AddUpdateTime(int typeId, long long stopwatchTicks);
+        static void AddException(int typeId);
+        // Publishes GC pause and collection deltas; called once per frame.
+        static void SampleRuntime();
+        static void RecordReload(double seconds, bool succeeded);
+
+    private:
+        static int typeCount = 0;
+        static Core::Gauge** scriptCounts = nullptr;
+        static Core::Counter** updateSeconds = nullptr;
+        static Core::Counter** exceptions = nullptr;
+
+        static long long lastGcPauseTicks = 0;
+        static array<int>^ lastCollections = gcnew array<int>(3);
+    };
+} // namespace ScriptAPI
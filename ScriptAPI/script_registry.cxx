@@ -0,0 +1,155 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Reflection.dll>
+#using <System.Collections.dll>
+
+#include "script_registry.hxx"
+
+namespace ScriptAPI
+{
+    // Fallback factory for assemblies built without the registry generator
+    ref class ReflectionFactory sealed
+    {
+    public:
+        ReflectionFactory(Type^ type) : type(type) {}
+        Script^ Create() { return safe_cast<Script^>(Activator::CreateInstance(type)); }
+
+        // Same id order as the generator
+        static int CompareByName(Type^ a, Type^ b) { return String::CompareOrdinal(a->FullName, b->FullName); }
+
+    private:
+        Type^ type;
+    };
+
+    bool ScriptTypes::Load(Assembly^ assembly)
+    {
+        Clear();
+        if (assembly == nullptr) return false;
+
+        List<String^>^ names = gcnew List<String^>();
+        List<Type^>^ scriptTypes = gcnew List<Type^>();
+        List<Func<Script^>^>^ creators = gcnew List<Func<Script^>^>();
+
+        ScriptRegistryAttribute^ attribute = safe_cast<ScriptRegistryAttribute^>(
+            Attribute::GetCustomAttribute(assembly, ScriptRegistryAttribute::typeid));
+        if (attribute != nullptr)
+        {
+            registry = safe_cast<IScriptRegistry^>(Activator::CreateInstance(attribute->RegistryType));
+            names->AddRange(registry->TypeNames);
+            scriptTypes->AddRange(registry->Types);
+            creators->AddRange(registry->Factories);
+            if (names->Count != creators->Count || names->Count != scriptTypes->Count)
+            {
+                Console::Error->WriteLine("[ScriptAPI] Error: Generated script registry is inconsistent.");
+                return false;
+            }
+            Console::WriteLine(String::Format("[ScriptAPI] Using generated script registry ({0} types).", names->Count));
+        }
+        else
+        {
+            Console::WriteLine("[ScriptAPI] No generated script registry found; scanning exported types.");
+            if (!LoadByReflection(assembly, names, scriptTypes, creators)) return false;
+        }
+
+        typeNames = names->ToArray();
+        types = scriptTypes->ToArray();
+        factories = creators->ToArray();
+        idsByName = gcnew Dictionary<String^, int>(typeNames->Length * 2, StringComparer::Ordinal);
+        idsByType = gcnew Dictionary<Type^, int>(types->Length);
+
+        List<String^>^ ambiguous = gcnew List<String^>();
+        HashSet<String^>^ shortNames = gcnew HashSet<String^>(StringComparer::Ordinal);
+        for (int id = 0; id < typeNames->Length; ++id)
+        {
+            String^ fullName = typeNames[id];
+            idsByName[fullName] = id;
+            idsByType[types[id]] = id;
+            Console::WriteLine(String::Format("[ScriptAPI]   Script type {0}: {1}", id, fullName));
+        }
+        for (int id = 0; id < typeNames->Length; ++id)
+        {
+            // Short name = text after the last namespace or nesting separator
+            String^ fullName = typeNames[id];
+            String^ shortName = fullName->Substring(System::Math::Max(fullName->LastIndexOf('.'), fullName->LastIndexOf('+')) + 1);
+            if (shortName == fullName || ambiguous->Contains(shortName)) continue;
+            if (idsByName->ContainsKey(shortName))
+            {
+                // Two types share the short name: require the full one. A global-namespace
+                // type whose full name is this short name keeps its entry.
+                if (shortNames->Remove(shortName)) idsByName->Remove(shortName);
+                ambiguous->Add(shortName);
+                continue;
+            }
+            idsByName->Add(shortName, id);
+            shortNames->Add(shortName);
+        }
+        return true;
+    }
+
+    bool ScriptTypes::LoadByReflection(Assembly^ assembly, List<String^>^ names, List<Type^>^ scriptTypes,
+                                       List<Func<Script^>^>^ creators)
+    {
+        try
+        {
+            List<Type^>^ types = gcnew List<Type^>();
+            for each (Type^ type in assembly->GetExportedTypes())
+            {
+                // Same filter as the generator: concrete, non-generic (nor nested in a generic
+                // type) and creatable through a public parameterless constructor
+                if (!type->IsSubclassOf(Script::typeid) || type->IsAbstract || type->ContainsGenericParameters) continue;
+                if (type->GetConstructor(Type::EmptyTypes) == nullptr) continue;
+                types->Add(type);
+            }
+            types->Sort(gcnew Comparison<Type^>(&ReflectionFactory::CompareByName));
+
+            for each (Type^ type in types)
+            {
+                names->Add(type->FullName);
+                scriptTypes->Add(type);
+                creators->Add(gcnew Func<Script^>(gcnew ReflectionFactory(type), &ReflectionFactory::Create));
+            }
+            return true;
+        }
+        catch (Exception^ e)
+        {
+            Console::Error->WriteLine(String::Format("[ScriptAPI] Exception during script discovery: {0}", e->Message));
+            return false;
+        }
+    }
+
+    void ScriptTypes::Clear()
+    {
+        // These reference types and delegates from the script assembly; drop them so the
+        // load context can unload.
+        registry = nullptr;
+        typeNames = nullptr;
+        types = nullptr;
+        factories = nullptr;
+        idsByName = nullptr;
+        idsByType = nullptr;
+        ++generation;
+    }
+
+    int ScriptTypes::GetTypeId(String^ name)
+    {
+        int id;
+        if (idsByName == nullptr || name == nullptr) return -1;
+        return idsByName->TryGetValue(name->Trim(), id) ? id : -1;
+    }
+
+    int ScriptTypes::GetTypeId(Type^ type)
+    {
+        int id;
+        if (idsByType == nullptr || type == nullptr) return -1;
+        return idsByType->TryGetValue(type, id) ? id : -1;
+    }
+
+    Script^ ScriptTypes::Create(int typeId)
+    {
+        Script^ script = factories[typeId]();
+        script->SetTypeId(typeId);
+        return script;
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "script.hxx"
+#include "components.hxx" // ComponentSystemBase
+
+using namespace System;
+using namespace System::Reflection;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // Implemented by the registry that the ScriptGenerators source generator emits into
+    // every script assembly. Index i of both arrays describes script type id i.
+    public interface class IScriptRegistry
+    {
+        // Type::FullName of each script, sorted ordinally
+        property array<String^>^ TypeNames { array<String^>^ get(); }
+        property array<Type^>^ Types { array<Type^>^ get(); }
+        // Direct constructor calls, no reflection
+        property array<Func<Script^>^>^ Factories { array<Func<Script^>^>^ get(); }
+    };
+
+    // Component systems of the script assembly, emitted by the same generator into the same
+    // class. Index i of every array describes one system; they are sorted by full type name.
+    public interface class IComponentSystemRegistry
+    {
+        property array<String^>^ SystemNames { array<String^>^ get(); }
+        // ScriptPhase of each system, from its [ExecutionPhase] (Update if it has none)
+        property array<int>^ SystemPhases { array<int>^ get(); }
+        property array<Func<ComponentSystemBase^>^>^ SystemFactories { array<Func<ComponentSystemBase^>^>^ get(); }
+    };
+
+    // Points the ScriptAPI at the generated registry of a script assembly.
+    [AttributeUsage(AttributeTargets::Assembly)]
+    public ref class ScriptRegistryAttribute sealed : Attribute
+    {
+    public:
+        ScriptRegistryAttribute(Type^ registryType) : registryType(registryType) {}
+
+        property Type^ RegistryType { Type^ get() { return registryType; } }
+
+    private:
+        Type^ registryType;
+    };
+
+    // Script types of the loaded script assembly, addressed by dense integer id.
+    // Ids are assigned at load and stay valid until the next reload; names are only hashed
+    // when an id is resolved, after that creating a script is an array index.
+    ref class ScriptTypes abstract sealed
+    {
+    internal:
+        // Uses the assembly's generated registry, or scans its exported types if it was
+        // built without the generator.
+        static bool Load(Assembly^ assembly);
+        static void Clear();
+
+        static property int Count { int get() { return typeNames != nullptr ? typeNames->Length : 0; } }
+        // The generated registry of the loaded assembly; nullptr if it was scanned instead.
+        static property IScriptRegistry^ Registry { IScriptRegistry^ get() { return registry; } }
+        // Changes whenever the type table is cleared, i.e. on every load and unload.
+        // Anything caching type ids or scripts compares against it.
+        static property int Generation { int get() { return generation; } }
+        static bool IsValid(int typeId) { return typeId >= 0 && typeId < Count; }
+
+        // Accepts the full name or, if unambiguous, the short name. -1 if unknown.
+        static int GetTypeId(String^ name);
+        static int GetTypeId(Type^ type);
+        static String^ GetTypeName(int typeId) { return typeNames[typeId]; }
+        static Type^ GetScriptType(int typeId) { return types[typeId]; }
+        // Runs the script's constructor; the returned script has its type id set.
+        static Script^ Create(int typeId);
+
+    private:
+        static bool LoadByReflection(Assembly^ assembly, List<String^>^ names, List<Type^>^ scriptTypes,
+                                     List<Func<Script^>^>^ factories);
+
+        static IScriptRegistry^ registry = nullptr;
+        static array<String^>^ typeNames = nullptr;
+        static array<Type^>^ types = nullptr;
+        static array<Func<Script^>^>^ factories = nullptr;
+        static Dictionary<String^, int>^ idsByName = nullptr;
+        static Dictionary<Type^, int>^ idsByType = nullptr;
+        static int generation = 0;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,168 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.IO.UnmanagedMemoryStream.dll>
+
+#include "script_serializer.hxx"
+#include "simd_math.hxx" // Float3, Quat
+
+using namespace System::Text;
+
+namespace ScriptAPI
+{
+    bool ScriptSerializer::TryGetTag(Type^ fieldType, FieldTag% tag)
+    {
+        if (fieldType == Boolean::typeid) { tag = FieldTag::Bool; return true; }
+        if (fieldType == Int32::typeid) { tag = FieldTag::Int32; return true; }
+        if (fieldType == Int64::typeid) { tag = FieldTag::Int64; return true; }
+        if (fieldType == Single::typeid) { tag = FieldTag::Float; return true; }
+        if (fieldType == Double::typeid) { tag = FieldTag::Double; return true; }
+        if (fieldType == String::typeid) { tag = FieldTag::String; return true; }
+        if (fieldType == Float3::typeid) { tag = FieldTag::Float3; return true; }
+        if (fieldType == Quat::typeid) { tag = FieldTag::Quat; return true; }
+        return false;
+    }
+
+    array<FieldInfo^>^ ScriptSerializer::GetFields(Type^ type)
+    {
+        if (fieldCache == nullptr) fieldCache = gcnew Dictionary<Type^, array<FieldInfo^>^>();
+
+        array<FieldInfo^>^ fields;
+        if (fieldCache->TryGetValue(type, fields)) return fields;
+
+        List<FieldInfo^>^ selected = gcnew List<FieldInfo^>();
+        BindingFlags flags = BindingFlags::Instance | BindingFlags::Public | BindingFlags::NonPublic;
+        for (Type^ t = type; t != nullptr && t != Script::typeid; t = t->BaseType)
+        {
+            for each (FieldInfo^ field in t->GetFields(flags | BindingFlags::DeclaredOnly))
+            {
+                if (field->IsInitOnly || field->IsDefined(NonSerializedAttribute::typeid, false)) continue;
+                if (!field->IsPublic && !field->IsDefined(SerializeFieldAttribute::typeid, false)) continue;
+
+                FieldTag tag;
+                if (TryGetTag(field->FieldType, tag)) selected->Add(field);
+            }
+        }
+
+        fields = selected->ToArray();
+        fieldCache->Add(type, fields);
+        return fields;
+    }
+
+    void ScriptSerializer::ClearCache()
+    {
+        if (fieldCache != nullptr) fieldCache->Clear();
+    }
+
+    void ScriptSerializer::WriteValue(BinaryWriter^ writer, FieldTag tag, Object^ value)
+    {
+        switch (tag)
+        {
+        case FieldTag::Bool: writer->Write(safe_cast<bool>(value)); break;
+        case FieldTag::Int32: writer->Write(safe_cast<int>(value)); break;
+        case FieldTag::Int64: writer->Write(safe_cast<long long>(value)); break;
+        case FieldTag::Float: writer->Write(safe_cast<float>(value)); break;
+        case FieldTag::Double: writer->Write(safe_cast<double>(value)); break;
+        case FieldTag::String:
+        {
+            String^ s = safe_cast<String^>(value);
+            writer->Write(s != nullptr);
+            if (s != nullptr) writer->Write(s);
+            break;
+        }
+        case FieldTag::Float3:
+        {
+            Float3 v = safe_cast<Float3>(value);
+            writer->Write(v.X); writer->Write(v.Y); writer->Write(v.Z);
+            break;
+        }
+        case FieldTag::Quat:
+        {
+            Quat q = safe_cast<Quat>(value);
+            writer->Write(q.X); writer->Write(q.Y); writer->Write(q.Z); writer->Write(q.W);
+            break;
+        }
+        }
+    }
+
+    Object^ ScriptSerializer::ReadValue(BinaryReader^ reader, FieldTag tag)
+    {
+        switch (tag)
+        {
+        case FieldTag::Bool: return reader->ReadBoolean();
+        case FieldTag::Int32: return reader->ReadInt32();
+        case FieldTag::Int64: return reader->ReadInt64();
+        case FieldTag::Float: return reader->ReadSingle();
+        case FieldTag::Double: return reader->ReadDouble();
+        case FieldTag::String: return reader->ReadBoolean() ? reader->ReadString() : nullptr;
+        case FieldTag::Float3:
+        {
+            float x = reader->ReadSingle(), y = reader->ReadSingle(), z = reader->ReadSingle();
+            return Float3(x, y, z);
+        }
+        case FieldTag::Quat:
+        {
+            float x = reader->ReadSingle(), y = reader->ReadSingle(), z = reader->ReadSingle(), w = reader->ReadSingle();
+            return Quat(x, y, z, w);
+        }
+        default:
+            throw gcnew InvalidDataException(String::Format("Unknown field tag {0}", static_cast<int>(tag)));
+        }
+    }
+
+    array<Byte>^ ScriptSerializer::Serialize(Script^ script, int% length)
+    {
+        if (buffer == nullptr) buffer = gcnew MemoryStream();
+        buffer->SetLength(0);
+
+        array<FieldInfo^>^ fields = GetFields(script->GetType());
+        BinaryWriter^ writer = gcnew BinaryWriter(buffer, Encoding::UTF8, true);
+        writer->Write(static_cast<UInt16>(fields->Length));
+        for each (FieldInfo^ field in fields)
+        {
+            FieldTag tag;
+            TryGetTag(field->FieldType, tag);
+            writer->Write(field->Name);
+            writer->Write(static_cast<Byte>(tag));
+            WriteValue(writer, tag, field->GetValue(script));
+        }
+        writer->Flush();
+
+        length = static_cast<int>(buffer->Length);
+        return buffer->GetBuffer();
+    }
+
+    void ScriptSerializer::Deserialize(Script^ script, const unsigned char* data, int length)
+    {
+        if (data == nullptr || length <= 0) return;
+
+        array<FieldInfo^>^ fields = GetFields(script->GetType());
+        UnmanagedMemoryStream^ stream = gcnew UnmanagedMemoryStream(const_cast<unsigned char*>(data), length);
+        BinaryReader^ reader = gcnew BinaryReader(stream, Encoding::UTF8);
+        try
+        {
+            int count = reader->ReadUInt16();
+            for (int i = 0; i < count; ++i)
+            {
+                String^ name = reader->ReadString();
+                FieldTag tag = static_cast<FieldTag>(reader->ReadByte());
+                Object^ value = ReadValue(reader, tag);
+
+                for each (FieldInfo^ field in fields)
+                {
+                    FieldTag fieldTag;
+                    if (field->Name == name && TryGetTag(field->FieldType, fieldTag) && fieldTag == tag)
+                    {
+                        field->SetValue(script, value);
+                        break;
+                    }
+                }
+            }
+        }
+        finally
+        {
+            reader->Close();
+        }
+    }
+
+} // namespace ScriptAPI
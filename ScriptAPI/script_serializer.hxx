@@ -0,0 +1,54 @@
+#pragma once
+
+#include "script.hxx"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Reflection;
+using namespace System::Collections::Generic;
+
+namespace ScriptAPI
+{
+    // Marks a non-public script field for inclusion in world snapshots.
+    // Public fields are included unless marked [NonSerialized].
+    [AttributeUsage(AttributeTargets::Field)]
+    public ref class SerializeFieldAttribute sealed : Attribute
+    {
+    };
+
+    // Converts script fields to and from the field blob stored in world snapshots.
+    // Blob layout: uint16 count, then per field a length-prefixed UTF-8 name, a type tag
+    // and the value. Fields are matched by name and tag on load, so scripts can add,
+    // remove or reorder fields without breaking older snapshots.
+    ref class ScriptSerializer abstract sealed
+    {
+    internal:
+        // Serializes into a shared buffer; the returned array is valid until the next call.
+        static array<Byte>^ Serialize(Script^ script, [Runtime::InteropServices::Out] int% length);
+        static void Deserialize(Script^ script, const unsigned char* data, int length);
+        // Drops cached field lists (they reference types from the unloaded assembly).
+        static void ClearCache();
+        // Writable public or [SerializeField] fields of a supported type, base classes included.
+        static array<FieldInfo^>^ GetFields(Type^ type);
+
+    private:
+        enum class FieldTag : Byte
+        {
+            Bool = 1,
+            Int32 = 2,
+            Int64 = 3,
+            Float = 4,
+            Double = 5,
+            String = 6,
+            Float3 = 7,
+            Quat = 8
+        };
+
+        static bool TryGetTag(Type^ fieldType, FieldTag% tag);
+        static void WriteValue(BinaryWriter^ writer, FieldTag tag, Object^ value);
+        static Object^ ReadValue(BinaryReader^ reader, FieldTag tag);
+
+        static Dictionary<Type^, array<FieldInfo^>^>^ fieldCache = nullptr;
+        static MemoryStream^ buffer = nullptr;
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "simd_math.hxx"
+
+#include "simd_math.h" // Core
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        void CheckStream(Float3SoA^ stream, int count, String^ name)
+        {
+            if (stream == nullptr) throw gcnew ArgumentNullException(name);
+            if (count < 0 || count > stream->Capacity) throw gcnew ArgumentOutOfRangeException("count", "count exceeds the capacity of " + name);
+        }
+
+        void CheckStream(QuatSoA^ stream, int count, String^ name)
+        {
+            if (stream == nullptr) throw gcnew ArgumentNullException(name);
+            if (count < 0 || count > stream->Capacity) throw gcnew ArgumentOutOfRangeException("count", "count exceeds the capacity of " + name);
+        }
+
+        Core::Math::float3 ToNative(Float3 v) { return { v.X, v.Y, v.Z }; }
+        Float3 FromNative(Core::Math::float3 v) { return Float3(v.x, v.y, v.z); }
+        Core::Math::quat ToNative(Quat q) { return { q.X, q.Y, q.Z, q.W }; }
+        Quat FromNative(Core::Math::quat q) { return Quat(q.x, q.y, q.z, q.w); }
+    }
+
+    Quat Quat::FromAxisAngle(Float3 axis, float radians)
+    {
+        return FromNative(Core::Math::quat_from_axis_angle(ToNative(axis), radians));
+    }
+
+    Quat Quat::LookRotation(Float3 forward)
+    {
+        return FromNative(Core::Math::look_rotation(ToNative(forward)));
+    }
+
+    Float4x4 Float4x4::Identity::get()
+    {
+        Float4x4 m;
+        m.C0 = Float4(1.0f, 0.0f, 0.0f, 0.0f);
+        m.C1 = Float4(0.0f, 1.0f, 0.0f, 0.0f);
+        m.C2 = Float4(0.0f, 0.0f, 1.0f, 0.0f);
+        m.C3 = Float4(0.0f, 0.0f, 0.0f, 1.0f);
+        return m;
+    }
+
+    Float4x4 Float4x4::TRS(Float3 translation, Quat rotation, Float3 scale)
+    {
+        Core::Math::float4x4 native = Core::Math::trs(ToNative(translation), ToNative(rotation), ToNative(scale));
+        return *reinterpret_cast<Float4x4*>(&native);
+    }
+
+    Float4x4 Float4x4::operator*(Float4x4 a, Float4x4 b)
+    {
+        Float4x4 r;
+        r.C0 = Mul(a, b.C0);
+        r.C1 = Mul(a, b.C1);
+        r.C2 = Mul(a, b.C2);
+        r.C3 = Mul(a, b.C3);
+        return r;
+    }
+
+    Float3SoA::Float3SoA(int capacity)
+    {
+        x = gcnew array<float>(capacity);
+        y = gcnew array<float>(capacity);
+        z = gcnew array<float>(capacity);
+    }
+
+    QuatSoA::QuatSoA(int capacity)
+    {
+        x = gcnew array<float>(capacity);
+        y = gcnew array<float>(capacity);
+        z = gcnew array<float>(capacity);
+        w = gcnew array<float>(capacity);
+    }
+
+    void MathKernels::IntegratePositions(Float3SoA^ positions, Float3SoA^ velocities, float dt, int count)
+    {
+        CheckStream(positions, count, "positions");
+        CheckStream(velocities, count, "velocities");
+        if (count == 0) return;
+
+        pin_ptr<float> px = &positions->X[0], py = &positions->Y[0], pz = &positions->Z[0];
+        pin_ptr<float> vx = &velocities->X[0], vy = &velocities->Y[0], vz = &velocities->Z[0];
+
+        Core::Math::integrate_transforms(
+            { px, py, pz }, { vx, vy, vz },
+            { nullptr, nullptr, nullptr, nullptr }, { nullptr, nullptr, nullptr },
+            dt, static_cast<size_t>(count));
+    }
+
+    void MathKernels::IntegrateTransforms(Float3SoA^ positions, Float3SoA^ linearVelocities,
+                                          QuatSoA^ rotations, Float3SoA^ angularVelocities, float dt, int count)
+    {
+        CheckStream(positions, count, "positions");
+        CheckStream(linearVelocities, count, "linearVelocities");
+        CheckStream(rotations, count, "rotations");
+        CheckStream(angularVelocities, count, "angularVelocities");
+        if (count == 0) return;
+
+        pin_ptr<float> px = &positions->X[0], py = &positions->Y[0], pz = &positions->Z[0];
+        pin_ptr<float> vx = &linearVelocities->X[0], vy = &linearVelocities->Y[0], vz = &linearVelocities->Z[0];
+        pin_ptr<float> rx = &rotations->X[0], ry = &rotations->Y[0], rz = &rotations->Z[0], rw = &rotations->W[0];
+        pin_ptr<float> ax = &angularVelocities->X[0], ay = &angularVelocities->Y[0], az = &angularVelocities->Z[0];
+
+        Core::Math::integrate_transforms(
+            { px, py, pz }, { vx, vy, vz }, { rx, ry, rz, rw }, { ax, ay, az },
+            dt, static_cast<size_t>(count));
+    }
+
+    void MathKernels::LookAt(Float3SoA^ from, Float3SoA^ to, QuatSoA^ outRotations, int count)
+    {
+        CheckStream(from, count, "from");
+        CheckStream(to, count, "to");
+        CheckStream(outRotations, count, "outRotations");
+        if (count == 0) return;
+
+        pin_ptr<float> fx = &from->X[0], fy = &from->Y[0], fz = &from->Z[0];
+        pin_ptr<float> tx = &to->X[0], ty = &to->Y[0], tz = &to->Z[0];
+        pin_ptr<float> rx = &outRotations->X[0], ry = &outRotations->Y[0], rz = &outRotations->Z[0], rw = &outRotations->W[0];
+
+        Core::Math::look_at({ fx, fy, fz }, { tx, ty, tz }, { rx, ry, rz, rw }, static_cast<size_t>(count));
+    }
+
+    void MathKernels::MergeBounds(Float3SoA^ mins, Float3SoA^ maxs, int count, Float3% outMin, Float3% outMax)
+    {
+        CheckStream(mins, count, "mins");
+        CheckStream(maxs, count, "maxs");
+        outMin = Float3();
+        outMax = Float3();
+        if (count == 0) return;
+
+        pin_ptr<float> lx = &mins->X[0], ly = &mins->Y[0], lz = &mins->Z[0];
+        pin_ptr<float> hx = &maxs->X[0], hy = &maxs->Y[0], hz = &maxs->Z[0];
+
+        Core::Math::float3 lo{}, hi{};
+        Core::Math::merge_bounds({ lx, ly, lz }, { hx, hy, hz }, static_cast<size_t>(count), lo, hi);
+        outMin = FromNative(lo);
+        outMax = FromNative(hi);
+    }
+
+    void MathKernels::TransformPoints(Float4x4 matrix, array<Float3>^ points)
+    {
+        if (points == nullptr) throw gcnew ArgumentNullException("points");
+        if (points->Length == 0) return;
+
+        // Both the matrix and the points array are used in place, no per-element marshalling.
+        pin_ptr<Float4x4> pinnedMatrix = &matrix;
+        pin_ptr<Float3> pinnedPoints = &points[0];
+        Core::Math::transform_points(
+            *reinterpret_cast<const Core::Math::float4x4*>(static_cast<Float4x4*>(pinnedMatrix)),
+            reinterpret_cast<Core::Math::float3*>(static_cast<Float3*>(pinnedPoints)),
+            static_cast<size_t>(points->Length));
+    }
+
+} // namespace ScriptAPI
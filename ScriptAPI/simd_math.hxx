@@ -0,0 +1,162 @@
+#pragma once
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+namespace ScriptAPI
+{
+    // The value types below are layout-identical to the structs in Core/simd_math.h.
+    // Arrays of them are pinned and reinterpreted by native kernels without conversion.
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct Float3
+    {
+        float X, Y, Z;
+
+        Float3(float x, float y, float z) : X(x), Y(y), Z(z) {}
+
+        static Float3 operator+(Float3 a, Float3 b) { return Float3(a.X + b.X, a.Y + b.Y, a.Z + b.Z); }
+        static Float3 operator-(Float3 a, Float3 b) { return Float3(a.X - b.X, a.Y - b.Y, a.Z - b.Z); }
+        static Float3 operator*(Float3 a, float s) { return Float3(a.X * s, a.Y * s, a.Z * s); }
+
+        static float Dot(Float3 a, Float3 b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+        static Float3 Cross(Float3 a, Float3 b) { return Float3(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X); }
+        static Float3 Normalize(Float3 a)
+        {
+            float len = a.Length;
+            return len > 0.0f ? a * (1.0f / len) : Float3(0.0f, 0.0f, 0.0f);
+        }
+
+        property float Length { float get() { return static_cast<float>(Math::Sqrt(Dot(*this, *this))); } }
+
+        virtual String^ ToString() override { return String::Format("({0}, {1}, {2})", X, Y, Z); }
+    };
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct Float4
+    {
+        float X, Y, Z, W;
+
+        Float4(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+
+        static Float4 operator+(Float4 a, Float4 b) { return Float4(a.X + b.X, a.Y + b.Y, a.Z + b.Z, a.W + b.W); }
+        static Float4 operator-(Float4 a, Float4 b) { return Float4(a.X - b.X, a.Y - b.Y, a.Z - b.Z, a.W - b.W); }
+        static Float4 operator*(Float4 a, float s) { return Float4(a.X * s, a.Y * s, a.Z * s, a.W * s); }
+
+        static float Dot(Float4 a, Float4 b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W; }
+
+        virtual String^ ToString() override { return String::Format("({0}, {1}, {2}, {3})", X, Y, Z, W); }
+    };
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct Quat
+    {
+        float X, Y, Z, W;
+
+        Quat(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+
+        static property Quat Identity { Quat get() { return Quat(0.0f, 0.0f, 0.0f, 1.0f); } }
+
+        static Quat FromAxisAngle(Float3 axis, float radians);
+        // Rotation that turns +Z towards 'forward' while keeping +Y up
+        static Quat LookRotation(Float3 forward);
+
+        // Applying the result rotates by b first, then by a
+        static Quat operator*(Quat a, Quat b)
+        {
+            return Quat(
+                a.W * b.X + a.X * b.W + a.Y * b.Z - a.Z * b.Y,
+                a.W * b.Y - a.X * b.Z + a.Y * b.W + a.Z * b.X,
+                a.W * b.Z + a.X * b.Y - a.Y * b.X + a.Z * b.W,
+                a.W * b.W - a.X * b.X - a.Y * b.Y - a.Z * b.Z);
+        }
+
+        static Float3 Rotate(Quat q, Float3 v)
+        {
+            Float3 u(q.X, q.Y, q.Z);
+            Float3 t = Float3::Cross(u, v) * 2.0f;
+            return v + t * q.W + Float3::Cross(u, t);
+        }
+
+        virtual String^ ToString() override { return String::Format("({0}, {1}, {2}, {3})", X, Y, Z, W); }
+    };
+
+    // Column-major, C3 holds the translation
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct Float4x4
+    {
+        Float4 C0, C1, C2, C3;
+
+        static property Float4x4 Identity { Float4x4 get(); }
+
+        // Translation * Rotation * Scale
+        static Float4x4 TRS(Float3 translation, Quat rotation, Float3 scale);
+        static Float4x4 operator*(Float4x4 a, Float4x4 b);
+
+        static Float4 Mul(Float4x4 m, Float4 v) { return m.C0 * v.X + m.C1 * v.Y + m.C2 * v.Z + m.C3 * v.W; }
+        static Float3 TransformPoint(Float4x4 m, Float3 p)
+        {
+            Float4 r = Mul(m, Float4(p.X, p.Y, p.Z, 1.0f));
+            return Float3(r.X, r.Y, r.Z);
+        }
+    };
+
+    // SoA stream of Float3 values, one managed array per component
+    public ref class Float3SoA sealed
+    {
+    public:
+        Float3SoA(int capacity);
+
+        property array<float>^ X { array<float>^ get() { return x; } }
+        property array<float>^ Y { array<float>^ get() { return y; } }
+        property array<float>^ Z { array<float>^ get() { return z; } }
+        property int Capacity { int get() { return x->Length; } }
+
+        property Float3 default[int] {
+            Float3 get(int i) { return Float3(x[i], y[i], z[i]); }
+            void set(int i, Float3 v) { x[i] = v.X; y[i] = v.Y; z[i] = v.Z; }
+        }
+
+    private:
+        array<float>^ x;
+        array<float>^ y;
+        array<float>^ z;
+    };
+
+    // SoA stream of Quat values, one managed array per component
+    public ref class QuatSoA sealed
+    {
+    public:
+        QuatSoA(int capacity);
+
+        property array<float>^ X { array<float>^ get() { return x; } }
+        property array<float>^ Y { array<float>^ get() { return y; } }
+        property array<float>^ Z { array<float>^ get() { return z; } }
+        property array<float>^ W { array<float>^ get() { return w; } }
+        property int Capacity { int get() { return x->Length; } }
+
+        property Quat default[int] {
+            Quat get(int i) { return Quat(x[i], y[i], z[i], w[i]); }
+            void set(int i, Quat q) { x[i] = q.X; y[i] = q.Y; z[i] = q.Z; w[i] = q.W; }
+        }
+
+    private:
+        array<float>^ x;
+        array<float>^ y;
+        array<float>^ z;
+        array<float>^ w;
+    };
+
+    // Native batch kernels. Each call crosses into Core once for the whole stream.
+    public ref class MathKernels abstract sealed
+    {
+    public:
+        static void IntegratePositions(Float3SoA^ positions, Float3SoA^ velocities, float dt, int count);
+        static void IntegrateTransforms(Float3SoA^ positions, Float3SoA^ linearVelocities,
+                                        QuatSoA^ rotations, Float3SoA^ angularVelocities, float dt, int count);
+        static void LookAt(Float3SoA^ from, Float3SoA^ to, QuatSoA^ outRotations, int count);
+        static void MergeBounds(Float3SoA^ mins, Float3SoA^ maxs, int count,
+                                [Out] Float3% outMin, [Out] Float3% outMax);
+        static void TransformPoints(Float4x4 matrix, array<Float3>^ points);
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "spatial.hxx"
+
+#include "spatial_index.h" // Core
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        template <typename TNative, typename TManaged>
+        int RunBatch(
+            array<TManaged>^ queries, array<int>^ results, array<QueryRange>^ ranges,
+            int (Core::SpatialIndex::*query)(std::span<const TNative>, std::span<int>, std::span<Core::QueryRange>) const)
+        {
+            if (queries == nullptr) throw gcnew ArgumentNullException("queries");
+            if (results == nullptr) throw gcnew ArgumentNullException("results");
+            if (ranges == nullptr) throw gcnew ArgumentNullException("ranges");
+            if (ranges->Length < queries->Length)
+                throw gcnew ArgumentException("ranges must be at least as long as queries.", "ranges");
+            if (queries->Length == 0) return 0;
+
+            pin_ptr<TManaged> pinnedQueries = &queries[0];
+            pin_ptr<QueryRange> pinnedRanges = &ranges[0];
+            pin_ptr<int> pinnedResults = nullptr;
+            if (results->Length > 0) pinnedResults = &results[0];
+
+            std::span<const TNative> nativeQueries(
+                reinterpret_cast<const TNative*>(static_cast<TManaged*>(pinnedQueries)), queries->Length);
+            std::span<Core::QueryRange> nativeRanges(
+                reinterpret_cast<Core::QueryRange*>(static_cast<QueryRange*>(pinnedRanges)), ranges->Length);
+            std::span<int> nativeResults(static_cast<int*>(pinnedResults), results->Length);
+
+            return (Core::SpatialIndex::instance().*query)(nativeQueries, nativeResults, nativeRanges);
+        }
+    }
+
+    void Spatial::SetPosition(int entityId, float x, float y, float z, float radius)
+    {
+        Core::SpatialIndex::instance().update(entityId, x, y, z, radius);
+    }
+
+    bool Spatial::Remove(int entityId)
+    {
+        return Core::SpatialIndex::instance().remove(entityId);
+    }
+
+    int Spatial::Count::get()
+    {
+        return static_cast<int>(Core::SpatialIndex::instance().size());
+    }
+
+    int Spatial::QueryRadius(array<RadiusQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges)
+    {
+        return RunBatch<Core::RadiusQuery>(queries, results, ranges, &Core::SpatialIndex::query_radius);
+    }
+
+    int Spatial::QueryAabb(array<AabbQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges)
+    {
+        return RunBatch<Core::AabbQuery>(queries, results, ranges, &Core::SpatialIndex::query_aabb);
+    }
+
+    int Spatial::QueryRay(array<RayQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges)
+    {
+        return RunBatch<Core::RayQuery>(queries, results, ranges, &Core::SpatialIndex::query_ray);
+    }
+
+    int Spatial::QueryRadius(float x, float y, float z, float radius, array<int>^ results)
+    {
+        if (results == nullptr) throw gcnew ArgumentNullException("results");
+        if (results->Length == 0) return 0;
+
+        Core::RadiusQuery query{ x, y, z, radius };
+        Core::QueryRange range{};
+        pin_ptr<int> pinnedResults = &results[0];
+        return Core::SpatialIndex::instance().query_radius(
+            std::span<const Core::RadiusQuery>(&query, 1),
+            std::span<int>(static_cast<int*>(pinnedResults), results->Length),
+            std::span<Core::QueryRange>(&range, 1));
+    }
+
+} // namespace ScriptAPI
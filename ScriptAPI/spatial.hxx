@@ -0,0 +1,65 @@
+#pragma once
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+namespace ScriptAPI
+{
+    // The value types below mirror the structs in Core/spatial_index.h field for field,
+    // so arrays of them are pinned and handed to the native index without conversion.
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct RadiusQuery
+    {
+        float X, Y, Z;
+        float Radius;
+
+        RadiusQuery(float x, float y, float z, float radius) : X(x), Y(y), Z(z), Radius(radius) {}
+    };
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct AabbQuery
+    {
+        float MinX, MinY, MinZ;
+        float MaxX, MaxY, MaxZ;
+
+        AabbQuery(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+            : MinX(minX), MinY(minY), MinZ(minZ), MaxX(maxX), MaxY(maxY), MaxZ(maxZ) {}
+    };
+
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct RayQuery
+    {
+        float OriginX, OriginY, OriginZ;
+        float DirX, DirY, DirZ;
+        float MaxDistance;
+        // Values above zero turn the ray into a sphere cast
+        float Radius;
+    };
+
+    // Slice of the results array that belongs to one query of a batch
+    [StructLayout(LayoutKind::Sequential)]
+    public value struct QueryRange
+    {
+        int Offset;
+        int Count;
+    };
+
+    // Script-facing access to the engine's spatial index.
+    // Batch queries cross into native code once for the whole array of queries; matching
+    // entity ids are written into 'results' and each query's slice into 'ranges'.
+    public ref class Spatial abstract sealed
+    {
+    public:
+        static void SetPosition(int entityId, float x, float y, float z, float radius);
+        static bool Remove(int entityId);
+        static property int Count { int get(); }
+
+        static int QueryRadius(array<RadiusQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges);
+        static int QueryAabb(array<AabbQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges);
+        static int QueryRay(array<RayQuery>^ queries, array<int>^ results, array<QueryRange>^ ranges);
+
+        // Single query convenience overload. Returns the number of ids written.
+        static int QueryRadius(float x, float y, float z, float radius, array<int>^ results);
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,178 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Runtime.InteropServices.dll> // For Marshal
+
+#include "streaming.hxx"
+
+#include "stream_service.h" // Core
+#include <string>
+#include <vector>
+
+using namespace System::Runtime::InteropServices; // For Marshal
+
+namespace ScriptAPI
+{
+    // --- StreamData ---
+
+    StreamData::StreamData(unsigned long long requestId, IntPtr pointer, long long length)
+        : requestId(requestId)
+        , pointer(pointer)
+        , length(length)
+    {
+    }
+
+    StreamData::~StreamData()
+    {
+        this->!StreamData();
+        GC::SuppressFinalize(this);
+    }
+
+    StreamData::!StreamData()
+    {
+        if (requestId == 0) return;
+        Core::StreamService::instance().release(requestId);
+        requestId = 0;
+        pointer = IntPtr::Zero;
+    }
+
+    IntPtr StreamData::Pointer::get()
+    {
+        if (requestId == 0) throw gcnew ObjectDisposedException("StreamData");
+        return pointer;
+    }
+
+    UnmanagedMemoryStream^ StreamData::OpenStream()
+    {
+        return gcnew UnmanagedMemoryStream(static_cast<unsigned char*>(Pointer.ToPointer()), length);
+    }
+
+    array<Byte>^ StreamData::ToArray()
+    {
+        if (length > Int32::MaxValue) throw gcnew InvalidOperationException("StreamData is too large for a managed array.");
+        array<Byte>^ bytes = gcnew array<Byte>(static_cast<int>(length));
+        if (length > 0) Marshal::Copy(Pointer, bytes, 0, static_cast<int>(length));
+        return bytes;
+    }
+
+    // --- Streaming ---
+
+    Task<StreamData^>^ Streaming::ReadAsync(String^ path)
+    {
+        return ReadAsync(path, 0, 0, StreamPriority::Normal, StreamCompression::None, 0, CancellationToken::None);
+    }
+
+    Task<StreamData^>^ Streaming::ReadAsync(String^ path, StreamPriority priority, CancellationToken cancellation)
+    {
+        return ReadAsync(path, 0, 0, priority, StreamCompression::None, 0, cancellation);
+    }
+
+    Task<StreamData^>^ Streaming::ReadAsync(String^ path, long long offset, long long length, StreamPriority priority,
+                                            StreamCompression compression, long long uncompressedSize,
+                                            CancellationToken cancellation)
+    {
+        if (path == nullptr) throw gcnew ArgumentNullException("path");
+        if (offset < 0 || length < 0 || uncompressedSize < 0) throw gcnew ArgumentOutOfRangeException("offset/length/uncompressedSize must not be negative.");
+        if (compression != StreamCompression::None && uncompressedSize == 0) {
+            throw gcnew ArgumentException("Compressed reads need the uncompressed size.", "uncompressedSize");
+        }
+        if (cancellation.IsCancellationRequested) return Task::FromCanceled<StreamData^>(cancellation);
+
+        Core::StreamReadDesc desc;
+        desc.offset = static_cast<uint64_t>(offset);
+        desc.length = static_cast<uint64_t>(length);
+        desc.priority = static_cast<Core::StreamPriority>(priority);
+        desc.compression = static_cast<Core::StreamCompression>(compression);
+        desc.uncompressedSize = static_cast<uint64_t>(uncompressedSize);
+
+        array<Byte>^ pathBytes = Text::Encoding::UTF8->GetBytes(path);
+        std::string nativePath(pathBytes->Length, '\0');
+        if (pathBytes->Length > 0) Marshal::Copy(pathBytes, 0, IntPtr(&nativePath[0]), pathBytes->Length);
+
+        PendingRead^ read = gcnew PendingRead();
+        read->Completion = gcnew TaskCompletionSource<StreamData^>();
+        Core::StreamRequestId id = 0;
+        Monitor::Enter(pendingLock);
+        try {
+            id = Core::StreamService::instance().submit(nativePath, desc);
+            // Registered before the read is published, so DeliverCompletions() never
+            // disposes a registration that is still being assigned. An already cancelled
+            // token runs OnCancel() here, which only needs the id.
+            if (cancellation.CanBeCanceled) {
+                read->Registration = cancellation.Register(gcnew Action<Object^>(&Streaming::OnCancel), safe_cast<Object^>(id));
+            }
+            pending[id] = read;
+        }
+        finally { Monitor::Exit(pendingLock); }
+        return read->Completion->Task;
+    }
+
+    void Streaming::OnCancel(Object^ requestId)
+    {
+        // Completed (as Cancelled) through DeliverCompletions() like any other read
+        Core::StreamService::instance().cancel(safe_cast<UInt64>(requestId));
+    }
+
+    void Streaming::DeliverCompletions()
+    {
+        Core::StreamService& service = Core::StreamService::instance();
+        std::vector<Core::StreamCompletion> completions;
+        if (service.poll(completions) == 0) return;
+
+        for (const Core::StreamCompletion& completion : completions) {
+            PendingRead^ read = nullptr;
+            Monitor::Enter(pendingLock);
+            try {
+                if (pending->TryGetValue(completion.id, read)) pending->Remove(completion.id);
+            }
+            finally { Monitor::Exit(pendingLock); }
+            if (read == nullptr) {
+                service.release(completion.id); // Dropped by CancelAll()
+                continue;
+            }
+            read->Registration.Dispose();
+
+            switch (completion.status) {
+            case Core::StreamStatus::Completed:
+            {
+                std::span<const uint8_t> bytes = service.data(completion.id);
+                StreamData^ data = gcnew StreamData(completion.id, IntPtr(const_cast<uint8_t*>(bytes.data())), static_cast<long long>(bytes.size()));
+                if (!read->Completion->TrySetResult(data)) delete data;
+                break;
+            }
+            case Core::StreamStatus::Failed:
+            {
+                std::string message = service.error(completion.id);
+                service.release(completion.id);
+                read->Completion->TrySetException(gcnew IOException(Marshal::PtrToStringUTF8(IntPtr(const_cast<char*>(message.c_str())))));
+                break;
+            }
+            default:
+                service.release(completion.id);
+                read->Completion->TrySetCanceled();
+                break;
+            }
+        }
+    }
+
+    void Streaming::CancelAll()
+    {
+        array<Collections::Generic::KeyValuePair<UInt64, PendingRead^>>^ reads;
+        Monitor::Enter(pendingLock);
+        try {
+            reads = gcnew array<Collections::Generic::KeyValuePair<UInt64, PendingRead^>>(pending->Count);
+            safe_cast<Collections::Generic::ICollection<Collections::Generic::KeyValuePair<UInt64, PendingRead^>>^>(pending)->CopyTo(reads, 0);
+            pending->Clear();
+        }
+        finally { Monitor::Exit(pendingLock); }
+
+        // Outside the lock: cancelling runs continuations inline
+        Core::StreamService& service = Core::StreamService::instance();
+        for each (Collections::Generic::KeyValuePair<UInt64, PendingRead^> entry in reads) {
+            service.release(entry.Key);
+            entry.Value->Registration.Dispose();
+            entry.Value->Completion->TrySetCanceled();
+        }
+    }
+
+} // namespace ScriptAPI
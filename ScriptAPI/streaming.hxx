@@ -0,0 +1,92 @@
+#pragma once
+
+#using <System.Runtime.dll>
+#using <System.Collections.dll>
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+namespace ScriptAPI
+{
+    // Mirrors Core::StreamPriority
+    public enum class StreamPriority
+    {
+        Low = 0,
+        Normal,
+        High,
+        Critical
+    };
+
+    // Mirrors Core::StreamCompression
+    public enum class StreamCompression
+    {
+        None = 0,
+        Lz4Block // Raw LZ4 block; the uncompressed size must be passed to ReadAsync()
+    };
+
+    // Bytes of a finished read. They stay in native memory (a buffer, or a view into a
+    // mapping of the file) until the object is disposed; wrap them without copying with
+    // OpenStream() or, in unsafe C#, new ReadOnlySpan<byte>((void*)data.Pointer, (int)data.Length).
+    public ref class StreamData sealed
+    {
+    public:
+        property IntPtr Pointer { IntPtr get(); }
+        property long long Length { long long get() { return length; } }
+
+        // Read-only stream over the native bytes; must not be used after Dispose().
+        UnmanagedMemoryStream^ OpenStream();
+        // Copies the bytes into a managed array.
+        array<Byte>^ ToArray();
+
+        ~StreamData();
+        !StreamData();
+
+    internal:
+        StreamData(unsigned long long requestId, IntPtr pointer, long long length);
+
+    private:
+        unsigned long long requestId;
+        IntPtr pointer;
+        long long length;
+    };
+
+    // Asynchronous file reads served by Core::StreamService's I/O threads, so scripts can
+    // load data from Start(), StartAsync() or Update() without blocking the frame.
+    // Returned tasks complete on the engine thread at the start of the next frame, so code
+    // awaiting them resumes there (see Script::StartAsync) and may use every engine API.
+    public ref class Streaming abstract sealed
+    {
+    public:
+        static Task<StreamData^>^ ReadAsync(String^ path);
+        static Task<StreamData^>^ ReadAsync(String^ path, StreamPriority priority, CancellationToken cancellation);
+        // Reads 'length' bytes at 'offset' (0 reads to the end of the file), decompressing
+        // them off the engine thread if 'compression' is set.
+        static Task<StreamData^>^ ReadAsync(String^ path, long long offset, long long length, StreamPriority priority,
+                                            StreamCompression compression, long long uncompressedSize,
+                                            CancellationToken cancellation);
+
+    internal:
+        // Completes the tasks of finished reads. Called by the engine once per frame.
+        static void DeliverCompletions();
+        // Cancels every outstanding read (before a reload).
+        static void CancelAll();
+
+    private:
+        ref class PendingRead sealed
+        {
+        public:
+            TaskCompletionSource<StreamData^>^ Completion;
+            CancellationTokenRegistration Registration;
+        };
+
+        static void OnCancel(Object^ requestId);
+
+        // Reads may be started from any thread; submitting and registering happen under
+        // the lock so a completion can't be polled before its entry exists.
+        static Object^ pendingLock = gcnew Object();
+        static Collections::Generic::Dictionary<UInt64, PendingRead^>^ pending =
+            gcnew Collections::Generic::Dictionary<UInt64, PendingRead^>();
+    };
+} // namespace ScriptAPI
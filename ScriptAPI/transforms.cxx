@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "transforms.hxx"
+
+#include "transform_hierarchy.h" // Core
+
+#include <algorithm> // std::copy
+
+namespace ScriptAPI
+{
+    namespace
+    {
+        void CheckLength(Array^ values, int expected, String^ name)
+        {
+            if (values != nullptr && values->Length != expected)
+                throw gcnew ArgumentException(name + " must be null or match entityIds in length.", name);
+        }
+    }
+
+    void Transforms::Add(int entityId)
+    {
+        Core::TransformHierarchy::instance().add(entityId);
+    }
+
+    bool Transforms::Remove(int entityId)
+    {
+        return Core::TransformHierarchy::instance().remove(entityId);
+    }
+
+    bool Transforms::Contains(int entityId)
+    {
+        return Core::TransformHierarchy::instance().contains(entityId);
+    }
+
+    bool Transforms::SetParent(int entityId, int parentId)
+    {
+        return Core::TransformHierarchy::instance().set_parent(entityId, parentId);
+    }
+
+    int Transforms::GetParent(int entityId)
+    {
+        return Core::TransformHierarchy::instance().get_parent(entityId);
+    }
+
+    bool Transforms::SetLocal(int entityId, Float3 position, Quat rotation, Float3 scale)
+    {
+        return Core::TransformHierarchy::instance().set_local(entityId,
+            { position.X, position.Y, position.Z },
+            { rotation.X, rotation.Y, rotation.Z, rotation.W },
+            { scale.X, scale.Y, scale.Z });
+    }
+
+    bool Transforms::GetLocal(int entityId, Float3% position, Quat% rotation, Float3% scale)
+    {
+        Core::Math::float3 p{}, s{};
+        Core::Math::quat r{};
+        bool found = Core::TransformHierarchy::instance().get_local(entityId, p, r, s);
+        position = Float3(p.x, p.y, p.z);
+        rotation = found ? Quat(r.x, r.y, r.z, r.w) : Quat::Identity;
+        scale = Float3(s.x, s.y, s.z);
+        return found;
+    }
+
+    bool Transforms::GetWorld(int entityId, Float4x4% world)
+    {
+        Core::Math::float4x4 native{};
+        bool found = Core::TransformHierarchy::instance().get_world(entityId, native);
+        world = found ? *reinterpret_cast<Float4x4*>(&native) : Float4x4::Identity;
+        return found;
+    }
+
+    int Transforms::SetLocalBulk(array<int>^ entityIds, array<Float3>^ positions, array<Quat>^ rotations, array<Float3>^ scales)
+    {
+        if (entityIds == nullptr) throw gcnew ArgumentNullException("entityIds");
+        CheckLength(positions, entityIds->Length, "positions");
+        CheckLength(rotations, entityIds->Length, "rotations");
+        CheckLength(scales, entityIds->Length, "scales");
+        const int count = entityIds->Length;
+        if (count == 0) return 0;
+
+        pin_ptr<int> ids = &entityIds[0];
+        pin_ptr<Float3> pos = nullptr;
+        pin_ptr<Quat> rot = nullptr;
+        pin_ptr<Float3> scl = nullptr;
+        if (positions != nullptr) pos = &positions[0];
+        if (rotations != nullptr) rot = &rotations[0];
+        if (scales != nullptr) scl = &scales[0];
+
+        return static_cast<int>(Core::TransformHierarchy::instance().set_local_bulk(
+            std::span<const int>(static_cast<int*>(ids), count),
+            std::span<const Core::Math::float3>(reinterpret_cast<const Core::Math::float3*>(static_cast<Float3*>(pos)), positions != nullptr ? count : 0),
+            std::span<const Core::Math::quat>(reinterpret_cast<const Core::Math::quat*>(static_cast<Quat*>(rot)), rotations != nullptr ? count : 0),
+            std::span<const Core::Math::float3>(reinterpret_cast<const Core::Math::float3*>(static_cast<Float3*>(scl)), scales != nullptr ? count : 0)));
+    }
+
+    int Transforms::GetLocalBulk(array<int>^ entityIds, array<Float3>^ positions, array<Quat>^ rotations, array<Float3>^ scales)
+    {
+        if (entityIds == nullptr) throw gcnew ArgumentNullException("entityIds");
+        CheckLength(positions, entityIds->Length, "positions");
+        CheckLength(rotations, entityIds->Length, "rotations");
+        CheckLength(scales, entityIds->Length, "scales");
+        const int count = entityIds->Length;
+        if (count == 0) return 0;
+
+        pin_ptr<int> ids = &entityIds[0];
+        pin_ptr<Float3> pos = nullptr;
+        pin_ptr<Quat> rot = nullptr;
+        pin_ptr<Float3> scl = nullptr;
+        if (positions != nullptr) pos = &positions[0];
+        if (rotations != nullptr) rot = &rotations[0];
+        if (scales != nullptr) scl = &scales[0];
+
+        return static_cast<int>(Core::TransformHierarchy::instance().get_local_bulk(
+            std::span<const int>(static_cast<int*>(ids), count),
+            std::span<Core::Math::float3>(reinterpret_cast<Core::Math::float3*>(static_cast<Float3*>(pos)), positions != nullptr ? count : 0),
+            std::span<Core::Math::quat>(reinterpret_cast<Core::Math::quat*>(static_cast<Quat*>(rot)), rotations != nullptr ? count : 0),
+            std::span<Core::Math::float3>(reinterpret_cast<Core::Math::float3*>(static_cast<Float3*>(scl)), scales != nullptr ? count : 0)));
+    }
+
+    int Transforms::GetWorldBulk(array<int>^ entityIds, array<Float4x4>^ worlds)
+    {
+        if (entityIds == nullptr) throw gcnew ArgumentNullException("entityIds");
+        if (worlds == nullptr) throw gcnew ArgumentNullException("worlds");
+        if (worlds->Length != entityIds->Length) throw gcnew ArgumentException("worlds must match entityIds in length.", "worlds");
+        const int count = entityIds->Length;
+        if (count == 0) return 0;
+
+        pin_ptr<int> ids = &entityIds[0];
+        pin_ptr<Float4x4> out = &worlds[0];
+        return static_cast<int>(Core::TransformHierarchy::instance().get_world_bulk(
+            std::span<const int>(static_cast<int*>(ids), count),
+            std::span<Core::Math::float4x4>(reinterpret_cast<Core::Math::float4x4*>(static_cast<Float4x4*>(out)), count)));
+    }
+
+    int Transforms::GetChanged(array<int>^% entityIds)
+    {
+        std::span<const int> changed = Core::TransformHierarchy::instance().changed_entities();
+        const int count = static_cast<int>(changed.size());
+        if (entityIds == nullptr || entityIds->Length < count) entityIds = gcnew array<int>(count);
+        if (count == 0) return 0;
+
+        pin_ptr<int> out = &entityIds[0];
+        std::copy(changed.begin(), changed.end(), static_cast<int*>(out));
+        return count;
+    }
+
+} // namespace ScriptAPI
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "simd_math.hxx" // Float3, Quat, Float4x4
+
+using namespace System;
+
+namespace ScriptAPI
+{
+    // Script-facing access to the engine's transform hierarchy.
+    // World matrices are recomputed by the engine once per frame after script updates,
+    // so reads return the state of the previous frame's update.
+    public ref class Transforms abstract sealed
+    {
+    public:
+        static void Add(int entityId);
+        static bool Remove(int entityId);
+        static bool Contains(int entityId);
+
+        // parentId == -1 detaches. Returns false on unknown entities or cycles.
+        static bool SetParent(int entityId, int parentId);
+        static int GetParent(int entityId);
+
+        static bool SetLocal(int entityId, Float3 position, Quat rotation, Float3 scale);
+        static bool GetLocal(int entityId, [Out] Float3% position, [Out] Quat% rotation, [Out] Float3% scale);
+        static bool GetWorld(int entityId, [Out] Float4x4% world);
+
+        // Bulk variants cross into native code once. Component arrays may be null to leave
+        // that component untouched, otherwise they must match entityIds in length.
+        // Return the number of entities found.
+        static int SetLocalBulk(array<int>^ entityIds, array<Float3>^ positions, array<Quat>^ rotations, array<Float3>^ scales);
+        static int GetLocalBulk(array<int>^ entityIds, array<Float3>^ positions, array<Quat>^ rotations, array<Float3>^ scales);
+        static int GetWorldBulk(array<int>^ entityIds, array<Float4x4>^ worlds);
+
+        // Entities whose world matrix changed in the engine's last transform update, in
+        // hierarchy order. Writes into 'entityIds' (resized if too small); returns the count.
+        static int GetChanged(array<int>^% entityIds);
+    };
+} // namespace ScriptAPI
@@ -0,0 +1,329 @@
+#include "pch.h"
+
+#using <System.Runtime.dll>
+#using <System.Runtime.Loader.dll>
+#using <System.Reflection.dll>
+#using <System.Collections.dll>
+#using <System.Runtime.InteropServices.dll> // For RuntimeEnvironment
+
+#include "unload_tracker.hxx"
+
+#include "metrics.h" // Core
+
+using namespace System::Diagnostics; // For Stopwatch
+using namespace System::Runtime::InteropServices; // For RuntimeEnvironment
+
+namespace ScriptAPI
+{
+    // --- UnloadTracker ---
+
+    void UnloadTracker::Track(AssemblyLoadContext^ context)
+    {
+        if (context == nullptr) return;
+        if (pending == nullptr) pending = gcnew List<PendingUnload^>();
+
+        PendingUnload^ unload = gcnew PendingUnload();
+        unload->context = gcnew WeakReference(context);
+        unload->contextName = context->Name;
+        unload->number = ++unloadCount;
+        unload->unloadTimestamp = Stopwatch::GetTimestamp();
+        unload->lastCollectTimestamp = 0; // Collect on the first poll
+        unload->fullCollectionsAtUnload = GC::CollectionCount(GC::MaxGeneration);
+        unload->reported = false;
+        pending->Add(unload);
+        PublishCounts();
+    }
+
+    void UnloadTracker::Poll(AssemblyLoadContext^ live)
+    {
+        if (pending == nullptr || pending->Count == 0) return;
+
+        long long now = Stopwatch::GetTimestamp();
+        if (now - lastPollTimestamp < static_cast<long long>(PollIntervalSeconds * Stopwatch::Frequency)) return;
+        lastPollTimestamp = now;
+
+        bool requestCollection = false;
+        for (int i = pending->Count - 1; i >= 0; --i) {
+            PendingUnload^ unload = pending[i];
+            if (unload->scan != nullptr && unload->scan->IsCompleted) ReportScan(unload);
+            double seconds = static_cast<double>(now - unload->unloadTimestamp) / Stopwatch::Frequency;
+            int fullCollections = GC::CollectionCount(GC::MaxGeneration) - unload->fullCollectionsAtUnload;
+
+            if (!unload->context->IsAlive) {
+                if (unload->reported) {
+                    --leaked;
+                    Console::WriteLine(String::Format("[ScriptAPI] Script context #{0} ({1}) was collected {2:F1} s after unload; no longer counted as leaked.",
+                        unload->number, unload->contextName, seconds));
+                }
+                else {
+                    Console::WriteLine(String::Format("[ScriptAPI] Script context #{0} ({1}) unloaded after {2:F0} ms ({3} full GCs).",
+                        unload->number, unload->contextName, seconds * 1000.0, fullCollections));
+                }
+                pending->RemoveAt(i);
+                continue;
+            }
+            if (unload->reported) continue; // Only natural GCs from here on
+
+            if (seconds >= LeakTimeoutSeconds && fullCollections >= RequiredFullCollections) {
+                unload->reported = true;
+                ++leaked;
+                ReportLeak(unload, live, seconds);
+                continue;
+            }
+            if (now - unload->lastCollectTimestamp >= static_cast<long long>(CollectIntervalSeconds * Stopwatch::Frequency)) {
+                unload->lastCollectTimestamp = now;
+                requestCollection = true;
+            }
+        }
+
+        // Unloading takes several full GCs (the loader allocator is finalized first). A
+        // background collection keeps the frame going where a blocking one would stall it.
+        if (requestCollection) GC::Collect(GC::MaxGeneration, GCCollectionMode::Forced, false, false);
+        PublishCounts();
+    }
+
+    void UnloadTracker::ReportLeak(PendingUnload^ unload, AssemblyLoadContext^ live, double seconds)
+    {
+        Console::WriteLine(String::Format("[ScriptAPI] Warning: Script context #{0} ({1}) is still alive {2:F1} s after unload and {3} full GCs; "
+            "its assemblies and JIT-compiled code are leaking.",
+            unload->number, unload->contextName, seconds, GC::CollectionCount(GC::MaxGeneration) - unload->fullCollectionsAtUnload));
+
+        // The scan holds the objects it visited, so the context can't die before it ends
+        unload->scanner = gcnew ContextRootScanner(live);
+        unload->scan = Task::Run(gcnew Action(unload->scanner, &ContextRootScanner::Scan));
+    }
+
+    void UnloadTracker::ReportScan(PendingUnload^ unload)
+    {
+        ContextRootScanner^ scanner = unload->scanner;
+        Task^ scan = unload->scan;
+        unload->scanner = nullptr;
+        unload->scan = nullptr;
+
+        if (scan->IsFaulted) {
+            Console::Error->WriteLine(String::Format("[ScriptAPI] Error: Root scan for script context #{0} failed: {1}",
+                unload->number, scan->Exception->InnerException->Message));
+            return;
+        }
+        if (scanner->Paths->Count == 0) {
+            Console::WriteLine("[ScriptAPI]   No references found from static roots; check threads started by scripts, "
+                "[ThreadStatic] fields, GCHandles and native callbacks.");
+        }
+        for each (String^ path in scanner->Paths) {
+            Console::WriteLine(String::Format("[ScriptAPI]   Rooted via {0}", path));
+        }
+        if (scanner->LeakedTypes->Count > 0) {
+            Text::StringBuilder^ types = gcnew Text::StringBuilder();
+            for each (KeyValuePair<String^, int> entry in scanner->LeakedTypes) {
+                if (types->Length > 0) types->Append(", ");
+                types->AppendFormat("{0} ({1})", entry.Key, entry.Value);
+            }
+            Console::WriteLine(String::Format("[ScriptAPI]   Referenced from unloaded contexts: {0}", types));
+        }
+        if (scanner->SkippedTypes > 0) {
+            Console::WriteLine(String::Format("[ScriptAPI]   Skipped the statics of {0} types with a static constructor.", scanner->SkippedTypes));
+        }
+        Console::WriteLine(String::Format("[ScriptAPI]   Scanned {0} objects in {1:F0} ms{2}.", scanner->Visited, scanner->Milliseconds,
+            scanner->Truncated ? " (limit reached, results incomplete)" : ""));
+    }
+
+    void UnloadTracker::PublishCounts()
+    {
+        if (unloadingGauge == nullptr) {
+            unloadingGauge = &Core::MetricsRegistry::instance().gauge(
+                "engine_script_contexts_unloading", "Unloaded script contexts not collected yet");
+            leakedGauge = &Core::MetricsRegistry::instance().gauge(
+                "engine_script_contexts_leaked", "Unloaded script contexts still alive after the leak timeout");
+        }
+        unloadingGauge->set(Unloading);
+        leakedGauge->set(leaked);
+    }
+
+    // --- ContextRootScanner ---
+
+    ContextRootScanner::ContextRootScanner(AssemblyLoadContext^ live)
+        : live(live)
+    {
+        visited = gcnew HashSet<Object^>(ReferenceEqualityComparer::Instance);
+        fieldCache = gcnew Dictionary<Type^, array<FieldInfo^>^>();
+        deadAssemblies = gcnew Dictionary<Assembly^, bool>();
+        path = gcnew List<String^>();
+        paths = gcnew List<String^>();
+        leakedTypes = gcnew Dictionary<String^, int>();
+        truncated = false;
+        skippedTypes = 0;
+        milliseconds = 0.0;
+    }
+
+    void ContextRootScanner::Scan()
+    {
+        long long start = Stopwatch::GetTimestamp();
+
+        // Framework assemblies are skipped as a whole (their statics are mostly caches and
+        // scanning them runs type initializers); the types below are where handlers pile up.
+        String^ runtimeDirectory = RuntimeEnvironment::GetRuntimeDirectory();
+        Assembly^ scriptApi = ContextRootScanner::typeid->Assembly;
+        for each (Assembly^ assembly in AppDomain::CurrentDomain->GetAssemblies()) {
+            if (assembly->IsDynamic || assembly->IsCollectible) continue;
+            String^ location = assembly->Location;
+            if (!String::IsNullOrEmpty(location) && location->StartsWith(runtimeDirectory, StringComparison::OrdinalIgnoreCase)) continue;
+
+            array<Type^>^ types;
+            try { types = assembly->GetTypes(); }
+            catch (ReflectionTypeLoadException^ e) { types = e->Types; }
+            for each (Type^ type in types) {
+                if (type != nullptr) ScanStatics(type, assembly == scriptApi);
+            }
+        }
+
+        // All used during startup, so their initializers have run
+        for each (Type^ type in gcnew array<Type^>{ AppContext::typeid, Console::typeid, AppDomain::typeid, AssemblyLoadContext::typeid }) {
+            ScanStatics(type, true);
+        }
+        Visit(AssemblyLoadContext::Default, "AssemblyLoadContext.Default", 0); // Resolving/Unloading handlers
+
+        milliseconds = static_cast<double>(Stopwatch::GetTimestamp() - start) * 1000.0 / Stopwatch::Frequency;
+    }
+
+    bool ContextRootScanner::IsDead(Assembly^ assembly)
+    {
+        if (assembly == nullptr || !assembly->IsCollectible) return false;
+        bool dead;
+        if (!deadAssemblies->TryGetValue(assembly, dead)) {
+            dead = AssemblyLoadContext::GetLoadContext(assembly) != live;
+            deadAssemblies->Add(assembly, dead);
+        }
+        return dead;
+    }
+
+    array<FieldInfo^>^ ContextRootScanner::GetReferenceFields(Type^ type)
+    {
+        array<FieldInfo^>^ fields;
+        if (fieldCache->TryGetValue(type, fields)) return fields;
+
+        // Private fields of base types only show up when asking the base type itself
+        List<FieldInfo^>^ found = gcnew List<FieldInfo^>();
+        const BindingFlags declared = BindingFlags::DeclaredOnly | BindingFlags::Public | BindingFlags::NonPublic | BindingFlags::Instance;
+        for (Type^ current = type; current != nullptr; current = current->BaseType) {
+            for each (FieldInfo^ field in current->GetFields(declared)) {
+                Type^ fieldType = field->FieldType;
+                if (fieldType->IsPrimitive || fieldType->IsPointer || fieldType->IsEnum || fieldType == String::typeid) continue;
+                found->Add(field);
+            }
+        }
+        fields = found->ToArray();
+        fieldCache->Add(type, fields);
+        return fields;
+    }
+
+    void ContextRootScanner::ScanStatics(Type^ type, bool initialized)
+    {
+        if (type->ContainsGenericParameters) return;
+
+        const BindingFlags declared = BindingFlags::DeclaredOnly | BindingFlags::Public | BindingFlags::NonPublic | BindingFlags::Static;
+        array<FieldInfo^>^ fields;
+        try { fields = type->GetFields(declared); }
+        catch (Exception^) { return; }
+
+        bool checkedInitializer = initialized;
+        for each (FieldInfo^ field in fields) {
+            Type^ fieldType = field->FieldType;
+            if (field->IsLiteral || fieldType->IsPrimitive || fieldType->IsPointer || fieldType->IsEnum || fieldType == String::typeid) continue;
+            if (!checkedInitializer) {
+                // GetValue() would run a static constructor that hasn't run yet, with
+                // whatever side effects it has; without one there's nothing to run.
+                if (type->TypeInitializer != nullptr) {
+                    ++skippedTypes;
+                    return;
+                }
+                checkedInitializer = true;
+            }
+            Object^ value;
+            try { value = field->GetValue(nullptr); }
+            catch (Exception^) { continue; } // Failing type initializer, by-ref-like field...
+            Visit(value, String::Concat(type->FullName, ".", field->Name), 0);
+        }
+    }
+
+    void ContextRootScanner::Record(String^ leakedType)
+    {
+        int count = 0;
+        leakedTypes->TryGetValue(leakedType, count);
+        leakedTypes[leakedType] = count + 1;
+        if (count == 0 && paths->Count < MaxPaths) {
+            paths->Add(String::Concat(String::Join(" -> ", path), " -> ", leakedType));
+        }
+    }
+
+    void ContextRootScanner::Visit(Object^ value, String^ label, int depth)
+    {
+        if (value == nullptr) return;
+        Type^ type = value->GetType();
+        if (type->IsPrimitive || type->IsEnum || type == String::typeid) return;
+        if (visited->Count >= MaxVisited) {
+            truncated = true;
+            return;
+        }
+        if (!visited->Add(value)) return;
+
+        path->Add(label);
+        try {
+            // Reflection objects name what they refer to; their internals aren't worth walking
+            if (Type^ asType = dynamic_cast<Type^>(value)) {
+                if (IsDead(asType->Assembly)) Record(asType->FullName);
+                return;
+            }
+            if (MemberInfo^ member = dynamic_cast<MemberInfo^>(value)) {
+                if (IsDead(member->Module->Assembly)) Record(String::Concat(member->DeclaringType, ".", member->Name));
+                return;
+            }
+            if (Assembly^ assembly = dynamic_cast<Assembly^>(value)) {
+                if (IsDead(assembly)) Record(String::Concat("assembly ", assembly->GetName()->Name));
+                return;
+            }
+            if (AssemblyLoadContext^ context = dynamic_cast<AssemblyLoadContext^>(value)) {
+                if (context->IsCollectible && context != live) {
+                    Record(String::Format("AssemblyLoadContext '{0}'", context->Name));
+                    return;
+                }
+            }
+            if (IsDead(type->Assembly)) {
+                Record(type->FullName);
+                return;
+            }
+            if (depth >= MaxDepth) return;
+
+            if (Delegate^ handler = dynamic_cast<Delegate^>(value)) {
+                for each (Delegate^ entry in handler->GetInvocationList()) {
+                    MethodInfo^ method = entry->Method;
+                    if (IsDead(method->Module->Assembly)) {
+                        Record(String::Concat(method->DeclaringType, ".", method->Name));
+                    }
+                    else {
+                        Visit(entry->Target, String::Concat(method->DeclaringType == nullptr ? "?" : method->DeclaringType->Name, ".", method->Name), depth + 1);
+                    }
+                }
+                return;
+            }
+
+            if (Array^ items = dynamic_cast<Array^>(value)) {
+                Type^ elementType = type->GetElementType();
+                if (items->Rank != 1 || elementType->IsPrimitive || elementType->IsEnum || elementType == String::typeid) return;
+                int count = Math::Min(items->Length, static_cast<int>(MaxArrayElements));
+                for (int i = 0; i < count; ++i) Visit(items->GetValue(i), String::Format("[{0}]", i), depth + 1);
+                return;
+            }
+
+            for each (FieldInfo^ field in GetReferenceFields(type)) {
+                Object^ fieldValue;
+                try { fieldValue = field->GetValue(value); }
+                catch (Exception^) { continue; }
+                Visit(fieldValue, String::Concat(type->Name, ".", field->Name), depth + 1);
+            }
+        }
+        finally {
+            path->RemoveAt(path->Count - 1);
+        }
+    }
+
+} // namespace ScriptAPI
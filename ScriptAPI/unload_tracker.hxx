@@ -0,0 +1,122 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Reflection;
+using namespace System::Runtime::Loader;
+using namespace System::Threading::Tasks;
+
+namespace Core
+{
+    class Gauge;
+}
+
+namespace ScriptAPI
+{
+    ref class ContextRootScanner;
+
+    // Verifies that script contexts released by Reload() are actually collected. Each
+    // unloaded context is held by a WeakReference and checked from the frame loop; instead
+    // of blocking GCs and WaitForPendingFinalizers() on the reload path, a non-blocking full
+    // collection is requested now and then until the context dies. A context still alive
+    // after LeakTimeoutSeconds and RequiredFullCollections full GCs is reported as leaked,
+    // together with the reference paths to its types found from static roots, and counted
+    // in engine_script_contexts_leaked. It is still watched and uncounted if it dies later.
+    // The root scan walks up to hundreds of thousands of objects, so it runs on the thread
+    // pool and its results are printed by a later Poll().
+    ref class UnloadTracker abstract sealed
+    {
+    internal:
+        // Call after AssemblyLoadContext::Unload(); the caller must drop its own reference.
+        static void Track(AssemblyLoadContext^ context);
+        // Called once per frame. 'live' is the current script context, whose objects are
+        // not reported.
+        static void Poll(AssemblyLoadContext^ live);
+
+        static property int Unloading { int get() { return pending == nullptr ? 0 : pending->Count; } }
+        static property int Leaked { int get() { return leaked; } }
+
+    private:
+        ref class PendingUnload
+        {
+        internal:
+            WeakReference^ context;
+            String^ contextName;
+            int number;
+            long long unloadTimestamp;      // Stopwatch ticks
+            long long lastCollectTimestamp; // Stopwatch ticks
+            int fullCollectionsAtUnload;
+            bool reported;
+            ContextRootScanner^ scanner; // While its scan runs
+            Task^ scan;
+        };
+
+        static void ReportLeak(PendingUnload^ unload, AssemblyLoadContext^ live, double seconds);
+        static void ReportScan(PendingUnload^ unload);
+        static void PublishCounts();
+
+        literal double PollIntervalSeconds = 0.25;
+        literal double CollectIntervalSeconds = 1.0;
+        literal double LeakTimeoutSeconds = 10.0;
+        literal int RequiredFullCollections = 3;
+
+        static List<PendingUnload^>^ pending = nullptr;
+        static int leaked = 0;
+        static int unloadCount = 0;
+        static long long lastPollTimestamp = 0;
+
+        static Core::Gauge* unloadingGauge = nullptr;
+        static Core::Gauge* leakedGauge = nullptr;
+    };
+
+    // Looks for references to types of dead script contexts, starting from the static
+    // fields of non-framework assemblies, a few framework types that commonly keep
+    // handlers (AppContext, Console, AppDomain, AssemblyLoadContext) and the default load
+    // context's events. Thread-locals, running threads, GC handles and native callbacks
+    // can root a context too but aren't visible from here.
+    // Reading a static field runs its type's initializer, so outside the ScriptAPI (whose
+    // initializers only create empty containers) and the framework types above, types with
+    // a static constructor are skipped: reflection can't tell whether it already ran.
+    // Scan() may run off the frame thread; the graph keeps changing meanwhile, so the
+    // result is a best-effort snapshot.
+    ref class ContextRootScanner sealed
+    {
+    internal:
+        ContextRootScanner(AssemblyLoadContext^ live);
+
+        void Scan();
+
+        // "Root.field -> Type.field -> LeakedType" for the first MaxPaths hits
+        property List<String^>^ Paths { List<String^>^ get() { return paths; } }
+        // Objects found per leaked type name
+        property Dictionary<String^, int>^ LeakedTypes { Dictionary<String^, int>^ get() { return leakedTypes; } }
+        property int Visited { int get() { return visited->Count; } }
+        property bool Truncated { bool get() { return truncated; } }
+        // Types left out because reading their statics could run their initializer
+        property int SkippedTypes { int get() { return skippedTypes; } }
+        property double Milliseconds { double get() { return milliseconds; } }
+
+    private:
+        bool IsDead(Assembly^ assembly);
+        void ScanStatics(Type^ type, bool initialized);
+        void Visit(Object^ value, String^ label, int depth);
+        void Record(String^ leakedType);
+        array<FieldInfo^>^ GetReferenceFields(Type^ type);
+
+        literal int MaxDepth = 8;
+        literal int MaxVisited = 500000;
+        literal int MaxArrayElements = 10000;
+        literal int MaxPaths = 10;
+
+        AssemblyLoadContext^ live;
+        HashSet<Object^>^ visited;
+        Dictionary<Type^, array<FieldInfo^>^>^ fieldCache;
+        Dictionary<Assembly^, bool>^ deadAssemblies;
+        List<String^>^ path;
+        List<String^>^ paths;
+        Dictionary<String^, int>^ leakedTypes;
+        bool truncated;
+        int skippedTypes;
+        double milliseconds;
+    };
+} // namespace ScriptAPI
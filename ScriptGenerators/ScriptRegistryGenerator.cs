@@ -0,0 +1,210 @@
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Linq;
+using System.Text;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using Microsoft.CodeAnalysis.Text;
+
+namespace ScriptGenerators
+{
+    // Emits a ScriptRegistry class for every concrete ScriptAPI.Script subclass in the
+    // compilation, plus the assembly attribute the ScriptAPI looks for. Type ids are the
+    // index into the ordinally sorted list of full type names, so the ScriptAPI's
+    // reflection fallback assigns the same ids. The same class lists the component systems
+    // (ScriptAPI.ComponentSystemBase subclasses) with their phases, so loading them needs
+    // no reflection either.
+    [Generator]
+    public sealed class ScriptRegistryGenerator : IIncrementalGenerator
+    {
+        private const string ScriptBaseType = "ScriptAPI.Script";
+        private const string SystemBaseType = "ScriptAPI.ComponentSystemBase";
+        private const string ExecutionPhaseAttribute = "ScriptAPI.ExecutionPhaseAttribute";
+        private const int DefaultPhase = 1; // ScriptPhase.Update
+
+        private readonly struct ScriptInfo
+        {
+            public ScriptInfo(string metadataName, string typeExpression, bool isSystem, int phase)
+            {
+                MetadataName = metadataName;
+                TypeExpression = typeExpression;
+                IsSystem = isSystem;
+                Phase = phase;
+            }
+
+            // Matches System.Type.FullName ("Namespace.Outer+Inner")
+            public string MetadataName { get; }
+            // Fully qualified C# name usable in a 'new' expression
+            public string TypeExpression { get; }
+            // Component system rather than script; Phase is only used for systems
+            public bool IsSystem { get; }
+            public int Phase { get; }
+        }
+
+        public void Initialize(IncrementalGeneratorInitializationContext context)
+        {
+            IncrementalValueProvider<ImmutableArray<ScriptInfo?>> scripts = context.SyntaxProvider
+                .CreateSyntaxProvider(
+                    static (node, _) => node is ClassDeclarationSyntax c && c.BaseList != null,
+                    static (ctx, _) => GetScriptInfo(ctx))
+                .Where(static info => info.HasValue)
+                .Collect();
+
+            IncrementalValueProvider<string> assemblyName =
+                context.CompilationProvider.Select(static (compilation, _) => compilation.AssemblyName ?? "Scripts");
+
+            context.RegisterSourceOutput(assemblyName.Combine(scripts),
+                static (spc, input) => Emit(spc, input.Left, input.Right));
+        }
+
+        private static ScriptInfo? GetScriptInfo(GeneratorSyntaxContext ctx)
+        {
+            if (ctx.SemanticModel.GetDeclaredSymbol(ctx.Node) is not INamedTypeSymbol type) return null;
+            if (type.IsAbstract || type.IsGenericType || !IsPubliclyVisible(type)) return null;
+            if (!type.InstanceConstructors.Any(c => c.Parameters.Length == 0 && c.DeclaredAccessibility == Accessibility.Public))
+            {
+                return null;
+            }
+
+            for (INamedTypeSymbol? b = type.BaseType; b != null; b = b.BaseType)
+            {
+                string baseName = b.ToDisplayString();
+                if (baseName == ScriptBaseType || baseName == SystemBaseType)
+                {
+                    bool isSystem = baseName == SystemBaseType;
+                    return new ScriptInfo(GetMetadataName(type), type.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat),
+                                          isSystem, isSystem ? GetPhase(type) : DefaultPhase);
+                }
+            }
+            return null;
+        }
+
+        // [ExecutionPhase] is inherited, so the nearest declaration wins
+        private static int GetPhase(INamedTypeSymbol type)
+        {
+            for (INamedTypeSymbol? t = type; t != null; t = t.BaseType)
+            {
+                foreach (AttributeData attribute in t.GetAttributes())
+                {
+                    if (attribute.AttributeClass?.ToDisplayString() == ExecutionPhaseAttribute &&
+                        attribute.ConstructorArguments.Length == 1 && attribute.ConstructorArguments[0].Value is int phase)
+                    {
+                        return phase;
+                    }
+                }
+            }
+            return DefaultPhase;
+        }
+
+        private static bool IsPubliclyVisible(INamedTypeSymbol type)
+        {
+            for (INamedTypeSymbol? t = type; t != null; t = t.ContainingType)
+            {
+                if (t.DeclaredAccessibility != Accessibility.Public) return false;
+            }
+            return true;
+        }
+
+        private static string GetMetadataName(INamedTypeSymbol type)
+        {
+            string name = type.MetadataName;
+            for (INamedTypeSymbol? outer = type.ContainingType; outer != null; outer = outer.ContainingType)
+            {
+                name = outer.MetadataName + "+" + name;
+            }
+            return type.ContainingNamespace.IsGlobalNamespace ? name : type.ContainingNamespace.ToDisplayString() + "." + name;
+        }
+
+        private static string ToIdentifier(string assemblyName)
+        {
+            var sb = new StringBuilder(assemblyName.Length);
+            foreach (char c in assemblyName)
+            {
+                sb.Append(char.IsLetterOrDigit(c) || c == '_' || c == '.' ? c : '_');
+            }
+            if (sb.Length == 0 || char.IsDigit(sb[0])) sb.Insert(0, '_');
+            return sb.ToString();
+        }
+
+        private static void Emit(SourceProductionContext spc, string assemblyName, ImmutableArray<ScriptInfo?> found)
+        {
+            // Partial classes are reported once per declaration
+            List<ScriptInfo> all = found
+                .Select(static s => s!.Value)
+                .GroupBy(static s => s.MetadataName)
+                .Select(static g => g.First())
+                .OrderBy(static s => s.MetadataName, System.StringComparer.Ordinal)
+                .ToList();
+            List<ScriptInfo> scripts = all.Where(static s => !s.IsSystem).ToList();
+            List<ScriptInfo> systems = all.Where(static s => s.IsSystem).ToList();
+
+            string ns = ToIdentifier(assemblyName) + ".Generated";
+            var sb = new StringBuilder();
+            sb.AppendLine("// <auto-generated/>");
+            sb.AppendLine($"[assembly: global::ScriptAPI.ScriptRegistryAttribute(typeof(global::{ns}.ScriptRegistry))]");
+            sb.AppendLine();
+            sb.AppendLine($"namespace {ns}");
+            sb.AppendLine("{");
+            sb.AppendLine("    internal sealed class ScriptRegistry : global::ScriptAPI.IScriptRegistry, global::ScriptAPI.IComponentSystemRegistry");
+            sb.AppendLine("    {");
+            sb.AppendLine("        private static readonly string[] typeNames =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in scripts)
+            {
+                sb.AppendLine($"            \"{s.MetadataName}\",");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        private static readonly global::System.Type[] types =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in scripts)
+            {
+                sb.AppendLine($"            typeof({s.TypeExpression}),");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        private static readonly global::System.Func<global::ScriptAPI.Script>[] factories =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in scripts)
+            {
+                sb.AppendLine($"            static () => new {s.TypeExpression}(),");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        private static readonly string[] systemNames =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in systems)
+            {
+                sb.AppendLine($"            \"{s.MetadataName}\",");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        private static readonly int[] systemPhases =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in systems)
+            {
+                sb.AppendLine($"            {s.Phase},");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        private static readonly global::System.Func<global::ScriptAPI.ComponentSystemBase>[] systemFactories =");
+            sb.AppendLine("        {");
+            foreach (ScriptInfo s in systems)
+            {
+                sb.AppendLine($"            static () => new {s.TypeExpression}(),");
+            }
+            sb.AppendLine("        };");
+            sb.AppendLine();
+            sb.AppendLine("        public string[] TypeNames => typeNames;");
+            sb.AppendLine("        public global::System.Type[] Types => types;");
+            sb.AppendLine("        public global::System.Func<global::ScriptAPI.Script>[] Factories => factories;");
+            sb.AppendLine("        public string[] SystemNames => systemNames;");
+            sb.AppendLine("        public int[] SystemPhases => systemPhases;");
+            sb.AppendLine("        public global::System.Func<global::ScriptAPI.ComponentSystemBase>[] SystemFactories => systemFactories;");
+            sb.AppendLine("    }");
+            sb.AppendLine("}");
+
+            spc.AddSource("ScriptRegistry.g.cs", SourceText.From(sb.ToString(), Encoding.UTF8));
+        }
+    }
+}
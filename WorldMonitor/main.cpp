@@ -0,0 +1,77 @@
+#include <iostream>
+#include <string>
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <thread>  // For std::this_thread::sleep_for
+#include <chrono>
+
+// Include Core library headers
+#include "world_export.h"
+#include "shutdown_signal.h"
+
+// Sample out-of-process reader of the engine's world export. Start the engine with
+// --export <name>, then run:
+//
+//   WorldMonitor [name] [--interval-ms <n>] [--show <n>]
+//
+// It prints the engine's frame rate and stats, and the position of the first few entities,
+// every interval. Reading never blocks the engine, so any number of monitors can run.
+
+const char* const kDefaultExportName = "EngineWorld";
+constexpr int kDefaultIntervalMs = 1000;
+constexpr int kDefaultShownEntities = 3;
+
+int main(int argc, char* argv[])
+{
+    std::string name = kDefaultExportName;
+    int intervalMs = kDefaultIntervalMs; // --interval-ms <n>: time between reports
+    int shownEntities = kDefaultShownEntities; // --show <n>: entity positions per report
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--interval-ms" && i + 1 < argc) { intervalMs = std::atoi(argv[++i]); }
+        else if (arg == "--show" && i + 1 < argc) { shownEntities = std::atoi(argv[++i]); }
+        else if (!arg.starts_with("--")) { name = arg; }
+        else { std::cerr << "Warning: Ignoring unknown argument '" << arg << "'." << std::endl; }
+    }
+    if (intervalMs <= 0) intervalMs = kDefaultIntervalMs;
+    Core::ShutdownSignal::install();
+
+    Core::WorldExportReader reader;
+    std::cout << "Waiting for world export '" << name << "'..." << std::endl;
+    while (!reader.open(name)) {
+        if (Core::ShutdownSignal::requested()) return EXIT_SUCCESS;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    std::cout << "Attached to '" << name << "'." << std::endl;
+
+    Core::WorldExport::Frame frame;
+    uint64_t lastFrameIndex = 0;
+    auto lastReport = std::chrono::steady_clock::now();
+    bool first = true;
+    while (!Core::ShutdownSignal::requested()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        if (!reader.writer_alive()) {
+            std::cout << "Engine closed the export." << std::endl;
+            break;
+        }
+        if (!reader.read(frame)) continue; // Nothing published yet, or overwritten on every attempt
+
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - lastReport).count();
+        double fps = first || elapsed <= 0.0 ? 0.0 : static_cast<double>(frame.stats.frameIndex - lastFrameIndex) / elapsed;
+        lastFrameIndex = frame.stats.frameIndex;
+        lastReport = now;
+        first = false;
+
+        const Core::WorldExport::FrameStats& stats = frame.stats;
+        std::cout << "frame=" << stats.frameIndex << " fps=" << fps << " frame_ms=" << stats.frameSeconds * 1000.0
+                  << " entities=" << stats.entityCount << " exported=" << stats.exportedEntities
+                  << " script_errors=" << stats.scriptErrors << " hitches=" << stats.hitches
+                  << " torn_reads=" << reader.torn_reads() << std::endl;
+        for (int i = 0; i < shownEntities && i < static_cast<int>(frame.entityIds.size()); ++i) {
+            const Core::Math::float4& position = frame.worlds[i].c[3];
+            std::cout << "  entity " << frame.entityIds[i] << " at (" << position.x << ", " << position.y << ", "
+                      << position.z << ")" << std::endl;
+        }
+    }
+    return EXIT_SUCCESS;
+}